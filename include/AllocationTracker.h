@@ -0,0 +1,48 @@
+#ifndef FCG_TRAB_FINAL_ALLOCATIONTRACKER_H
+#define FCG_TRAB_FINAL_ALLOCATIONTRACKER_H
+
+// Headers de C++
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Número de quadros de aquecimento antes de exigir quadros sem alocação
+#define ALLOCATION_WARMUP_FRAMES 120
+
+// Número de threads com contadores próprios; as excedentes dividem o último conjunto
+#define ALLOCATION_MAX_THREADS 64
+
+// Contadores de alocação de uma thread, lidos pela thread principal ao final de cada quadro.
+// Cada conjunto ocupa uma linha de cache própria, para que threads diferentes não escrevam na mesma linha.
+struct alignas(64) AllocationCounters {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> frees;
+    std::atomic<uint64_t> bytes;
+};
+
+// Rastreamento de alocações através dos operadores globais new/delete (definidos em AllocationTracker.cpp),
+// incluindo as formas alinhadas. Com ALLOCATION_CALLSITES definido, também registra o endereço de retorno
+// de cada alocação.
+class AllocationTracker {
+    public:
+        // Contadores da thread atual
+        static AllocationCounters &threadCounters();
+
+        // Total de alocações de todas as threads
+        static uint64_t totalAllocations();
+
+        // Registra uma alocação - chamada pelos operadores globais
+        static void recordAllocation(std::size_t size, void* callsite);
+        static void recordFree();
+
+        // Verificação por quadro: guarda o número de alocações no início do quadro
+        // e, ao final, retorna quantas ocorreram em todas as threads (principal e do sistema de tarefas)
+        static void beginFrame();
+        static uint64_t endFrame(bool steadyState);
+
+        // Imprime o resumo da sessão (e os principais pontos de alocação, se capturados)
+        static void printSummary();
+};
+
+
+#endif //FCG_TRAB_FINAL_ALLOCATIONTRACKER_H
@@ -0,0 +1,77 @@
+#ifndef FCG_TRAB_FINAL_ASSETREGISTRY_H
+#define FCG_TRAB_FINAL_ASSETREGISTRY_H
+
+// Headers de C++
+#include <map>
+#include <memory>
+#include <string>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+
+#include "Mesh.h"
+
+// Tipos de recurso compartilhados pelo registro
+enum AssetType {
+    ASSET_MESH,
+    ASSET_TEXTURE,
+    ASSET_PROGRAM
+};
+
+// Recurso carregado, com contagem de referências e memória ocupada
+struct Asset {
+    AssetType type;
+    std::string key;
+    int refCount;
+
+    // ASSET_MESH
+    std::unique_ptr<Mesh> mesh;
+
+    // ASSET_TEXTURE
+    GLuint textureId;
+    GLuint samplerId;
+
+    // ASSET_PROGRAM
+    GLuint programId;
+
+    // Memória ocupada (estimada para texturas; programas não informam seu tamanho em OpenGL 3.3)
+    size_t cpuBytes;
+    size_t gpuBytes;
+};
+
+// Registro de recursos compartilhados (malhas, texturas e programas de GPU).
+// Cada recurso é identificado pelo caminho canônico do arquivo e pelas opções de importação,
+// de forma que carregar o mesmo arquivo duas vezes apenas incrementa a contagem de referências.
+// Os objetos de OpenGL são liberados assim que a última referência é devolvida.
+class AssetRegistry {
+    private:
+        // Ordenado pela chave - relatórios e liberação final em ordem determinística
+        std::map<std::string, Asset> assets;
+
+        static void freeAsset(Asset &asset);
+
+    public:
+        // Chave de um recurso: caminho canônico seguido das opções de importação
+        static std::string makeKey(const char* path, const char* options);
+
+        // Busca um recurso já carregado, incrementando sua contagem; retorna nullptr caso não exista
+        Asset* acquire(const std::string &key);
+
+        // Adiciona um recurso recém carregado, com uma referência
+        Asset* add(const std::string &key, AssetType type);
+
+        // Devolve uma referência; com zero referências, libera os objetos de OpenGL e remove o recurso
+        void release(Asset* asset);
+
+        // Libera todos os recursos restantes, avisando sobre referências não devolvidas
+        void shutdown();
+
+        // Imprime a memória de CPU e GPU ocupada por cada recurso
+        void printReport() const;
+
+        [[nodiscard]] size_t size() const;
+        static const char* typeName(AssetType type);
+};
+
+
+#endif //FCG_TRAB_FINAL_ASSETREGISTRY_H
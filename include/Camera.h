@@ -6,7 +6,13 @@
 
 // Estrutura de teclas pressionadas
 struct Keys {
-    bool W, A, S, D, M1, M2;
+    bool W, A, S, D, M1, M2, F;
+
+    // Tempo (em segundos) em que cada tecla de movimento ficou pressionada no último passo de simulação
+    float heldW, heldA, heldS, heldD;
+
+    // Indica se houve um clique durante o último passo, mesmo que o botão já tenha sido solto
+    bool pressedM1, pressedM2, pressedF;
 
     Keys(){
         this->W = false;
@@ -15,6 +21,14 @@ struct Keys {
         this->D = false;
         this->M1 = false;
         this->M2 = false;
+        this->F = false;
+        this->heldW = 0.0f;
+        this->heldA = 0.0f;
+        this->heldS = 0.0f;
+        this->heldD = 0.0f;
+        this->pressedM1 = false;
+        this->pressedM2 = false;
+        this->pressedF = false;
     }
 };
 
@@ -29,6 +43,18 @@ struct SphericPosition {
     }
 };
 
+// Matrizes e planos da câmera em um quadro. Camera::snapshot() devolve uma cópia, que não muda se a câmera
+// for alterada durante a renderização do quadro
+struct CameraMatrices {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;   // projection * view
+    glm::mat4 inverseView;      // Do sistema da câmera para o do mundo
+    glm::vec4 frustumPlanes[6]; // Normalizados, apontando para dentro: esquerda, direita, baixo, cima, perto e longe
+    glm::vec4 position;         // Posição da câmera no espaço do mundo
+    float aspectRatio;
+};
+
 class Camera {
 
     private:
@@ -51,19 +77,32 @@ class Camera {
         void updateViewVector();
         glm::vec4 lookAt;
 
+        /* Matrizes em cache, recalculadas somente quando marcadas como sujas */
+        CameraMatrices matrices;
+        bool viewVectorDirty;  // Ângulos ou distância esféricos alterados (câmera Look-At)
+        bool viewDirty;        // Posição, orientação ou tipo de câmera alterados
+        bool projectionDirty;  // Proporção da janela alterada
+
+        glm::vec4 getEyePosition() const;
+
     public:
         Camera();
         glm::vec4 getLookAt(); // Ponto "l", para onde a câmera (look-at) estará sempre olhando
         void setLookAt(glm::vec4 vec);
         glm::vec4 getViewVector();  // Vetor "view", sentido para onde a câmera está virada
-        glm::mat4 getView(); // Matriz "view"
-        [[nodiscard]] glm::mat4 getPerspective(float aspectRatio) const; // Matriz "perspective"
+
+        // Matrizes "view" e "perspective", produtos, inversa e planos do frustum do quadro. Somente as partes
+        // afetadas por mudanças de posição, ângulos, tipo de câmera ou proporção desde a última chamada são recalculadas
+        CameraMatrices snapshot(float aspectRatio);
+
+        // Planos do frustum (normalizados, apontando para dentro) extraídos de projection * view
+        static void extractFrustumPlanes(const glm::mat4 &viewProjection, glm::vec4 planes[6]);
 
         /* Características vetoriais */
         static glm::vec4 upVector;
 
         // Atualização da câmera
-        void updateCamera(float delta_t);
+        void updateCamera();
         void updateViewVector(float angleX, float angleY);
 
         // Atualização das coordenadas esféricas
@@ -0,0 +1,74 @@
+#ifndef FCG_TRAB_FINAL_CROWDGRID_H
+#define FCG_TRAB_FINAL_CROWDGRID_H
+
+// Headers de C++
+#include <cstdint>
+#include <vector>
+
+#include "glm/vec3.hpp"
+
+// Distância abaixo da qual dois zumbis se afastam (também o tamanho das células da grade)
+#define CROWD_SEPARATION_RADIUS 0.45f
+
+// Peso da separação em relação à velocidade de perseguição
+#define CROWD_SEPARATION_WEIGHT 1.5f
+
+// Vizinhos considerados por agente - limita o custo quando muitos zumbis se acumulam no mesmo ponto
+#define CROWD_MAX_NEIGHBORS 12
+
+// Grade espacial uniforme sobre as posições dos agentes, usada para a separação entre zumbis.
+// Cada célula guarda uma lista duplamente encadeada intrusiva de agentes; um agente só troca de lista quando
+// muda de célula, de forma que a atualização é O(1) por agente. Posições fora da grade são presas à borda.
+// Os agentes são identificados pelo índice no vetor de inimigos e ocupam sempre os índices [0, getCount()).
+class CrowdGrid {
+    private:
+        glm::vec3 boundsMin;
+        float cellSize;
+        int columns;
+        int rows;
+        int count;
+
+        std::vector<int> cellHeads;       // Primeiro agente de cada célula (-1 = vazia)
+        std::vector<int> next;            // Próximo agente na mesma célula
+        std::vector<int> previous;        // Agente anterior na mesma célula
+        std::vector<int> cells;           // Célula atual de cada agente
+        std::vector<glm::vec3> positions; // Última posição informada de cada agente
+
+        [[nodiscard]] int cellAt(glm::vec3 position) const;
+        void link(int agent, int cell);
+        void unlink(int agent);
+
+    public:
+        CrowdGrid();
+
+        // Cria a grade sobre a região [boundsMin, boundsMax] do plano XZ, para até "capacity" agentes
+        void initialize(glm::vec3 boundsMin, glm::vec3 boundsMax, float cellSize, int capacity);
+
+        // Adiciona o agente de índice getCount(); retorna falso se a capacidade foi atingida
+        bool insert(glm::vec3 position);
+
+        // Informa a nova posição de um agente, trocando-o de célula se necessário
+        void update(int agent, glm::vec3 position);
+
+        // Remove um agente (sua posição fica livre até um relocate() ou truncate())
+        void remove(int agent);
+
+        // Move o agente "from" para o índice livre "to", acompanhando a compactação do vetor de inimigos
+        void relocate(int from, int to);
+
+        // Define o número de agentes após a compactação - os índices a partir de "count" já devem ter sido removidos
+        void truncate(int count);
+
+        // Remove todos os agentes
+        void clear();
+
+        // Deslocamento de separação do agente: soma das direções de afastamento dos vizinhos dentro de
+        // CROWD_SEPARATION_RADIUS, com peso decrescendo linearmente com a distância (no máximo 1 por vizinho).
+        // Só lê a grade, podendo ser chamada por várias threads ao mesmo tempo; soma os testes feitos em "pairTests".
+        [[nodiscard]] glm::vec3 separation(int agent, uint64_t &pairTests) const;
+
+        [[nodiscard]] int getCount() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_CROWDGRID_H
@@ -0,0 +1,77 @@
+#ifndef FCG_TRAB_FINAL_FLOWFIELD_H
+#define FCG_TRAB_FINAL_FLOWFIELD_H
+
+// Headers de C++
+#include <cstdint>
+#include <vector>
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+// Tamanho (em unidades de mundo) de cada célula da grade de navegação
+#define FLOW_FIELD_CELL_SIZE 0.25f
+
+// Custo de uma célula ainda não alcançada pela busca
+#define FLOW_FIELD_UNREACHED 1e30f
+
+// Campo de direções compartilhado por todos os inimigos.
+// A arena é dividida em uma grade no plano XZ; quando o alvo (o robô) muda de célula, um Dijkstra a partir
+// da célula do alvo calcula o custo de cada célula livre até ele (vizinhança 8, sem cortar cantos de obstáculos)
+// e cada célula passa a apontar para o vizinho de menor custo. Células com linha de visão até o alvo seguem
+// diretamente para ele. Os inimigos consultam a direção da sua célula em O(1), independente do tamanho da horda.
+class FlowField {
+    private:
+        glm::vec3 boundsMin;
+        float cellSize;
+        int columns;
+        int rows;
+
+        std::vector<uint8_t> blocked;        // Células ocupadas por obstáculos estáticos
+        std::vector<float> costs;            // Custo até a célula do alvo
+        std::vector<glm::vec2> directions;   // Direção (XZ) do vizinho de menor custo
+        std::vector<uint8_t> lineOfSight;    // Células que enxergam a célula do alvo
+        bool hasObstacles;
+
+        // Fila de prioridade do Dijkstra (heap binário em um vetor reservado - sem alocações por busca)
+        struct QueueEntry {
+            float cost;
+            int cell;
+        };
+        std::vector<QueueEntry> queue;
+
+        int targetCell;
+
+        [[nodiscard]] int cellIndex(int column, int row) const;
+        [[nodiscard]] bool isFree(int column, int row) const;
+        void computeCosts(int target);
+        void computeDirections();
+        void computeLineOfSight(int target);
+        [[nodiscard]] bool seesThrough(int deltaColumn, int deltaRow, int targetColumn, int targetRow) const;
+
+    public:
+        FlowField();
+
+        // Cria a grade cobrindo a região [boundsMin, boundsMax] no plano XZ, sem obstáculos
+        void initialize(glm::vec3 boundsMin, glm::vec3 boundsMax, float cellSize);
+
+        // Marca como bloqueadas as células tocadas pela caixa [min, max] (plano XZ); vale a partir do próximo update()
+        void addObstacle(glm::vec3 min, glm::vec3 max);
+
+        // Recalcula o campo se o alvo mudou de célula e há obstáculos; retorna verdadeiro se houve recálculo
+        bool update(glm::vec3 target, bool force = false);
+
+        // Direção normalizada (y = 0) a ser seguida a partir de "position" para alcançar "target"
+        [[nodiscard]] glm::vec3 direction(glm::vec3 position, glm::vec3 target) const;
+
+        // Célula que contém "position", ou -1 fora da grade
+        [[nodiscard]] int cellAt(glm::vec3 position) const;
+
+        // Verdadeiro se "position" está em uma célula ocupada por obstáculo
+        [[nodiscard]] bool isBlocked(glm::vec3 position) const;
+
+        [[nodiscard]] int getColumns() const;
+        [[nodiscard]] int getRows() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_FLOWFIELD_H
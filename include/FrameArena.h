@@ -0,0 +1,44 @@
+#ifndef FCG_TRAB_FINAL_FRAMEARENA_H
+#define FCG_TRAB_FINAL_FRAMEARENA_H
+
+// Headers de C++
+#include <cstddef>
+#include <cstdint>
+
+// Capacidade padrão da arena de quadro (em bytes)
+#define FRAME_ARENA_CAPACITY (1 << 20)
+
+// Arena linear para dados temporários de um quadro. A memória é reservada uma única vez;
+// alocações apenas avançam um ponteiro e tudo é descartado de uma vez em reset().
+class FrameArena {
+    private:
+        unsigned char* memory;
+        size_t capacity;
+        size_t offset;
+        size_t highWater; // Maior uso registrado, para dimensionar a capacidade
+
+    public:
+        explicit FrameArena(size_t capacity = FRAME_ARENA_CAPACITY);
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // Reserva "size" bytes alinhados; retorna nullptr caso a arena esteja cheia
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        // Reserva um vetor de "count" elementos do tipo T (sem construtores - apenas tipos triviais)
+        template <typename T>
+        T* allocateArray(size_t count) {
+            return static_cast<T*>(this->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        // Descarta todas as alocações do quadro
+        void reset();
+
+        [[nodiscard]] size_t used() const;
+        [[nodiscard]] size_t peak() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_FRAMEARENA_H
@@ -0,0 +1,69 @@
+#ifndef FCG_TRAB_FINAL_GLEXTENSIONS_H
+#define FCG_TRAB_FINAL_GLEXTENSIONS_H
+
+// Headers de OpenGL
+#include <glad/glad.h>
+
+// O glad do projeto foi gerado somente para OpenGL 3.3: as constantes e funções de OpenGL 4.3
+// usadas nos caminhos opcionais (compute shaders, SSBOs e desenho indireto) são definidas aqui.
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER 0x91B9
+#endif
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+#endif
+#ifndef GL_COMMAND_BARRIER_BIT
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#endif
+#ifndef GL_BUFFER_UPDATE_BARRIER_BIT
+#define GL_BUFFER_UPDATE_BARRIER_BIT 0x00000200
+#endif
+#ifndef GL_SHADER_STORAGE_BARRIER_BIT
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+
+typedef void (APIENTRYP PFNGLDISPATCHCOMPUTEPROC_EXT)(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
+typedef void (APIENTRYP PFNGLMEMORYBARRIERPROC_EXT)(GLbitfield barriers);
+typedef void (APIENTRYP PFNGLDRAWELEMENTSINDIRECTPROC_EXT)(GLenum mode, GLenum type, const void* indirect);
+typedef void (APIENTRYP PFNGLDRAWARRAYSINDIRECTPROC_EXT)(GLenum mode, const void* indirect);
+
+// Comando lido por glDrawElementsIndirect (layout definido pela especificação)
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+// Comando lido por glDrawArraysIndirect
+struct DrawArraysIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint first;
+    GLuint baseInstance;
+};
+
+// Funções de OpenGL 4.3, carregadas somente quando o contexto criado as suporta.
+// Window::run pede um contexto 4.3 core e, se o driver não o oferecer, volta para 3.3 core.
+class GLExtensions {
+    public:
+        static bool computeSupported;
+
+        static PFNGLDISPATCHCOMPUTEPROC_EXT dispatchCompute;
+        static PFNGLMEMORYBARRIERPROC_EXT memoryBarrier;
+        static PFNGLDRAWELEMENTSINDIRECTPROC_EXT drawElementsIndirect;
+        static PFNGLDRAWARRAYSINDIRECTPROC_EXT drawArraysIndirect;
+
+        // Carrega as funções após gladLoadGLLoader(); retorna se o caminho de OpenGL 4.3 está disponível
+        static bool load(GLADloadproc loader);
+};
+
+
+#endif //FCG_TRAB_FINAL_GLEXTENSIONS_H
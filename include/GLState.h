@@ -0,0 +1,71 @@
+#ifndef FCG_TRAB_FINAL_GLSTATE_H
+#define FCG_TRAB_FINAL_GLSTATE_H
+
+// Headers de C++
+#include <cstdint>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+
+// Limites do cache de estado
+#define GL_STATE_MAX_TEXTURE_UNITS 16
+#define GL_STATE_MAX_PROGRAMS 8
+#define GL_STATE_MAX_UNIFORMS 32
+
+// Último valor enviado a um uniform (até uma mat4), comparado byte a byte
+struct CachedUniform {
+    uint32_t size;
+    uint32_t bits[16];
+};
+
+// Uniforms de um programa, indexados pela localização
+struct CachedProgram {
+    GLuint program;
+    CachedUniform uniforms[GL_STATE_MAX_UNIFORMS];
+};
+
+// Cache do estado de OpenGL usado pelo renderizador: programa, VAO, buffer de vértices, unidade ativa,
+// texturas, samplers e valores de uniforms. Chamadas que não alteram o estado não chegam ao driver.
+// Todo o código que altera esses estados deve passar por aqui (ou chamar invalidate() em seguida).
+// Deve ser usado somente pela thread do contexto de OpenGL.
+class GLState {
+    private:
+        static GLuint program;
+        static GLuint vertexArray;
+        static GLuint arrayBuffer;
+        static GLuint activeUnit;
+        static GLuint textures[GL_STATE_MAX_TEXTURE_UNITS];
+        static GLuint samplers[GL_STATE_MAX_TEXTURE_UNITS];
+
+        // Uniforms dos programas usados recentemente; "current" aponta para o do programa ligado
+        static CachedProgram programs[GL_STATE_MAX_PROGRAMS];
+        static int nextProgramSlot;
+        static CachedProgram* current;
+
+        // Retorna verdadeiro (e atualiza o cache) caso o valor seja diferente do último enviado
+        static bool uniformChanged(GLint location, const void* value, uint32_t size);
+
+        static void issued();
+        static void skipped();
+
+    public:
+        static void useProgram(GLuint program);
+        static void bindVertexArray(GLuint vertexArray);
+        static void bindBuffer(GLenum target, GLuint buffer);
+        static void activeTexture(GLenum texture);
+        static void bindTexture(GLenum target, GLuint texture);
+        static void bindSampler(GLuint unit, GLuint sampler);
+
+        // Uniforms do programa ligado
+        static void uniform1i(GLint location, GLint v0);
+        static void uniform1f(GLint location, GLfloat v0);
+        static void uniform2f(GLint location, GLfloat v0, GLfloat v1);
+        static void uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+        static void uniformMatrix4fv(GLint location, const GLfloat* value);
+
+        // Esquece todo o estado conhecido - necessário após deletar objetos, cujos nomes podem ser reutilizados
+        static void invalidate();
+};
+
+
+#endif //FCG_TRAB_FINAL_GLSTATE_H
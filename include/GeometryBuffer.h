@@ -0,0 +1,82 @@
+#ifndef FCG_TRAB_FINAL_GEOMETRYBUFFER_H
+#define FCG_TRAB_FINAL_GEOMETRYBUFFER_H
+
+// Headers de C++
+#include <cstddef>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+
+// Capacidade inicial do buffer compartilhado (dobrada quando necessário)
+#define GEOMETRY_INITIAL_VERTICES (1 << 17)
+#define GEOMETRY_INITIAL_INDICES (1 << 17)
+
+// Formato comum de vértice de todas as malhas estáticas.
+// Posição e normal são enviadas com 3 componentes: o OpenGL completa "w" com 1.0, o que mantém
+// a posição homogênea e não altera o "xyz" da normal transformada por inverse(transpose(model)).
+struct StaticVertex {
+    float position[3];
+    float normal[3];
+    float texcoord[2];
+};
+
+// Região de uma malha dentro do buffer compartilhado
+struct GeometryRange {
+    GLint baseVertex;    // Primeiro vértice da malha, somado aos índices por glDrawElementsBaseVertex
+    size_t firstIndex;   // Primeiro índice da malha no buffer de índices
+    size_t vertexCount;
+    size_t indexCount;
+};
+
+// Buffer de vértices e de índices único para todas as malhas estáticas, desenhadas através de um só VAO.
+// As malhas são sub-alocadas linearmente; a região de uma malha liberada não é reaproveitada,
+// já que as malhas estáticas vivem até o final da execução.
+class GeometryBuffer {
+    private:
+        GLuint vertexArrayObjectId;
+        GLuint vertexBufferId;
+        GLuint indexBufferId;
+
+        size_t vertexCapacity;
+        size_t indexCapacity;
+        size_t vertexCount;
+        size_t indexCount;
+
+        // Cria o VAO e os buffers no primeiro uso, quando o contexto já existe
+        void create();
+
+        // Aumenta a capacidade, copiando o conteúdo atual na GPU
+        void grow(size_t minVertices, size_t minIndices);
+        static GLuint resizeBuffer(GLuint buffer, size_t usedBytes, size_t newBytes);
+
+        // Aponta os atributos do VAO para o buffer de vértices atual
+        void bindAttributes();
+
+    public:
+        GeometryBuffer();
+
+        // O buffer é dono de objetos de OpenGL: não pode ser copiado
+        GeometryBuffer(const GeometryBuffer&) = delete;
+        GeometryBuffer& operator=(const GeometryBuffer&) = delete;
+
+        // Envia os vértices e índices (relativos ao primeiro vértice da malha) para o final do buffer
+        GeometryRange append(const StaticVertex* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount);
+
+        // Liga um buffer de matrizes de modelo aos atributos por instância ("location = 3" a 6) do VAO compartilhado
+        void setInstanceBuffer(GLuint buffer);
+
+        // Liga um buffer de projéteis aos atributos "location = 9" e 10 (dois vec4 por instância). Os atributos ficam
+        // desabilitados, para não serem lidos além do buffer pelos desenhos instanciados da horda, e são habilitados
+        // somente durante o desenho dos projéteis (com o VAO compartilhado ligado)
+        void setProjectileBuffer(GLuint buffer);
+        void setProjectileAttributesEnabled(bool enabled);
+
+        // Libera os objetos de OpenGL (precisa do contexto ainda ativo)
+        void release();
+
+        [[nodiscard]] GLuint getVertexArrayObject() const;
+        [[nodiscard]] size_t getGpuBytes() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_GEOMETRYBUFFER_H
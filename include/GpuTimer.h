@@ -0,0 +1,80 @@
+#ifndef FCG_TRAB_FINAL_GPUTIMER_H
+#define FCG_TRAB_FINAL_GPUTIMER_H
+
+// Headers de C++
+#include <cstdio>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+
+// Seções lógicas de renderização medidas na GPU
+enum GpuPass {
+    GPU_PASS_SCENERY,
+    GPU_PASS_PLAYER,
+    GPU_PASS_HORDE,
+    GPU_PASS_BOOMERANG,
+    GPU_PASS_HUD,
+    GPU_PASS_COUNT
+};
+
+// Número de quadros de atraso na leitura das queries - evita esperar pela GPU
+#define GPU_TIMER_LATENCY 4
+
+// Queries de um único quadro
+struct GpuTimerFrame {
+    GLuint frameQueries[2];                  // Timestamps de início e fim do quadro
+    GLuint passQueries[GPU_PASS_COUNT][2];   // Timestamps de início e fim de cada seção
+    bool passUsed[GPU_PASS_COUNT];           // Seções efetivamente emitidas no quadro
+    bool pending;                            // Quadro finalizado aguardando leitura
+    unsigned long frameNumber;
+    double cpuMs;                            // Tempo de CPU do mesmo quadro
+};
+
+class GpuTimer {
+    private:
+        GpuTimerFrame frames[GPU_TIMER_LATENCY];
+        unsigned long frameNumber;
+        bool initialized;
+
+        // Último resultado lido (em ms) e acumuladores da sessão
+        double lastPassMs[GPU_PASS_COUNT];
+        double lastGpuMs;
+        double lastCpuMs;
+        double sumPassMs[GPU_PASS_COUNT];
+        double maxPassMs[GPU_PASS_COUNT];
+        double sumGpuMs;
+        double sumCpuMs;
+        unsigned long resolvedFrames;
+        unsigned long droppedFrames;
+
+        // Registro por quadro de tempos de CPU e GPU
+        FILE* log;
+
+        void resolve(GpuTimerFrame &frame);
+
+    public:
+        GpuTimer();
+
+        // Cria o conjunto de queries e abre o arquivo de registro (precisa de contexto OpenGL)
+        void initialize(const char* logFilename);
+
+        // Marca o início do quadro, lendo os resultados do quadro emitido GPU_TIMER_LATENCY quadros atrás
+        void beginFrame();
+        void endFrame(double cpuMs);
+
+        void beginPass(GpuPass pass);
+        void endPass(GpuPass pass);
+
+        // Consulta dos últimos resultados disponíveis
+        [[nodiscard]] double getPassMs(GpuPass pass) const;
+        [[nodiscard]] double getGpuMs() const;
+        [[nodiscard]] double getCpuMs() const;
+
+        // Imprime o resumo da sessão e libera as queries
+        void shutdown();
+
+        static const char* passName(GpuPass pass);
+};
+
+
+#endif //FCG_TRAB_FINAL_GPUTIMER_H
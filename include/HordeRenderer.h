@@ -0,0 +1,180 @@
+#ifndef FCG_TRAB_FINAL_HORDERENDERER_H
+#define FCG_TRAB_FINAL_HORDERENDERER_H
+
+// Headers de C++
+#include <vector>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+#include "glm/mat4x4.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+
+#include "Camera.h"
+#include "GeometryBuffer.h"
+#include "GLExtensions.h"
+#include "SceneObject.h"
+
+// Distância máxima (em unidades de mundo) em que um inimigo ainda é desenhado
+#define HORDE_CULL_DISTANCE 50.0f
+
+// Tamanho do grupo de trabalho em "horde_cull_compute.glsl"
+#define HORDE_CULL_GROUP_SIZE 64
+
+// Número de buffers de comando alternados
+#define HORDE_COMMAND_BUFFERS 2
+
+// Cópias das contagens do descarte em GPU em voo, lidas para as métricas somente quando a GPU já terminou
+#define HORDE_CULL_READBACK_BUFFERS 3
+
+// Distância a partir da qual um inimigo é desenhado como impostor (billboard)
+#define IMPOSTOR_DISTANCE 14.0f
+
+// Altura na tela (em pixels) abaixo da qual um inimigo é desenhado como impostor, mesmo antes de IMPOSTOR_DISTANCE
+#define IMPOSTOR_SCREEN_PIXELS 48.0f
+
+// Largura da faixa de transição entre malha e impostor, centrada na distância de troca
+#define IMPOSTOR_FADE_BAND 2.0f
+
+// Máximo de zumbis desenhados com a malha por quadro; os excedentes (mais distantes que a distância de troca
+// ajustada a cada quadro, ou além do orçamento) viram impostores
+#define HORDE_MESH_BUDGET 1024
+
+// Menor distância de troca para impostor quando a horda excede o orçamento de malhas
+#define HORDE_MESH_MIN_DISTANCE 2.0f
+
+// Dados por inimigo enviados ao descarte (mesmo layout de "Enemies" em "horde_cull_compute.glsl")
+struct HordeInstance {
+    glm::vec4 positionYaw; // Posição (xyz) e rotação em Y (w)
+    glm::vec4 animation;   // Fase do ciclo de caminhada (x); nos impostores, opacidade na transição (y)
+};
+
+// Comando de desenho dos impostores seguido do número de inimigos que passaram pelo descarte e do número
+// dos que pediram a malha, mesmo além do orçamento (mesmo layout de "ImpostorCommand" em "horde_cull_compute.glsl")
+struct ImpostorCommand {
+    DrawArraysIndirectCommand command;
+    GLuint drawnCount;
+    GLuint meshRequests;
+};
+
+// Contagens de um quadro do descarte em GPU, copiadas dos buffers de comando para um buffer de leitura
+struct HordeCullCounts {
+    GLuint visible;
+    ImpostorCommand impostors;
+};
+
+// Leitura assíncrona das contagens de um quadro
+struct HordeCullReadback {
+    GLuint buffer;
+    GLsync fence;
+    GLuint enemyCount; // Inimigos enviados ao descarte no quadro
+};
+
+// Desenho instanciado da horda de zumbis, com descarte por frustum e distância.
+// Com OpenGL 4.3, as posições ficam em um SSBO e um compute shader descarta os inimigos, escreve as
+// matrizes dos visíveis e o comando lido por glDrawElementsIndirect. Sem OpenGL 4.3 (contexto 3.3),
+// o descarte é feito na CPU e as matrizes são enviadas para o mesmo buffer de instâncias.
+// Inimigos distantes (ou pequenos na tela) são desenhados como impostores: quadriláteros voltados para a câmera,
+// com uma faixa de transição em que malha e impostor se completam por dithering. No máximo HORDE_MESH_BUDGET
+// inimigos usam a malha; a distância de troca diminui enquanto mais inimigos que isso a pedem.
+// O descarte em GPU também lê diretamente o estado da horda simulada na GPU (prepareSimulated), pulando os mortos.
+class HordeRenderer {
+    private:
+        GLuint capacity;
+        SceneObject object;
+
+        // Esfera envolvente do zumbi: centro no eixo Y do modelo e raio que cobre qualquer rotação em Y
+        float boundsCenterY;
+        float boundsRadius;
+
+        // Matrizes de modelo dos inimigos visíveis (atributos por instância no VAO compartilhado)
+        GLuint instanceBufferId;
+        std::vector<glm::mat4> cpuInstances;
+        GLuint visibleCount;
+
+        // Posição, rotação e (fase da animação, transição) dos visíveis, montados em lote em cpuInstances
+        std::vector<glm::vec4> cpuVisible;
+        std::vector<glm::vec2> cpuVisibleExtras;
+
+        // Caminho de OpenGL 4.3
+        bool gpuCulling;
+        GLuint computeProgramId;
+        GLuint enemyBufferId;
+        GLuint commandBufferIds[HORDE_COMMAND_BUFFERS];
+        int commandIndex;
+        HordeCullReadback cullReadbacks[HORDE_CULL_READBACK_BUFFERS];
+        unsigned int cullFrame;
+        GLint enemyCountUniform;
+        GLint frustumPlanesUniform;
+        GLint cameraPositionUniform;
+        GLint instanceScaleUniform;
+        GLint boundsUniform;
+        GLint impostorRangeUniform;
+        GLint simulatedStateUniform;
+        GLint meshBudgetUniform;
+
+        // Impostores: posição, rotação e opacidade de cada um (atributos por instância de um VAO próprio)
+        bool impostorsEnabled;
+        GLuint impostorVaoId;
+        GLuint impostorBufferId;
+        std::vector<HordeInstance> cpuImpostors;
+        GLuint impostorCount;
+        GLuint impostorCommandBufferIds[HORDE_COMMAND_BUFFERS];
+
+        // Início e largura da faixa de transição do quadro
+        float impostorStart;
+        float impostorBand;
+
+        // Distância de troca ajustada ao orçamento de malhas
+        float meshDistance;
+
+        void updateImpostorRange(glm::vec3 scale, float modelHeight, const CameraMatrices &camera, float viewportHeight);
+        void updateMeshDistance(GLuint meshRequests);
+        void prepareCpu(const HordeInstance* enemies, GLuint count, glm::vec3 scale, const glm::vec4 planes[6], glm::vec3 cameraPosition);
+        void prepareGpu(const HordeInstance* enemies, GLuint count, glm::vec3 scale, const glm::vec4 planes[6], glm::vec3 cameraPosition);
+        void dispatchCull(GLuint enemyBuffer, GLuint count, bool simulated, glm::vec3 scale, const glm::vec4 planes[6], glm::vec3 cameraPosition);
+        void queueCullReadback(GLuint enemyCount);
+        void pollCullReadbacks();
+        void discardCullReadbacks();
+
+    public:
+        HordeRenderer();
+
+        // Cria o buffer de instâncias (ligado ao VAO compartilhado) e, se computeProgram != 0, os buffers do caminho em GPU.
+        // "capacity" é o máximo de inimigos por quadro (incluindo a horda simulada na GPU).
+        void initialize(GeometryBuffer &geometry, const SceneObject &object, glm::vec3 bboxMin, glm::vec3 bboxMax, GLuint capacity, GLuint computeProgram);
+
+        // Descarta os inimigos com os planos e a posição do quadro da câmera e prepara as instâncias; a fase da animação vai no elemento (3, 0) de cada matriz
+        // e a transição para impostor no elemento (3, 1). "modelHeight" é a altura do modelo sem escala e "viewportHeight"
+        // a altura da janela em pixels. No caminho em GPU, troca o programa ligado para o compute shader.
+        void prepare(const HordeInstance* enemies, GLuint count, glm::vec3 scale, float modelHeight,
+                     const CameraMatrices &camera, float viewportHeight);
+
+        // Como prepare(), lendo as primeiras "slotCount" posições do buffer de estado da horda simulada na GPU ("HordeAgent"),
+        // sem cópia para a CPU. Somente no caminho em GPU.
+        void prepareSimulated(GLuint stateBuffer, GLuint slotCount, glm::vec3 scale, float modelHeight,
+                              const CameraMatrices &camera, float viewportHeight);
+
+        // Desenha as instâncias visíveis - o programa de renderização e seus uniforms já devem estar ligados
+        void draw();
+
+        // Desenha os impostores do quadro, trocando o VAO ligado - o programa dos impostores já deve estar ligado
+        void drawImpostors();
+
+        // Indica se há impostores a desenhar no quadro (no caminho em GPU, se algum inimigo pode tê-los gerado)
+        [[nodiscard]] bool hasImpostors() const;
+
+        // Liga ou desliga os impostores (todos os inimigos visíveis passam a usar a malha)
+        void toggleImpostors();
+        [[nodiscard]] bool isUsingImpostors() const;
+
+        // Alterna entre o descarte em GPU e na CPU (somente se OpenGL 4.3 estiver disponível)
+        void toggleGpuCulling();
+        [[nodiscard]] bool isGpuCulling() const;
+
+        // Libera os objetos de OpenGL
+        void release();
+};
+
+
+#endif //FCG_TRAB_FINAL_HORDERENDERER_H
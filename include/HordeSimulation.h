@@ -0,0 +1,184 @@
+#ifndef FCG_TRAB_FINAL_HORDESIMULATION_H
+#define FCG_TRAB_FINAL_HORDESIMULATION_H
+
+// Headers de C++
+#include <cstdint>
+#include <vector>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+
+#include "GLExtensions.h"
+
+// Número máximo de zumbis simulados na GPU
+#define HORDE_SIM_CAPACITY (1 << 17)
+
+// Zumbis criados por uma onda massiva (tecla N)
+#define HORDE_SIM_WAVE_SIZE 16384
+
+// Tamanho do grupo de trabalho em "horde_simulate_compute.glsl"
+#define HORDE_SIM_GROUP_SIZE 64
+
+// Projéteis testados contra a horda em cada quadro (os demais são ignorados na GPU);
+// deve ser igual a MAX_PROJECTILES nos shaders de simulação
+#define HORDE_SIM_MAX_PROJECTILES 16
+
+// Leituras dos resultados em voo - se todas estiverem ocupadas, a mais antiga espera a GPU
+#define HORDE_SIM_READBACK_BUFFERS 3
+
+// Estado de um zumbi na GPU (dois atributos vec4 por instância)
+struct HordeAgent {
+    glm::vec4 state0; // Posição (xyz) e velocidade (w)
+    glm::vec4 state1; // Ângulo da direção inicial (x), rotação em Y (y), vivo (z), fase da animação (w)
+};
+
+// Dados do quadro usados pela simulação
+struct HordeSimulationInput {
+    float deltaTime;            // Zero quando o jogo está pausado
+    glm::vec3 target;           // Posição do robô, perseguida pelos zumbis
+    glm::vec3 playerBboxMin;
+    glm::vec3 playerBboxMax;
+    GLuint projectileCount;
+    glm::vec4 projectileBoxes[HORDE_SIM_MAX_PROJECTILES];  // Centro (xy) e "raios" (zw) do projétil no plano XZ, no início do deslocamento
+    glm::vec4 projectileSweeps[HORDE_SIM_MAX_PROJECTILES]; // Deslocamento no passo (xy), testado de forma contínua
+    float xDifference;          // Meia largura da bounding box do zumbi em X
+    float zDifference;          // Meia largura da bounding box do zumbi em Z
+    float animationRate;        // Ciclos da animação de caminhada por unidade de distância
+};
+
+// Reduções da simulação, lidas com atraso
+struct HordeSimulationResults {
+    GLuint playerHits;
+    GLuint kills;
+    GLuint alive;
+};
+
+// Leitura assíncrona de um quadro de simulação
+struct HordeReadback {
+    GLuint buffer;
+    GLsync fence;
+    uint64_t spawned;  // Zumbis enviados à GPU até o quadro, para saber quantos vieram depois da compactação
+    GLuint generation; // Reinícios do conjunto até o quadro
+    bool compute;      // Resultado em inteiros (compute shader) ou em floats (transform feedback)
+};
+
+// Cópia assíncrona do estado de um quadro, usada pelo descarte na CPU
+struct HordeStateReadback {
+    GLuint buffer;
+    GLsync fence;
+    GLuint slotCount;
+    GLuint generation;
+};
+
+// Simulação opcional da horda inteiramente na GPU.
+// Os zumbis ficam em dois buffers de estado alternados (ping-pong): a cada passo, o buffer de destino é zerado
+// e recebe, compactados no início, os zumbis que continuam vivos. Com OpenGL 4.3, um compute shader reserva
+// cada posição com um contador atômico; com OpenGL 3.3, um vertex shader com transform feedback simula e um
+// geometry shader emite somente os vivos. Assim as posições dos mortos voltam a ser usadas pelos próximos
+// zumbis sem esperar a horda inteira morrer. O desenho lê o buffer atual através do descarte da horda
+// (HordeRenderer): direto no compute shader de descarte, ou em uma cópia lida com atraso pela CPU.
+// As colisões com o robô e com os projéteis são reduzidas na GPU (contadores atômicos, ou pontos somados
+// com blending em um framebuffer 1x1) e lidas um ou mais quadros depois, sem bloquear a CPU.
+class HordeSimulation {
+    private:
+        GLuint capacity;
+        GLuint slotCount;  // Limite superior das posições ocupadas no buffer atual (reduzido pelas leituras)
+        GLuint generation;
+        bool useCompute;
+
+        // Estado dos zumbis, alternando entre os dois buffers, e um buffer de zeros usado para limpar o destino
+        GLuint stateBufferIds[2];
+        GLuint simulationVaoIds[2];
+        GLuint zeroBufferId;
+        int current;
+
+        // Zumbis a serem escritos nas próximas posições livres antes da simulação
+        std::vector<HordeAgent> pending;
+        uint64_t spawned;
+        unsigned int waveSeed;
+
+        // Programas e uniforms (os mesmos nomes nos dois shaders)
+        GLuint feedbackProgramId;
+        GLuint computeProgramId;
+        struct Uniforms {
+            GLint deltaTime;
+            GLint target;
+            GLint playerBboxMin;
+            GLint playerBboxMax;
+            GLint projectileCount;
+            GLint projectileBoxes;
+            GLint projectileSweeps;
+            GLint halfExtents;
+            GLint animationRate;
+            GLint slotCount;
+        } feedbackUniforms, computeUniforms;
+
+        // Redução: framebuffer 1x1 (OpenGL 3.3) ou buffer de contadores (OpenGL 4.3)
+        GLuint reductionTextureId;
+        GLuint reductionFramebufferId;
+        GLuint resultBufferId;
+
+        // Leituras em voo
+        HordeReadback readbacks[HORDE_SIM_READBACK_BUFFERS];
+        unsigned int frameCounter;
+        HordeSimulationResults accumulated;
+        GLuint lastAlive;
+
+        // Cópias do estado em voo e a última cópia lida
+        HordeStateReadback stateReadbacks[HORDE_SIM_READBACK_BUFFERS];
+        unsigned int stateFrame;
+        std::vector<HordeAgent> stateCopy;
+        GLuint stateCopyCount;
+
+        static Uniforms findUniforms(GLuint program);
+        void setUniforms(const Uniforms &uniforms, const HordeSimulationInput &input);
+        void uploadPending();
+        void simulateFeedback(const HordeSimulationInput &input);
+        void simulateCompute(const HordeSimulationInput &input);
+        void queueReadback();
+        void consumeReadback(HordeReadback &readback);
+        void discardStateCopies();
+
+    public:
+        HordeSimulation();
+
+        // Cria os buffers de estado; computeProgram pode ser 0 (somente transform feedback)
+        void initialize(GLuint capacity, GLuint feedbackProgram, GLuint computeProgram);
+
+        // Enfileira um zumbi, escrito na GPU no próximo simulate(); retorna falso se não houver posição livre
+        bool spawn(glm::vec3 position, glm::vec3 direction, float speed, float phase);
+
+        // Enfileira "count" zumbis em posições aleatórias de um anel ao redor da origem; retorna quantos couberam
+        GLuint spawnWave(GLuint count, float radius, float speed);
+
+        // Executa um passo da simulação e enfileira a leitura das reduções
+        void simulate(const HordeSimulationInput &input);
+
+        // Consome as leituras já terminadas pela GPU; retorna falso se nenhuma estava pronta
+        bool pollResults(HordeSimulationResults &results);
+
+        // Copia o estado atual para um buffer de leitura, para o descarte na CPU (sem compute shaders)
+        void queueStateCopy();
+
+        // Última cópia do estado já terminada pela GPU (um ou mais quadros atrasada); inclui posições livres
+        const HordeAgent* getStateCopy(GLuint &count);
+
+        // Lê (de forma síncrona) os zumbis vivos, usado somente ao desligar a simulação em GPU
+        GLuint readAlive(HordeAgent* agents, GLuint maxAgents);
+
+        // Descarta todos os zumbis e leituras em voo
+        void clear();
+
+        [[nodiscard]] bool isCompute() const;
+        [[nodiscard]] GLuint getStateBuffer() const;
+        [[nodiscard]] GLuint getSlotCount() const;
+        [[nodiscard]] GLuint getAliveCount() const;
+
+        // Libera os objetos de OpenGL
+        void release();
+};
+
+
+#endif //FCG_TRAB_FINAL_HORDESIMULATION_H
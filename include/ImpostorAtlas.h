@@ -0,0 +1,66 @@
+#ifndef FCG_TRAB_FINAL_IMPOSTORATLAS_H
+#define FCG_TRAB_FINAL_IMPOSTORATLAS_H
+
+// Headers de OpenGL
+#include <glad/glad.h>
+#include "glm/mat4x4.hpp"
+#include "glm/vec3.hpp"
+
+// Número de ângulos em Y capturados para cada impostor
+#define IMPOSTOR_VIEWS 8
+
+// Colunas do atlas - as vistas ocupam IMPOSTOR_VIEWS / IMPOSTOR_ATLAS_COLUMNS linhas
+#define IMPOSTOR_ATLAS_COLUMNS 4
+
+// Resolução (em pixels) de cada vista no atlas
+#define IMPOSTOR_CELL_SIZE 256
+
+// Níveis de mipmap gerados - limitados para que as vistas vizinhas não se misturem
+#define IMPOSTOR_MAX_MIP_LEVEL 4
+
+// Atlas com o modelo renderizado a partir de IMPOSTOR_VIEWS ângulos em torno do eixo Y, capturado uma única vez
+// com um framebuffer fora da tela. A vista k é vista a partir da direção (sin a, 0, cos a), a = 2*pi*k/IMPOSTOR_VIEWS,
+// no espaço do modelo, com projeção ortográfica cobrindo o modelo em qualquer rotação em Y.
+class ImpostorAtlas {
+    private:
+        GLuint textureId;
+        GLuint depthRenderbufferId;
+        GLuint framebufferId;
+        GLuint textureUnit;
+
+        // Retângulo capturado no espaço do modelo: largura, altura e altura da base
+        float width;
+        float height;
+        float bottom;
+        float cameraDistance;
+
+        // Estado restaurado ao final da captura
+        GLint previousViewport[4];
+
+    public:
+        ImpostorAtlas();
+
+        // Cria a textura do atlas (na unidade "textureUnit") e o framebuffer de captura
+        bool initialize(glm::vec3 bboxMin, glm::vec3 bboxMax, GLuint textureUnit);
+
+        // Liga o framebuffer do atlas e limpa todas as vistas
+        void beginCapture();
+
+        // Restringe o desenho à vista "view" e retorna as matrizes de câmera e projeção da captura
+        void captureView(int view, glm::mat4 &viewMatrix, glm::mat4 &projection);
+
+        // Volta ao framebuffer da janela e gera os mipmaps do atlas
+        void endCapture();
+
+        [[nodiscard]] bool isReady() const;
+        [[nodiscard]] GLuint getTextureUnit() const;
+        [[nodiscard]] float getWidth() const;
+        [[nodiscard]] float getHeight() const;
+        [[nodiscard]] float getBottom() const;
+
+        // Libera os objetos de OpenGL
+        void release();
+};
+
+
+#endif //FCG_TRAB_FINAL_IMPOSTORATLAS_H
@@ -0,0 +1,100 @@
+#ifndef FCG_TRAB_FINAL_INPUTQUEUE_H
+#define FCG_TRAB_FINAL_INPUTQUEUE_H
+
+// Headers de C++
+#include <vector>
+
+#include "Camera.h"
+
+// Teclas e botões de jogo que passam pela fila de entrada
+enum InputKey {
+    INPUT_W,
+    INPUT_A,
+    INPUT_S,
+    INPUT_D,
+    INPUT_M1,
+    INPUT_M2,
+    INPUT_F,
+    INPUT_KEY_COUNT
+};
+
+// Evento de entrada com o instante (glfwGetTime) em que foi recebido pelo callback
+struct InputEvent {
+    InputKey key;
+    bool pressed;
+    double timestamp;
+
+    InputEvent() {
+        this->key = INPUT_W;
+        this->pressed = false;
+        this->timestamp = 0.0;
+    }
+};
+
+// Estatísticas de latência entre a entrada e a apresentação do quadro (em segundos)
+struct LatencyStats {
+    double last;
+    double sum;
+    double max;
+    unsigned long samples;
+
+    LatencyStats() {
+        this->last = 0.0;
+        this->sum = 0.0;
+        this->max = 0.0;
+        this->samples = 0;
+    }
+};
+
+class InputQueue {
+    private:
+        // Eventos de teclas/botões ainda não consumidos pela simulação
+        std::vector<InputEvent> events;
+
+        // Estado (pressionado ou não) de cada tecla no início do passo de simulação
+        bool state[INPUT_KEY_COUNT];
+
+        // Deslocamento do cursor acumulado desde o último "latch" da câmera
+        float pendingDx;
+        float pendingDy;
+        bool hasPendingCursor;
+
+        // Dimensões da tela, utilizadas no cálculo dos ângulos da câmera livre
+        int screenWidth;
+        int screenHeight;
+
+        // Instante do evento mais antigo que influenciou o quadro atual (negativo se nenhum)
+        double oldestEventTime;
+
+        // Latência entrada-apresentação
+        LatencyStats latency;
+
+        void markEvent(double timestamp);
+
+    public:
+        InputQueue();
+
+        // Enfileiramento a partir dos callbacks da janela
+        void push(InputKey key, bool pressed, double timestamp);
+        void pushCursor(float dx, float dy, double timestamp);
+
+        // Descarta eventos pendentes e solta todas as teclas (ex.: ao pausar)
+        void clear(Camera &camera);
+
+        // Consome os eventos do intervalo [stepStart, stepEnd], atualizando o estado das teclas e o tempo
+        // em que cada tecla de movimento ficou pressionada dentro do passo.
+        void consume(Camera &camera, double stepStart, double stepEnd);
+
+        // Aplica o deslocamento acumulado do cursor na câmera, imediatamente antes da submissão do quadro
+        void latchCursor(Camera &camera);
+
+        // Registra a apresentação do quadro, computando a latência do evento mais antigo aplicado
+        void markPresented(double presentTime);
+
+        void setScreenSize(int width, int height);
+        [[nodiscard]] const LatencyStats &getLatency() const;
+        void printLatency() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_INPUTQUEUE_H
@@ -0,0 +1,99 @@
+#ifndef FCG_TRAB_FINAL_INPUTRECORDING_H
+#define FCG_TRAB_FINAL_INPUTRECORDING_H
+
+// Headers de C++
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "Simulation.h"
+
+// Identificador do formato ("BBR2" em little-endian; a versão 2 inclui os obstáculos na configuração)
+#define RECORDING_MAGIC 0x32524242u
+
+// Passos entre dois hashes do estado gravados junto com a entrada
+#define RECORDING_HASH_INTERVAL 60
+
+// Cabeçalho de um arquivo de gravação (.rec). É seguido, para cada passo, por:
+// - flags (1 byte): pausado, ataque primário, ataque secundário, nova duração do passo, nova direção da câmera, tiro da pistola;
+// - códigos das teclas W, A, S e D (1 byte, 2 bits cada): zero, igual à duração do passo, igual ao passo anterior ou valor explícito;
+// - floats presentes, nesta ordem: duração do passo, direção da câmera (xyz) e tempos explícitos das teclas;
+// - a cada RECORDING_HASH_INTERVAL passos da partida, o hash do estado após o passo (uint64).
+struct RecordingHeader {
+    uint32_t magic;
+    uint32_t hashInterval;
+    uint64_t tickCount;      // Preenchido ao fechar a gravação
+    SimulationConfig config; // Configuração e semente da partida gravada
+};
+
+// Grava a entrada de cada passo de simulação em um arquivo binário compacto: somente o que mudou em relação
+// ao passo anterior é escrito, sem perda de precisão, de forma que a reprodução é idêntica à partida gravada.
+class InputRecorder {
+    private:
+        FILE* file;
+        RecordingHeader header;
+        SimulationInput previous;
+        uint64_t bytes;
+
+    public:
+        InputRecorder();
+        ~InputRecorder();
+
+        InputRecorder(const InputRecorder&) = delete;
+        InputRecorder& operator=(const InputRecorder&) = delete;
+
+        // Cria o arquivo e grava o cabeçalho com a configuração da partida
+        bool open(const char* filename, const SimulationConfig &config, uint32_t hashInterval = RECORDING_HASH_INTERVAL);
+
+        // Grava a entrada, antes do passo
+        void record(const SimulationInput &input);
+
+        // Grava o hash do estado, após o passo, quando o passo da partida é múltiplo do intervalo
+        void recordState(const Simulation &simulation);
+
+        // Completa o cabeçalho e fecha o arquivo, imprimindo o tamanho da gravação
+        void close();
+
+        [[nodiscard]] bool isOpen() const;
+};
+
+// Reproduz uma gravação, devolvendo a entrada de cada passo e comparando os hashes do estado
+class InputReplay {
+    private:
+        std::vector<uint8_t> data;
+        size_t offset;
+        RecordingHeader header;
+        SimulationInput previous;
+        uint64_t ticks;
+        uint64_t checks;
+        uint64_t divergences;
+        uint64_t firstDivergence;
+
+        bool read(void* destination, size_t size);
+
+    public:
+        InputReplay();
+
+        // Carrega a gravação inteira para a memória
+        bool open(const char* filename);
+
+        // Configuração da partida gravada, a ser usada em Simulation::initialize()
+        [[nodiscard]] const SimulationConfig &getConfig() const;
+
+        // Entrada do próximo passo; retorna falso ao final da gravação
+        bool next(SimulationInput &input);
+
+        // Compara o estado após o passo com o hash gravado, se houver; retorna falso em caso de divergência
+        bool verify(const Simulation &simulation);
+
+        // Volta ao início da gravação
+        void rewind();
+
+        [[nodiscard]] bool isOpen() const;
+        [[nodiscard]] uint64_t getTickCount() const;
+        [[nodiscard]] uint64_t getDivergences() const;
+        void printSummary() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_INPUTRECORDING_H
@@ -0,0 +1,149 @@
+#ifndef FCG_TRAB_FINAL_JOBSYSTEM_H
+#define FCG_TRAB_FINAL_JOBSYSTEM_H
+
+// Headers de C++
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Número máximo de threads do sistema de tarefas (incluindo a thread principal)
+#define JOB_MAX_THREADS 8
+
+// Capacidade da fila de cada thread - tarefas excedentes são executadas na hora por quem as criou
+#define JOB_QUEUE_CAPACITY 1024
+
+// Iterações por tarefa usadas pela horda em parallelFor()
+#define JOB_DEFAULT_GRAIN 64
+
+// Função executada por uma tarefa sobre o intervalo [begin, end)
+typedef void (*JobFunction)(void* context, size_t begin, size_t end);
+
+// Contador de dependência: número de tarefas ainda não concluídas de um grupo.
+// Uma fase que depende de outra espera o contador da anterior chegar a zero (wait()).
+struct JobCounter {
+    std::atomic<int> pending;
+
+    JobCounter() {
+        this->pending.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Tarefa: função, contexto e intervalo, sem alocações
+struct Job {
+    JobFunction function;
+    void* context;
+    size_t begin;
+    size_t end;
+    JobCounter* counter;
+};
+
+// Fila circular de uma thread: a dona empilha e desempilha no final; as outras roubam do início
+struct JobQueue {
+    std::mutex mutex;
+    Job jobs[JOB_QUEUE_CAPACITY];
+    size_t head;
+    size_t tail;
+
+    JobQueue() {
+        this->head = 0;
+        this->tail = 0;
+    }
+};
+
+// Medições de uma thread, acumuladas na sessão e no quadro atual
+struct JobWorkerStats {
+    std::atomic<uint64_t> busyNs;
+    std::atomic<uint64_t> jobs;
+    std::atomic<uint64_t> steals;
+    uint64_t frameBusyNs;    // Valor de busyNs no início do quadro
+    float utilization;       // Fração do último quadro gasta executando tarefas
+    double utilizationSum;   // Soma das utilizações dos quadros, para a média da sessão
+
+    JobWorkerStats() {
+        this->busyNs.store(0, std::memory_order_relaxed);
+        this->jobs.store(0, std::memory_order_relaxed);
+        this->steals.store(0, std::memory_order_relaxed);
+        this->frameBusyNs = 0;
+        this->utilization = 0.0f;
+        this->utilizationSum = 0.0;
+    }
+};
+
+// Agendador de tarefas com roubo de trabalho. Cada thread tem a sua fila; uma thread sem tarefas rouba
+// do início da fila das outras. A thread principal é a thread 0 e executa tarefas enquanto espera (wait()).
+// Os resultados devem depender apenas do índice de cada iteração, nunca da thread que a executou.
+class JobSystem {
+    private:
+        int threadCount;
+        std::vector<std::thread> threads;
+        std::unique_ptr<JobQueue[]> queues;
+        std::unique_ptr<JobWorkerStats[]> stats;
+
+        // Threads ociosas dormem até que novas tarefas sejam enfileiradas
+        std::atomic<bool> running;
+        std::atomic<int> queuedJobs;
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+
+        unsigned long frames;
+
+        void workerLoop(int worker);
+        bool popJob(int worker, Job &job);
+        bool stealJob(int worker, Job &job);
+        void execute(int worker, const Job &job);
+        int currentWorker() const;
+
+        template <typename Function>
+        static void ParallelForJob(void* context, size_t begin, size_t end) {
+            (*static_cast<const Function*>(context))(begin, end);
+        }
+
+    public:
+        JobSystem();
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Cria as threads; threadCount = 0 usa o número de núcleos (limitado a JOB_MAX_THREADS)
+        void initialize(int threadCount = 0);
+
+        // Termina as threads e imprime a utilização média de cada uma
+        void shutdown();
+
+        // Enfileira uma tarefa na fila da thread atual, incrementando o contador (se houver)
+        void schedule(JobFunction function, void* context, size_t begin, size_t end, JobCounter* counter);
+
+        // Executa tarefas até que o contador chegue a zero
+        void wait(JobCounter &counter);
+
+        // Divide [0, count) em tarefas de "grain" iterações, chamando function(begin, end), e espera todas
+        template <typename Function>
+        void parallelFor(size_t count, size_t grain, const Function &function) {
+            if (count == 0) {
+                return;
+            }
+            grain = std::max(grain, (size_t) 1);
+
+            JobCounter counter;
+            for (size_t begin = 0; begin < count; begin += grain) {
+                this->schedule(&JobSystem::ParallelForJob<Function>, (void*) &function, begin, std::min(begin + grain, count), &counter);
+            }
+            this->wait(counter);
+        }
+
+        // Calcula a utilização de cada thread no quadro que terminou, com duração "frameSeconds"
+        void endFrame(double frameSeconds);
+
+        [[nodiscard]] int getThreadCount() const;
+        [[nodiscard]] float getUtilization(int worker) const;
+};
+
+
+#endif //FCG_TRAB_FINAL_JOBSYSTEM_H
@@ -0,0 +1,82 @@
+#ifndef FCG_TRAB_FINAL_MESH_H
+#define FCG_TRAB_FINAL_MESH_H
+
+// Headers de C++
+#include <map>
+#include <string>
+#include <vector>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+#include "glm/vec3.hpp"
+
+#include "LoadedObj.h"
+#include "SceneObject.h"
+#include "GeometryBuffer.h"
+
+// Intervalo de índices e limites de uma forma do OBJ, montados na CPU antes do envio
+struct MeshShapeRange {
+    size_t first_index;
+    size_t num_indices;
+    glm::vec3 bbox_min;
+    glm::vec3 bbox_max;
+};
+
+// Malha carregada de um arquivo OBJ: dona de uma região do buffer de geometria compartilhado e dos limites da geometria.
+// Os dados de CPU (LoadedObj) podem ser descartados após o envio para a GPU.
+class Mesh {
+    private:
+        std::string path;
+
+        // Geometria na CPU - vazia após releaseCpuData()
+        LoadedObj obj;
+        bool cpuDataResident;
+
+        // Região no buffer compartilhado e VAO comum a todas as malhas estáticas
+        GeometryRange range;
+        GLuint vertexArrayObjectId;
+        size_t gpuBytes;
+
+        // Axis-Aligned Bounding Box da malha (coordenadas locais)
+        glm::vec3 bboxMin;
+        glm::vec3 bboxMax;
+
+        // Nomes das formas adicionadas à cena virtual
+        std::vector<std::string> sceneObjectNames;
+
+        // Funções para adição na cena virtual
+        void BuildTrianglesAndAddToVirtualScene(std::map<std::string, SceneObject> &virtualScene, GeometryBuffer &geometry);
+
+    public:
+        // Carrega o OBJ, computa normais, envia para o buffer compartilhado e, se keepCpuData for falso, descarta a geometria da CPU
+        Mesh(const char* path, std::map<std::string, SceneObject> &virtualScene, GeometryBuffer &geometry, bool keepCpuData = false);
+
+        // A malha é dona de objetos de OpenGL: não pode ser copiada
+        Mesh(const Mesh&) = delete;
+        Mesh& operator=(const Mesh&) = delete;
+
+        // Etapas de CPU do carregamento, sem uso de OpenGL (também medidas pela ferramenta bench)
+        static void ComputeNormals(LoadedObj &obj); // Normais de Gouraud, caso o OBJ não as especifique
+        static void BuildTriangles(const LoadedObj &obj, std::vector<StaticVertex> &vertices, std::vector<GLuint> &indices, std::vector<MeshShapeRange> &shapeRanges);
+
+        // Descarta a geometria mantida na CPU
+        void releaseCpuData();
+
+        // Esquece a região no buffer compartilhado; o espaço só é recuperado quando o GeometryBuffer inteiro é liberado
+        void release();
+
+        // Getters
+        [[nodiscard]] const std::string &getPath() const;
+        [[nodiscard]] const LoadedObj &getObj() const;
+        [[nodiscard]] bool isCpuDataResident() const;
+        [[nodiscard]] GLuint getVertexArrayObject() const;
+        [[nodiscard]] const GeometryRange &getRange() const;
+        [[nodiscard]] size_t getGpuBytes() const;
+        [[nodiscard]] size_t getCpuBytes() const;
+        [[nodiscard]] glm::vec3 getBboxMin() const;
+        [[nodiscard]] glm::vec3 getBboxMax() const;
+        [[nodiscard]] const std::vector<std::string> &getSceneObjectNames() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_MESH_H
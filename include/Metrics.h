@@ -0,0 +1,91 @@
+#ifndef FCG_TRAB_FINAL_METRICS_H
+#define FCG_TRAB_FINAL_METRICS_H
+
+// Headers de C++
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// Contadores incrementados durante o quadro pelo renderizador, colisões e gerador de inimigos
+enum Counter {
+    COUNTER_DRAW_CALLS,            // Chamadas de desenho
+    COUNTER_STATE_CHANGES,         // Trocas de estado de OpenGL (programa, VAO, textura, uniform)
+    COUNTER_STATE_CHANGES_SKIPPED, // Trocas de estado redundantes evitadas pelo cache (GLState)
+    COUNTER_TRIANGLES,             // Triângulos submetidos
+    COUNTER_INSTANCES_CULLED,      // Instâncias descartadas antes do desenho
+    COUNTER_IMPOSTORS,             // Inimigos desenhados como impostores (billboards)
+    COUNTER_PAIR_TESTS,            // Testes de colisão entre pares
+    COUNTER_ALLOCATIONS,           // Alocações no heap
+    COUNTER_ENEMIES_ALIVE,         // Inimigos vivos ao final do quadro
+    COUNTER_ENEMIES_SPAWNED,       // Inimigos criados no quadro
+    COUNTER_COUNT
+};
+
+// Número de quadros considerados nas estatísticas móveis
+#define METRICS_WINDOW 120
+
+// Intervalo padrão (em segundos) entre exportações de métricas
+#define METRICS_EXPORT_INTERVAL 5.0
+
+// Estatística móvel de um contador
+struct CounterStats {
+    uint64_t last;
+    uint64_t min;
+    uint64_t max;
+    double avg;
+};
+
+class Metrics {
+    private:
+        // Valores do quadro em andamento
+        static std::atomic<uint64_t> current[COUNTER_COUNT];
+
+        // Valores dos últimos METRICS_WINDOW quadros finalizados
+        static uint64_t history[COUNTER_COUNT][METRICS_WINDOW];
+        static uint64_t totals[COUNTER_COUNT];
+        static unsigned long frames;
+
+        // Exportação periódica
+        static FILE* csvFile;
+        static const char* jsonFilename;
+        static double exportInterval;
+        static double lastExportTime;
+
+        static void writeJson(double time);
+
+    public:
+        // Incrementa um contador no quadro atual
+        static inline void add(Counter counter, uint64_t amount = 1) {
+            current[counter].fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        // Define o valor de um contador do tipo "medidor" (ex.: inimigos vivos)
+        static inline void set(Counter counter, uint64_t value) {
+            current[counter].store(value, std::memory_order_relaxed);
+        }
+
+        // Valor parcial do quadro em andamento
+        static inline uint64_t get(Counter counter) {
+            return current[counter].load(std::memory_order_relaxed);
+        }
+
+        // Finaliza o quadro: guarda o snapshot no histórico e zera os contadores
+        static void endFrame();
+
+        // Estatísticas móveis dos últimos quadros
+        static CounterStats stats(Counter counter);
+
+        // Configura a exportação em CSV (uma linha por intervalo) e JSON (resumo reescrito a cada intervalo)
+        static void configureExport(const char* csvFilename, const char* jsonFilename, double interval = METRICS_EXPORT_INTERVAL);
+
+        // Exporta caso o intervalo tenha passado
+        static void update(double time);
+
+        // Exportação final e fechamento dos arquivos
+        static void shutdown(double time);
+
+        static const char* counterName(Counter counter);
+};
+
+
+#endif //FCG_TRAB_FINAL_METRICS_H
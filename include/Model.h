@@ -2,9 +2,7 @@
 #define FCG_TRAB_FINAL_MODEL_H
 
 #include "glm/vec4.hpp"
-#include "LoadedObj.h"
-#include "SceneObject.h"
-#include "Camera.h"
+#include "Mesh.h"
 #include <string>
 
 class Model {
@@ -13,7 +11,7 @@ class Model {
         // Características do modelo
         glm::vec3 scale;
         std::string name;
-        LoadedObj obj;
+        const Mesh* mesh; // Malha compartilhada - o modelo guarda apenas o estado de transformação
         int objectId;
         glm::vec3 position;
         glm::vec3 direction;
@@ -22,31 +20,14 @@ class Model {
         // Posição original do modelo - para cálculos de direção e movimentação
         glm::vec3 originalPosition;
 
-        // Funções para adição na cena virutal
-        void ComputeNormals();
-        void BuildTrianglesAndAddToVirtualScene(std::map<std::string, SceneObject> &virtualScene);
-
     public:
-        Model(int id, glm::vec3 position, glm::vec3 scale, glm::vec3 direction, float rotation, const char* name, const char* path, std::map<std::string, SceneObject> &virtualScene);
-
-        // Move o jogador
-        void updatePlayer(float delta_t, Camera &camera, const Model& box);
+        Model(int id, glm::vec3 position, glm::vec3 scale, glm::vec3 direction, float rotation, const char* name, const Mesh* mesh);
 
-        // Move o bumerange
-        bool updateBoomerang(bool &boomerangIsThrown,
-                                bool &primaryAttackStarts,
-                                bool &secondaryAttackStarts,
-                                bool &M1,
-                                bool &M2,
-                                bool &isPaused,
-                                float &rotationBoomerang,
-                                float &t,
-                                float &delta_t,
-                                glm::vec3 &robotPosition,
-                                float robotRotation,
-                                glm::vec3 &sceneryBboxMin,
-                                glm::vec3 &sceneryBboxMax,
-                                glm::mat4 &model);
+        // Modelos são apenas movidos, nunca copiados
+        Model(Model&&) noexcept = default;
+        Model& operator=(Model&&) noexcept = default;
+        Model(const Model&) = delete;
+        Model& operator=(const Model&) = delete;
 
         // "Raio" da bounding box
         float x_difference;
@@ -64,7 +45,8 @@ class Model {
         glm::vec3 getDirection();
         glm::vec3 getScale();
         [[nodiscard]] float getRotation() const;
-        std::string getName();
+        [[nodiscard]] const std::string &getName() const;
+        [[nodiscard]] const Mesh* getMesh() const;
         [[nodiscard]] int getId() const;
         glm::vec3 getOriginalPosition();
 
@@ -0,0 +1,92 @@
+#ifndef FCG_TRAB_FINAL_PROFILER_H
+#define FCG_TRAB_FINAL_PROFILER_H
+
+// Headers de C++
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Capacidade do buffer circular de cada thread (potência de 2)
+#define PROFILER_BUFFER_CAPACITY (1 << 16)
+
+// Zona de profiling já finalizada
+struct ProfileZone {
+    const char* name; // Nome da zona - deve ser um literal de string
+    uint64_t begin;   // Instante de início em nanossegundos
+    uint64_t end;     // Instante de fim em nanossegundos
+};
+
+// Buffer circular de zonas de uma única thread. Apenas a thread dona escreve;
+// o índice de escrita atômico permite a leitura pela exportação sem travas.
+struct ProfileBuffer {
+    ProfileZone zones[PROFILER_BUFFER_CAPACITY];
+    std::atomic<uint64_t> written;
+    uint32_t threadId;
+
+    ProfileBuffer() {
+        this->written.store(0, std::memory_order_relaxed);
+        this->threadId = 0;
+    }
+};
+
+class Profiler {
+    public:
+        // Instante atual em nanossegundos, a partir de um relógio monotônico
+        static inline uint64_t now() {
+            return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Buffer da thread atual, criado e registrado no primeiro uso
+        static ProfileBuffer &threadBuffer();
+
+        // Registra uma zona finalizada no buffer da thread atual
+        static inline void record(const char* name, uint64_t begin, uint64_t end) {
+            ProfileBuffer &buffer = threadBuffer();
+            uint64_t index = buffer.written.load(std::memory_order_relaxed);
+            ProfileZone &zone = buffer.zones[index & (PROFILER_BUFFER_CAPACITY - 1)];
+            zone.name = name;
+            zone.begin = begin;
+            zone.end = end;
+            buffer.written.store(index + 1, std::memory_order_release);
+        }
+
+        // Exporta as zonas registradas no formato "trace event" do Chrome (chrome://tracing, Perfetto)
+        static bool exportChromeTrace(const char* filename);
+};
+
+// Zona com escopo: registra início na construção e fim na destruição
+class ProfileScope {
+    private:
+        const char* name;
+        uint64_t begin;
+
+    public:
+        explicit ProfileScope(const char* name) {
+            this->name = name;
+            this->begin = Profiler::now();
+        }
+
+        ~ProfileScope() {
+            Profiler::record(this->name, this->begin, Profiler::now());
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+// Macros de profiling - compiladas para nada quando ENABLE_PROFILING não está definido
+#ifdef ENABLE_PROFILING
+    #define PROFILE_CONCAT_INNER(a, b) a##b
+    #define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+    #define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+    #define PROFILE_EXPORT(filename) Profiler::exportChromeTrace(filename)
+#else
+    #define PROFILE_SCOPE(name) ((void) 0)
+    #define PROFILE_FUNCTION() ((void) 0)
+    #define PROFILE_EXPORT(filename) ((void) 0)
+#endif
+
+
+#endif //FCG_TRAB_FINAL_PROFILER_H
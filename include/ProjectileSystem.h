@@ -0,0 +1,126 @@
+#ifndef FCG_TRAB_FINAL_PROJECTILESYSTEM_H
+#define FCG_TRAB_FINAL_PROJECTILESYSTEM_H
+
+// Headers de C++
+#include <cstdint>
+#include <vector>
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+#include "Trajectory.h"
+
+// Número máximo de projéteis simultâneos - os vetores são alocados uma única vez com esta capacidade
+#define MAX_PROJECTILES 256
+
+// Tipos de projétil: definem o desenho e as regras de lançamento da simulação
+#define PROJECTILE_BOOMERANG 0
+#define PROJECTILE_BULLET 1
+
+// Trajetórias
+#define TRAJECTORY_LINEAR 0 // Linha reta até o alcance
+#define TRAJECTORY_CURVE 1  // Percorre ProjectileLaunch::path com velocidade constante, até o final da curva
+
+// Zumbis lembrados por projétil perfurante, para que cada um seja atingido uma única vez (os mais antigos
+// são esquecidos quando a lista enche)
+#define PROJECTILE_MAX_TARGETS 16
+
+// Parâmetros de um lançamento
+struct ProjectileLaunch {
+    uint8_t kind;
+    uint8_t trajectory;
+    glm::vec3 origin;
+    glm::vec3 direction;  // Somente x e z são usados no deslocamento
+    glm::vec2 halfSize;   // "Raios" x e z da bounding box
+    float speed;          // Unidades por segundo
+    float range;          // Distância máxima da origem, no plano XZ
+    float lifetime;       // Tempo máximo de voo, em segundos
+    float damage;         // Vida retirada do zumbi atingido
+    bool piercing;        // Continua o voo após atingir um zumbi
+    Trajectory path;      // Curva de TRAJECTORY_CURVE, no espaço do mundo, montada uma única vez pelo lançador
+
+    ProjectileLaunch() {
+        this->kind = PROJECTILE_BOOMERANG;
+        this->trajectory = TRAJECTORY_LINEAR;
+        this->origin = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->direction = glm::vec3(0.0f, 0.0f, 1.0f);
+        this->halfSize = glm::vec2(0.0f, 0.0f);
+        this->speed = 0.0f;
+        this->range = 0.0f;
+        this->lifetime = 0.0f;
+        this->damage = 0.0f;
+        this->piercing = false;
+    }
+};
+
+// Conjunto de projéteis de capacidade fixa, guardado como estrutura de vetores (um vetor por campo).
+// Os projéteis vivos ocupam os índices [0, getCount()); um projétil removido é substituído pelo último.
+// Todos avançam em uma única passada por update(); o deslocamento de cada um no passo fica guardado para
+// o teste contínuo contra os zumbis, e um projétil que termina o voo ainda é testado e desenhado no seu
+// último passo antes de ser removido.
+class ProjectileSystem {
+    private:
+        size_t count;
+
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> origins;
+        std::vector<glm::vec3> directions;
+        std::vector<Trajectory> paths;     // Curva e tabela de comprimento de arco (TRAJECTORY_CURVE)
+        std::vector<glm::vec3> sweeps;     // Deslocamento no último passo
+        std::vector<glm::vec2> halfSizes;
+        std::vector<float> speeds;
+        std::vector<float> ranges;
+        std::vector<float> lifetimes;      // Tempo de voo restante
+        std::vector<float> damages;
+        std::vector<float> spins;          // Rotação do giro, para o desenho
+        std::vector<float> distances;      // Distância percorrida sobre a curva
+        std::vector<uint8_t> kinds;
+        std::vector<uint8_t> trajectories;
+        std::vector<uint8_t> flags;
+        std::vector<uint32_t> targets;      // PROJECTILE_MAX_TARGETS identificadores por projétil: zumbis já atingidos
+        std::vector<uint32_t> targetCounts; // Acertos registrados (a lista de cada projétil é circular)
+
+        bool move(size_t index, glm::vec3 target, glm::vec3 sceneryMin, glm::vec3 sceneryMax);
+        void remove(size_t index);
+
+    public:
+        ProjectileSystem();
+
+        // Remove todos os projéteis
+        void clear();
+
+        // Adiciona um projétil; retorna falso se a capacidade foi atingida ou se a curva de TRAJECTORY_CURVE está vazia
+        bool launch(const ProjectileLaunch &launch);
+
+        // Remove os projéteis que terminaram o voo no passo anterior e avança os demais pela sua trajetória,
+        // parando na parede do cenário (caixa [sceneryMin, sceneryMax])
+        void update(float delta_t, bool isPaused, glm::vec3 sceneryMin, glm::vec3 sceneryMax);
+
+        // Teste contínuo do deslocamento do último passo do projétil contra um zumbi (cilindro)
+        bool sweep(size_t index, glm::vec3 cylinderBbox_min, glm::vec3 cylinderBbox_max, float &timeOfImpact) const;
+
+        // Aplica o acerto do projétil no zumbi "enemyId", retornando o dano. Projéteis não perfurantes são gastos
+        // no primeiro acerto; os perfurantes guardam o zumbi e não causam dano nele de novo
+        float hit(size_t index, uint32_t enemyId);
+
+        // Verdadeiro se o projétil perfurante já atingiu o zumbi (lido em paralelo pela simulação da horda)
+        [[nodiscard]] bool hasHit(size_t index, uint32_t enemyId) const;
+
+        // Número de projéteis vivos de um tipo
+        [[nodiscard]] size_t countKind(uint8_t kind) const;
+
+        // Acumula o estado dos projéteis vivos no hash FNV-1a da simulação
+        void hash(uint64_t &hash) const;
+
+        // Estado para o desenho e para a simulação da horda na GPU
+        [[nodiscard]] size_t getCount() const;
+        [[nodiscard]] const glm::vec3* getPositions() const;
+        [[nodiscard]] const glm::vec3* getSweeps() const;
+        [[nodiscard]] const glm::vec2* getHalfSizes() const;
+        [[nodiscard]] const float* getSpins() const;
+        [[nodiscard]] const uint8_t* getKinds() const;
+        [[nodiscard]] bool isVisible(size_t index) const; // Falso para projéteis já gastos em um acerto
+};
+
+
+#endif //FCG_TRAB_FINAL_PROJECTILESYSTEM_H
@@ -7,6 +7,22 @@
 #include "matrices.h"
 #include "glad/glad.h"
 #include "Model.h"
+#include "InputQueue.h"
+#include "GpuTimer.h"
+#include "TextRenderer.h"
+#include "Metrics.h"
+#include "FrameArena.h"
+#include "Mesh.h"
+#include "AssetRegistry.h"
+#include "GeometryBuffer.h"
+#include "HordeRenderer.h"
+#include "HordeSimulation.h"
+#include "VertexAnimation.h"
+#include "ImpostorAtlas.h"
+#include "JobSystem.h"
+#include "Simulation.h"
+#include "InputRecording.h"
+#include <memory>
 #include <glm/gtc/type_ptr.hpp>
 #include <GLFW/glfw3.h>
 #include <fstream>
@@ -14,24 +30,19 @@
 #include <map>
 #include <stb_image.h>
 
-// Estrutura para dados de inimigo individuais
-struct enemyData {
-    glm::vec3 position;
-    glm::vec3 direction;
-    float rotation;
-    glm::vec3 bbox_min;
-    glm::vec3 bbox_max;
-    float speed;
-
-    enemyData() {
-        this->position = glm::vec3(0.0f, 0.0f, 0.0f);
-        this->direction = glm::vec3(0.0f, 0.0f, 0.0f);
-        this->rotation = 0.0f;
-        this->bbox_min = glm::vec3(0.0f, 0.0f, 0.0f);
-        this->bbox_max = glm::vec3(0.0f, 0.0f, 0.0f);
-        this->speed = 0.0f;
-    }
+// Modos de limitação de quadros enfileirados no driver
+#define FRAME_LIMIT_OFF 0    // Sem limitação
+#define FRAME_LIMIT_FENCE 1  // Espera por fences de quadros anteriores
+#define FRAME_LIMIT_FINISH 2 // glFinish() após cada quadro
+#define MAX_FRAMES_IN_FLIGHT 1
 
+// Número de quadros exibidos no gráfico de tempo do HUD
+#define HUD_HISTORY_SIZE 120
+
+// Dados por projétil do desenho instanciado ("location = 9" e 10 em "shader_vertex.glsl")
+struct ProjectileInstance {
+    glm::vec4 positionSpin; // Posição (xyz) e giro em Z (w)
+    glm::vec4 scaleTilt;    // Escala (xyz) e inclinação em X (w)
 };
 
 class Renderer{
@@ -44,16 +55,108 @@ class Renderer{
         GLint object_id_uniform;
         GLint bbox_min_uniform;
         GLint bbox_max_uniform;
+        GLint instanced_uniform;
+        GLint vat_info_uniform;
 
         // Número de texturas carregadas pela função LoadTextureImage()
         GLuint numLoadedTextures = 0;
 
+        // Recursos compartilhados e referências mantidas pelo renderizador (devolvidas em shutdown())
+        AssetRegistry assets;
+        std::vector<Asset*> ownedAssets;
+        Asset* gpuProgramAsset;
+        Asset* hudProgramAsset;
+
+        // Buffer de vértices e índices compartilhado por todas as malhas estáticas (um único VAO)
+        GeometryBuffer staticGeometry;
+
+        // Caixa unitária desenhada em cada obstáculo da configuração da simulação
+        SceneObject obstacleBox;
+        void CreateObstacleBox();
+        void DrawObstacles();
+
+        // Projéteis vivos, desenhados com uma única chamada instanciada
+        GLuint projectileBufferId;
+        void DrawProjectiles(Model &object);
+
+        // Desenho instanciado da horda, com descarte em GPU (OpenGL 4.3) ou na CPU
+        HordeRenderer horde;
+        GLuint hordeCullProgramID;
+        Asset* hordeCullProgramAsset;
+
+        // Impostores dos zumbis distantes: atlas capturado em initialize() e programa dos quadriláteros
+        ImpostorAtlas impostorAtlas;
+        GLuint impostorProgramID;
+        Asset* impostorProgramAsset;
+        GLint impostor_view_uniform;
+        GLint impostor_projection_uniform;
+        GLint impostor_size_uniform;
+        GLint impostor_grid_uniform;
+        void CaptureImpostors(); // Renderiza o zumbi a partir de IMPOSTOR_VIEWS ângulos no atlas
+        void DrawImpostors(const glm::mat4 &view, const glm::mat4 &projection);
+
+        // Threads que dividem a simulação dos zumbis e a montagem das instâncias
+        JobSystem jobs;
+
+        // Regras do jogo (robô, bumerange, horda e fases), sem dependência de OpenGL
+        Simulation simulation;
+
+        // Gravação da entrada de cada passo ou reprodução de uma gravação no lugar da entrada do usuário
+        InputRecorder recorder;
+        InputReplay replay;
+
+        // Ciclo de caminhada dos zumbis, amostrado no vertex shader a partir de uma textura
+        VertexAnimation zombieAnimation;
+
+        // Simulação opcional da horda na GPU (transform feedback em OpenGL 3.3, compute shader em 4.3)
+        HordeSimulation hordeSimulation;
+        bool gpuSimulation;
+        GLuint hordeFeedbackProgramID;
+        Asset* hordeFeedbackProgramAsset;
+        GLuint hordeSimulateProgramID;
+        Asset* hordeSimulateProgramAsset;
+        std::vector<HordeInstance> simulatedInstances; // Vivos da cópia do estado, no descarte na CPU
+        bool RenderSimulatedHorde(Model &object, float delta_t, bool isPaused, const CameraMatrices &frame, float viewportHeight); // Retorna falso se o robô foi atingido
+
         /* Declaração de funções de renderização */
         GLuint LoadShader_Vertex(const char* filename);   // Carrega um vertex shader
         GLuint LoadShader_Fragment(const char* filename); // Carrega um fragment shader
-        void LoadShader(const char* filename, GLuint shader_id); // Função utilizada pelas duas acima
-        GLuint CreateGpuProgram(GLuint vertex_shader_id, GLuint fragment_shader_id); // Cria um programa de GPU
-        void DrawVirtualObject(const char* object_name);
+        GLuint LoadShader_Geometry(const char* filename); // Carrega um geometry shader
+        void LoadShader(const char* filename, GLuint shader_id); // Função utilizada pelas três acima
+        GLuint CreateGpuProgram(GLuint vertex_shader_id, GLuint fragment_shader_id, const char* const* feedbackVaryings = nullptr, GLsizei feedbackCount = 0,
+                                GLuint geometry_shader_id = 0); // Cria um programa de GPU
+        GLuint LoadGpuProgram(const char* vertexFilename, const char* fragmentFilename, Asset* &asset, const char* const* feedbackVaryings = nullptr, GLsizei feedbackCount = 0,
+                              const char* geometryFilename = nullptr); // Programa compartilhado pelo registro
+        GLuint LoadComputeProgram(const char* filename, Asset* &asset); // Programa com um compute shader (OpenGL 4.3)
+        void SetBboxUniforms(const SceneObject &object);
+        void DrawVirtualObject(const SceneObject &object);
+
+        // Objeto da cena virtual de cada modelo, indexado pelo identificador do modelo
+        std::vector<const SceneObject*> modelSceneObjects;
+
+        // Arena para dados temporários do quadro
+        FrameArena frameArena;
+
+        // Programa de GPU e renderizador de texto do HUD
+        GLuint hudProgramID;
+        TextRenderer textRenderer;
+        bool showHud;
+
+        // Histórico de tempos de quadro e contagem de FPS para o HUD
+        float cpuHistory[HUD_HISTORY_SIZE];
+        float gpuHistory[HUD_HISTORY_SIZE];
+        int historyIndex;
+        double fpsTimer;
+        int fpsFrames;
+        float fps;
+        void DrawHud(int width, int height);
+
+        // Limitação de quadros enfileirados
+        int frameLimitMode;
+        GLsync frameFences[MAX_FRAMES_IN_FLIGHT];
+        unsigned int frameIndex;
+        void waitQueuedFrames(); // Espera o quadro mais antigo em voo antes de amostrar a entrada
+        void markFrameSubmitted(); // Sinaliza o final da submissão do quadro
 
     public:
         Renderer();
@@ -61,16 +164,50 @@ class Renderer{
         // Inicializa o renderizador
         void initialize();
 
+        // Grava a entrada da partida em um arquivo (após initialize())
+        bool startRecording(const char* filename);
+
+        // Recomeça a partida com a configuração e a semente de uma gravação e passa a reproduzir a sua entrada (após initialize())
+        bool startReplay(const char* filename);
+
+        // Finaliza o renderizador, imprimindo as medições de tempo e liberando os objetos de OpenGL
+        void shutdown();
+
+        // Tempos de GPU por seção de renderização, lidos com alguns quadros de atraso
+        GpuTimer gpuTimer;
+
         // Vetor de modelos a serem renderizados
         std::vector<Model> models;
 
+        // Carrega uma malha através do registro - os modelos guardam apenas ponteiros para ela
+        const Mesh* LoadMesh(const char* path, bool keepCpuData = false);
+
         std::map<std::string, SceneObject> virtualScene;
 
         void LoadShadersFromFiles(); // Carrega os shaders de vértice e fragmento, criando um programa de GPU
         void LoadTextureImage(const char* filename); // Função que carrega imagens de textura
+        void LoadVertexAnimation(const char* filename); // Carrega a animação dos zumbis (após LoadMesh do zumbi), usando duas unidades de textura
+
+        // Alterna entre os modos de limitação de quadros enfileirados
+        void cycleFrameLimitMode();
+
+        // Mostra ou esconde o HUD de desempenho
+        void toggleHud();
+
+        // Alterna o descarte da horda entre GPU e CPU
+        void toggleGpuCulling();
+
+        // Liga ou desliga os impostores dos zumbis distantes
+        void toggleImpostors();
+
+        // Alterna a simulação da horda entre GPU e CPU, transferindo os zumbis vivos
+        void toggleGpuSimulation();
+
+        // Cria uma onda massiva de zumbis, ligando a simulação em GPU se necessário
+        void spawnMassiveWave();
 
         // Renderização geral de modelos
-        bool render(GLFWwindow* window, bool isPaused, Camera &camera, const float &aspectRatio, float &initialTime, float &spawnTime);
+        bool render(GLFWwindow* window, bool isPaused, Camera &camera, InputQueue &input, const float &aspectRatio, float &initialTime);
 };
 
 
@@ -15,12 +15,13 @@ class SceneObject{
         size_t       num_indices; // Número de índices do objeto dentro do vetor indices[] definido em BuildTrianglesAndAddToVirtualScene()
         GLenum       rendering_mode; // Modo de rasterização (GL_TRIANGLES, GL_TRIANGLE_STRIP, etc.)
         GLuint       vertex_array_object_id; // ID do VAO onde estão armazenados os atributos do modelo
+        GLint        base_vertex; // Primeiro vértice do objeto no buffer compartilhado, somado a cada índice
 
         // Axis-Aligned Bounding Box do objeto
         glm::vec3    bbox_min;
         glm::vec3    bbox_max;
 
-        SceneObject(std::string name, size_t first_index, size_t num_indices, GLenum rendering_mode, GLuint vertex_array_object_id, glm::vec3 bbox_min, glm::vec3 bbox_max);
+        SceneObject(std::string name, size_t first_index, size_t num_indices, GLenum rendering_mode, GLuint vertex_array_object_id, glm::vec3 bbox_min, glm::vec3 bbox_max, GLint base_vertex = 0);
         SceneObject();
 };
 
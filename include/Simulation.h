@@ -0,0 +1,282 @@
+#ifndef FCG_TRAB_FINAL_SIMULATION_H
+#define FCG_TRAB_FINAL_SIMULATION_H
+
+// Headers de C++
+#include <cstdint>
+#include <vector>
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+#include "FlowField.h"
+#include "CrowdGrid.h"
+#include "JobSystem.h"
+#include "ProjectileSystem.h"
+
+// Número máximo de inimigos simultâneos - o vetor de inimigos é reservado com esta capacidade
+#define MAX_ENEMIES 1024
+
+// Pistola: intervalo mínimo entre dois tiros (em segundos), velocidade, alcance e dano das balas
+#define PISTOL_COOLDOWN 0.25
+#define PISTOL_BULLET_SPEED 12.0f
+#define PISTOL_RANGE 8.0f
+#define PISTOL_DAMAGE 0.5f
+
+// Tamanho da bala em relação ao bumerange (a bala é desenhada com a malha do bumerange)
+#define PISTOL_BULLET_SCALE 0.4f
+
+// Acertos de projéteis guardados por zumbi em cada passo (os mais cedo no passo, se houver mais)
+#define ENEMY_MAX_HITS 4
+
+// Acerto de um projétil em um zumbi, resolvido após a fase paralela da horda
+struct ProjectileHit {
+    float timeOfImpact; // Fração do deslocamento do projétil no passo
+    uint32_t enemy;
+    uint16_t projectile;
+};
+
+// Estrutura para dados de inimigo individuais
+struct enemyData {
+    glm::vec3 position;
+    glm::vec3 direction;
+    float rotation;
+    glm::vec3 bbox_min;
+    glm::vec3 bbox_max;
+    float speed;
+    float animationPhase; // Fase do ciclo de caminhada, em [0, 1)
+    float health;         // Vida: o zumbi morre quando chega a zero
+    uint32_t id;          // Identificador único na partida, atribuído pela simulação (acertos dos projéteis perfurantes)
+
+    enemyData() {
+        this->position = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->direction = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->rotation = 0.0f;
+        this->bbox_min = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->bbox_max = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->speed = 0.0f;
+        this->animationPhase = 0.0f;
+        this->health = 1.0f;
+        this->id = 0;
+    }
+
+};
+
+// Corpo simulado (robô ou bumerange): posição, orientação e bounding box no plano XZ
+struct SimulationBody {
+    glm::vec3 position;
+    glm::vec3 originalPosition; // Posição de partida do ataque (bumerange)
+    glm::vec3 direction;
+    float rotation;
+
+    // "Raios" e Axis-Aligned Bounding Box do corpo
+    float x_difference;
+    float z_difference;
+    glm::vec3 bbox_min;
+    glm::vec3 bbox_max;
+
+    SimulationBody() {
+        this->position = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->originalPosition = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->direction = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->rotation = 0.0f;
+        this->x_difference = 0.0f;
+        this->z_difference = 0.0f;
+        this->bbox_min = glm::vec3(0.0f, 0.0f, 0.0f);
+        this->bbox_max = glm::vec3(0.0f, 0.0f, 0.0f);
+    }
+
+    // Atualiza a bounding box a partir da posição atual e dos "raios"
+    void updateBbox() {
+        this->bbox_max = glm::vec3(this->position.x + this->x_difference, this->position.y, this->position.z + this->z_difference);
+        this->bbox_min = glm::vec3(this->position.x - this->x_difference, this->position.y, this->position.z - this->z_difference);
+    }
+};
+
+// Entrada de um passo de simulação, independente da janela e do dispositivo
+struct SimulationInput {
+    float deltaTime;
+    bool paused;
+
+    // Tempo (em segundos) em que cada tecla de movimento ficou pressionada no passo
+    float heldW, heldA, heldS, heldD;
+
+    // Ataques pedidos no passo (botão pressionado ou clicado dentro do passo)
+    bool attackPrimary;
+    bool attackSecondary;
+    bool attackPistol;
+
+    // Vetor "view" da câmera: define a frente do robô e o sentido do movimento
+    glm::vec3 viewDirection;
+
+    SimulationInput() {
+        this->deltaTime = 0.0f;
+        this->paused = false;
+        this->heldW = 0.0f;
+        this->heldA = 0.0f;
+        this->heldS = 0.0f;
+        this->heldD = 0.0f;
+        this->attackPrimary = false;
+        this->attackSecondary = false;
+        this->attackPistol = false;
+        this->viewDirection = glm::vec3(0.0f, 0.0f, 1.0f);
+    }
+};
+
+// Máximo de obstáculos estáticos da arena (a configuração é gravada como está nas gravações de partidas)
+#define MAX_OBSTACLES 8
+
+// Dimensões e posições iniciais da partida, obtidas das malhas pelo renderizador ou pelas ferramentas
+struct SimulationConfig {
+    glm::vec3 sceneryBboxMin;  // Caixa de colisão do cenário (robô e bumerange não saem dela)
+    glm::vec3 sceneryBboxMax;
+    glm::vec3 arenaMin;        // Região coberta pelo campo de direções e pela grade de separação
+    glm::vec3 arenaMax;
+
+    glm::vec3 robotStart;
+    glm::vec3 robotDirection;  // Frente original do robô, referência da sua rotação
+    glm::vec2 robotHalfSize;   // "Raios" x e z da bounding box
+    glm::vec2 zombieHalfSize;
+    glm::vec3 boomerangStart;
+    glm::vec2 boomerangHalfSize;
+
+    // Obstáculos estáticos (caixas no espaço do mundo): bloqueiam o robô e os zumbis, que os contornam pelo
+    // campo de direções. São baixos, de forma que os projéteis passam por cima
+    glm::vec3 obstacleMin[MAX_OBSTACLES];
+    glm::vec3 obstacleMax[MAX_OBSTACLES];
+    int obstacleCount;
+
+    float animationRate;       // Ciclos de caminhada por unidade de distância
+    uint32_t seed;             // Semente do gerador pseudoaleatório da partida
+
+    // Valores padrão: malhas de data/objects com as escalas usadas em Window::run()
+    SimulationConfig() {
+        this->sceneryBboxMin = glm::vec3(-7.6094f, 0.0f, -7.5738f);
+        this->sceneryBboxMax = glm::vec3(7.6094f, 0.0f, 7.5738f);
+        this->arenaMin = glm::vec3(-7.5667f, 0.0f, -7.5803f);
+        this->arenaMax = glm::vec3(7.6521f, 4.9449f, 7.5673f);
+        this->robotStart = glm::vec3(0.4f, 0.0f, 0.0f);
+        this->robotDirection = glm::vec3(0.0f, 0.0f, 1.0f);
+        this->robotHalfSize = glm::vec2(0.2798f, 0.0722f);
+        this->zombieHalfSize = glm::vec2(0.1585f, 0.2591f);
+        this->boomerangStart = glm::vec3(0.0f, 0.7f, 0.0f);
+        this->boomerangHalfSize = glm::vec2(0.0528f, 0.0035f);
+
+        // Quatro muretas entre os pontos de criação dos zumbis e o centro da arena
+        this->obstacleCount = 4;
+        this->obstacleMin[0] = glm::vec3(-1.5f, 0.0f, -3.65f);
+        this->obstacleMax[0] = glm::vec3(1.5f, 0.5f, -3.35f);
+        this->obstacleMin[1] = glm::vec3(-1.5f, 0.0f, 3.35f);
+        this->obstacleMax[1] = glm::vec3(1.5f, 0.5f, 3.65f);
+        this->obstacleMin[2] = glm::vec3(-3.65f, 0.0f, -1.5f);
+        this->obstacleMax[2] = glm::vec3(-3.35f, 0.5f, 1.5f);
+        this->obstacleMin[3] = glm::vec3(3.35f, 0.0f, -1.5f);
+        this->obstacleMax[3] = glm::vec3(3.65f, 0.5f, 1.5f);
+        for (int i = this->obstacleCount; i < MAX_OBSTACLES; i++) {
+            this->obstacleMin[i] = glm::vec3(0.0f, 0.0f, 0.0f);
+            this->obstacleMax[i] = glm::vec3(0.0f, 0.0f, 0.0f);
+        }
+
+        this->animationRate = 1.0f;
+        this->seed = 1u;
+    }
+};
+
+// Regras do jogo sem nenhuma dependência de OpenGL ou GLFW: robô, projéteis, horda, fases e colisões.
+// Avança um passo por chamada de step(), a partir apenas da entrada do passo; o renderizador só lê o estado.
+class Simulation {
+    private:
+        SimulationConfig config;
+        JobSystem* jobs; // Opcional - sem ele, a horda é simulada na thread atual
+
+        // Corpo do robô
+        SimulationBody robot;
+        bool robotBlocked;
+
+        // Bumeranges e balas em voo, e instante a partir do qual a pistola pode atirar de novo
+        ProjectileSystem projectiles;
+        double pistolReady;
+
+        // Horda e fases
+        std::vector<enemyData> enemies;
+        int phase;
+        int enemiesKilled;
+        int enemiesSpawned;
+        bool cpuHorde;
+
+        // Relógio da simulação e instante da última criação de zumbis
+        double time;
+        double spawnTime;
+        uint64_t tick;
+
+        // Gerador pseudoaleatório (xorshift32), reiniciado com a semente da configuração em reset()
+        uint32_t random;
+        float nextRandom(); // Valor em [0, 1)
+
+        // Navegação e separação dos zumbis
+        FlowField flowField;
+        uint64_t flowFieldUpdates;
+        CrowdGrid crowd;
+        std::vector<uint8_t> killed;
+        std::vector<float> damage;                // Dano recebido por cada zumbi no passo
+        std::vector<ProjectileHit> enemyHits;     // ENEMY_MAX_HITS acertos por zumbi, escritos só pela iteração do zumbi
+        std::vector<uint8_t> enemyHitCounts;
+        std::vector<ProjectileHit> projectileHits; // Acertos de todos os zumbis, juntados e ordenados na fase 2
+        uint32_t nextEnemyId;
+
+        void UpdateGameStatus();
+        void GenerateZombies(bool isPaused);
+        void UpdatePlayer(const SimulationInput &input);
+        bool UpdateHorde(bool isPaused, float delta_t); // Retorna falso se o robô foi atingido
+        void FireWeapons(const SimulationInput &input);
+
+        // Executa function(begin, end) sobre [0, count), dividido entre as threads se houver um sistema de tarefas
+        template <typename Function>
+        void forEachEnemy(size_t count, const Function &function) {
+            if (this->jobs != nullptr) {
+                this->jobs->parallelFor(count, JOB_DEFAULT_GRAIN, function);
+            }
+            else if (count > 0) {
+                function((size_t) 0, count);
+            }
+        }
+
+    public:
+        Simulation();
+
+        // Prepara as grades e começa uma partida
+        void initialize(const SimulationConfig &config, JobSystem* jobs = nullptr);
+
+        // Recomeça a partida do início, mantendo a configuração
+        void reset();
+
+        // Avança um passo; retorna falso se o robô foi atingido por um zumbi
+        bool step(const SimulationInput &input);
+
+        // Liga ou desliga a simulação da horda na CPU (desligada quando ela é simulada na GPU: os zumbis
+        // criados continuam em getEnemies() e devem ser retirados pelo chamador)
+        void setCpuHorde(bool enabled);
+
+        // Mortes detectadas fora da simulação (horda na GPU)
+        void addKills(int kills);
+
+        // Hash (FNV-1a) do estado da partida, para detectar divergências entre uma gravação e a sua reprodução
+        [[nodiscard]] uint64_t hashState() const;
+
+        // Estado para o desenho
+        [[nodiscard]] const SimulationBody &getRobot() const;
+        [[nodiscard]] bool isRobotBlocked() const;        // O último movimento do robô colidiu com o cenário
+        [[nodiscard]] bool isBoomerangActive() const;     // Algum bumerange em voo
+        [[nodiscard]] const ProjectileSystem &getProjectiles() const;
+        [[nodiscard]] const std::vector<enemyData> &getEnemies() const;
+        std::vector<enemyData> &getEnemies();
+        [[nodiscard]] int getPhase() const;
+        [[nodiscard]] int getEnemiesKilled() const;
+        [[nodiscard]] double getTime() const;
+        [[nodiscard]] uint64_t getTick() const;
+        [[nodiscard]] const SimulationConfig &getConfig() const;
+        [[nodiscard]] const FlowField &getFlowField() const;
+        [[nodiscard]] uint64_t getFlowFieldUpdates() const; // Recálculos do campo de direções desde o início da partida
+};
+
+
+#endif //FCG_TRAB_FINAL_SIMULATION_H
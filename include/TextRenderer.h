@@ -0,0 +1,69 @@
+#ifndef FCG_TRAB_FINAL_TEXTRENDERER_H
+#define FCG_TRAB_FINAL_TEXTRENDERER_H
+
+// Headers de C++
+#include <vector>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+#include "glm/vec4.hpp"
+
+// Número máximo de quadriláteros por quadro (texto + retângulos sólidos)
+#define TEXT_MAX_QUADS 4096
+
+// Vértice do HUD em coordenadas de tela (pixels, origem no canto superior esquerdo)
+struct HudVertex {
+    float x, y;
+    float s, t;
+    float r, g, b, a;
+};
+
+// Renderizador de texto em lote utilizando o atlas de glifos DejaVu (dejavufont.h).
+// Todas as strings e retângulos do quadro são acumulados e desenhados com uma única chamada.
+class TextRenderer {
+    private:
+        GLuint programId;
+        GLuint vertexArrayObjectId;
+        GLuint vertexBufferId;
+        GLuint textureId;
+        GLuint textureUnit;
+        GLint screenSizeUniform;
+
+        // Vértices acumulados no quadro atual
+        std::vector<HudVertex> vertices;
+
+        // Coordenadas de um texel branco do atlas, usado para retângulos sólidos
+        float whiteS, whiteT;
+
+        int screenWidth;
+        int screenHeight;
+
+        void addQuad(float x0, float y0, float x1, float y1, float s0, float t0, float s1, float t1, glm::vec4 color);
+
+    public:
+        TextRenderer();
+
+        // Envia o atlas para a GPU uma única vez e cria o buffer dinâmico de quadriláteros
+        void initialize(GLuint programId, GLuint textureUnit);
+
+        // Libera o atlas e os buffers (precisa do contexto ainda ativo)
+        void release();
+
+        // Inicia um novo lote
+        void begin(int screenWidth, int screenHeight);
+
+        // Adiciona uma string com a linha de base em (x, y); retorna a largura em pixels
+        float addText(const char* text, float x, float y, glm::vec4 color, float scale = 1.0f);
+
+        // Adiciona um retângulo sólido
+        void addRect(float x, float y, float width, float height, glm::vec4 color);
+
+        // Desenha todo o lote com uma única chamada; retorna o número de triângulos
+        size_t flush();
+
+        // Altura de uma linha de texto em pixels
+        [[nodiscard]] float lineHeight(float scale = 1.0f) const;
+};
+
+
+#endif //FCG_TRAB_FINAL_TEXTRENDERER_H
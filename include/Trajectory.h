@@ -0,0 +1,60 @@
+#ifndef FCG_TRAB_FINAL_TRAJECTORY_H
+#define FCG_TRAB_FINAL_TRAJECTORY_H
+
+// Headers de C++
+#include <cstddef>
+
+#include "glm/vec3.hpp"
+
+// Número máximo de segmentos cúbicos de uma trajetória (um caminho de Catmull-Rom com N pontos tem N - 1 segmentos)
+#define TRAJECTORY_MAX_SEGMENTS 6
+
+// Amostras da tabela de comprimento de arco por segmento
+#define TRAJECTORY_SAMPLES_PER_SEGMENT 32
+
+// Trajetória parametrizada pelo comprimento de arco, formada por segmentos de Bézier cúbicos.
+// Os pontos de controle são calculados uma única vez, ao montar a curva (Bézier de grau 2 ou 3, ou caminho de
+// Catmull-Rom convertido para Bézier), junto com uma tabela do comprimento acumulado em amostras uniformes do
+// parâmetro. evaluate() converte uma distância percorrida no parâmetro por busca binária e interpolação linear
+// na tabela, refinada por um passo de Newton, de forma que um projétil que avança a distância "velocidade * delta_t" tem velocidade constante
+// ao longo de toda a curva.
+class Trajectory {
+    private:
+        glm::vec3 points[3 * TRAJECTORY_MAX_SEGMENTS + 1]; // Pontos de controle; o último ponto de um segmento é o primeiro do seguinte
+        float lengths[TRAJECTORY_MAX_SEGMENTS * TRAJECTORY_SAMPLES_PER_SEGMENT + 1]; // Comprimento acumulado em cada amostra
+        int segmentCount;
+
+        void buildTable();
+        [[nodiscard]] glm::vec3 evaluateParameter(float u) const; // u em [0, segmentCount]
+        [[nodiscard]] glm::vec3 derivativeParameter(float u) const;
+
+    public:
+        Trajectory();
+
+        // Curva vazia: evaluate() retorna a origem
+        void clear();
+
+        // Bézier de grau 2, elevada para grau 3 sem alterar a curva
+        void setQuadraticBezier(glm::vec3 p0, glm::vec3 p1, glm::vec3 p2);
+
+        // Bézier de grau 3
+        void setCubicBezier(glm::vec3 p0, glm::vec3 p1, glm::vec3 p2, glm::vec3 p3);
+
+        // Caminho de Catmull-Rom uniforme que passa por todos os pontos, com as pontas estendidas por reflexão.
+        // Retorna falso se houver menos de 2 ou mais de TRAJECTORY_MAX_SEGMENTS + 1 pontos
+        bool setCatmullRom(const glm::vec3* path, size_t count);
+
+        // Posição após percorrer "distance" unidades sobre a curva, limitada às pontas
+        [[nodiscard]] glm::vec3 evaluate(float distance) const;
+
+        // Parâmetro global (em [0, número de segmentos]) após percorrer "distance" unidades
+        [[nodiscard]] float parameterAt(float distance) const;
+
+        [[nodiscard]] float getLength() const;
+        [[nodiscard]] int getSegmentCount() const;
+        [[nodiscard]] glm::vec3 getStart() const;
+        [[nodiscard]] glm::vec3 getEnd() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_TRAJECTORY_H
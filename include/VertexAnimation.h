@@ -0,0 +1,58 @@
+#ifndef FCG_TRAB_FINAL_VERTEXANIMATION_H
+#define FCG_TRAB_FINAL_VERTEXANIMATION_H
+
+// Headers de C++
+#include <cstddef>
+#include <cstdint>
+
+// Headers de OpenGL
+#include <glad/glad.h>
+
+// Identificador do formato ("VAT1" em little-endian)
+#define VAT_MAGIC 0x31544156u
+
+// Largura das texturas da animação - as linhas seguintes continuam o mesmo vetor de texels
+#define VAT_TEXTURE_WIDTH 4096
+
+// Cabeçalho de um arquivo .vat (vertex animation texture), gerado pela ferramenta vat_bake.
+// É seguido por:
+// - remap[vertexCount]: uint32, posição do OBJ usada por cada vértice da malha (um vértice por canto de triângulo, como em Mesh);
+// - offsets[frameCount][positionCount]: 4 half floats, deslocamento (xyz) de cada posição do OBJ no quadro, w = 0.
+struct VatHeader {
+    uint32_t magic;
+    uint32_t vertexCount;
+    uint32_t positionCount;
+    uint32_t frameCount;
+    uint32_t width;
+    float cycleRate; // Ciclos da animação por unidade de distância percorrida (em coordenadas do mundo)
+};
+
+// Animação por textura de vértices: os quadros amostrados offline ficam em uma textura RGBA16F,
+// lida em "shader_vertex.glsl" com a fase de cada instância. O custo de CPU não depende do número de zumbis animados.
+class VertexAnimation {
+    private:
+        VatHeader header;
+        GLuint remapTextureId;
+        GLuint offsetTextureId;
+        size_t gpuBytes;
+
+    public:
+        VertexAnimation();
+
+        // A animação é dona de objetos de OpenGL: não pode ser copiada
+        VertexAnimation(const VertexAnimation&) = delete;
+        VertexAnimation& operator=(const VertexAnimation&) = delete;
+
+        // Lê o arquivo e cria as texturas nas unidades indicadas; retorna falso (animação desligada) em caso de erro
+        bool load(const char* filename, GLuint expectedVertexCount, GLuint remapUnit, GLuint offsetUnit);
+
+        // Libera os objetos de OpenGL
+        void release();
+
+        [[nodiscard]] bool isLoaded() const;
+        [[nodiscard]] const VatHeader &getHeader() const;
+        [[nodiscard]] size_t getGpuBytes() const;
+};
+
+
+#endif //FCG_TRAB_FINAL_VERTEXANIMATION_H
@@ -3,6 +3,7 @@
 
 #include "Camera.h"
 #include "Renderer.h"
+#include "InputQueue.h"
 
 /* Headers das bibliotecas de OpenGL */
 #include <glad/glad.h>   // Criação de contexto OpenGL 3.3
@@ -17,6 +18,9 @@ class Window {
         Camera camera;
         Renderer renderer;
 
+        // Fila de eventos de entrada consumida pela simulação
+        InputQueue input;
+
         /* Posições relacionadas ao cursor */
         double lastCursorPosX;
         double lastCursorPosY;
@@ -24,6 +28,10 @@ class Window {
         // Variável relacionada a pausa
         bool isPaused_;
 
+        // Arquivos de gravação e de reprodução da entrada (opcionais)
+        const char* recordFilename;
+        const char* replayFilename;
+
         /* Funções callback para comunicação com o sistema operacional e interação com o usuário */
         void FramebufferSizeCallback(int width, int height);
         static void ErrorCallback(int error, const char* description);
@@ -33,7 +41,7 @@ class Window {
         void ScrollCallback(double xoffset, double yoffset);
 
     public:
-        Window();
+        Window(const char* recordFilename = nullptr, const char* replayFilename = nullptr);
 
         // Função de execução
         void run();
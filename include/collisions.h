@@ -2,17 +2,30 @@
 #define FCG_TRAB_FINAL_COLLISIONS_H
 
 
-#include "Model.h"
+#include "glm/vec3.hpp"
 
+// Os testes não atualizam o contador COUNTER_PAIR_TESTS: quem os chama soma os seus testes localmente e os
+// adiciona de uma vez (nos laços paralelos, uma vez por bloco de trabalho)
 class collisions {
 
     public:
         // Colisão entre objetos e o cenário
         static bool CubeToBox(glm::vec3 cubeBbox_min, glm::vec3 cubeBbox_max, glm::vec3 boxBbox_min, glm::vec3 boxBbox_max);
+        // Colisão entre objetos e os obstáculos da arena (caixas que se sobrepõem no plano XZ)
+        static bool CubeToCube(glm::vec3 cube1Bbox_min, glm::vec3 cube1Bbox_max, glm::vec3 cube2Bbox_min, glm::vec3 cube2Bbox_max);
         // Colisão entre robô e zumbis
         static bool CylinderToCylinder(glm::vec3 cylinder1Bbox_min, glm::vec3 cylinder1Bbox_max, glm::vec3 cylinder2Bbox_min, glm::vec3 cylinder2Bbox_max);
         // Colisão entre bumerange e zumbis
         static bool CubeToCylinder(glm::vec3 cylinderBbox_min, glm::vec3 cylinderBbox_max, glm::vec3 cubeBbox_min, glm::vec3 cubeBbox_max);
+
+        // Testes contínuos, no plano XZ como os demais: o movimento do passo é testado inteiro, de forma que
+        // objetos rápidos não atravessam outros entre dois passos. O instante de impacto é uma fração do passo, em [0, 1]
+
+        // Raio "origin + t * direction" contra uma caixa: intervalo [tEnter, tExit] em que o raio está dentro dela
+        static bool RayToBox(glm::vec3 origin, glm::vec3 direction, glm::vec3 boxBbox_min, glm::vec3 boxBbox_max, float &tEnter, float &tExit);
+        // Bumerange que se desloca por "displacement" contra um zumbi parado: instante do primeiro contato
+        static bool SweptCubeToCylinder(glm::vec3 cylinderBbox_min, glm::vec3 cylinderBbox_max, glm::vec3 cubeBbox_min, glm::vec3 cubeBbox_max,
+                                        glm::vec3 displacement, float &timeOfImpact);
 };
 
 
@@ -7,6 +7,7 @@
 #include <glm/glm/mat4x4.hpp>
 #include <glm/glm/vec4.hpp>
 #include <glm/glm/gtc/matrix_transform.hpp>
+#include <glm/glm/gtc/quaternion.hpp>
 
 // Esta função Matrix() auxilia na criação de matrizes usando a biblioteca GLM.
 // Note que em OpenGL (e GLM) as matrizes são definidas como "column-major",
@@ -83,6 +84,22 @@ glm::mat4 Matrix_Rotate_Y(float angle);
 // onde 'c' e 's' são o cosseno e o seno do ângulo de rotação, respectivamente.
 glm::mat4 Matrix_Rotate_Z(float angle);
 
+// Matriz de modelo M = T*S*R_y (translação t, escala s e rotação "yaw" em torno
+// do eixo Y), igual a Matrix_Translate(t)*Matrix_Scale(s)*Matrix_Rotate_Y(yaw),
+// mas montada diretamente, sem produtos de matrizes.
+glm::mat4 Matrix_TRS_Y(glm::vec3 t, glm::vec3 s, float yaw);
+glm::mat4 Matrix_TRS_Y(glm::vec3 t, float s, float yaw);
+
+// Matriz de modelo M = T*S*R, com a rotação R dada por um quatérnio unitário.
+glm::mat4 Matrix_TRS(glm::vec3 t, glm::vec3 s, glm::quat q);
+glm::mat4 Matrix_TRS(glm::vec3 t, float s, glm::quat q);
+
+// Versões em lote, gravando diretamente no buffer de instâncias "out": a
+// posição de cada instância vem em positionYaw[i].xyz e o ângulo em
+// positionYaw[i].w (formato de HordeInstance).
+void Matrix_TRS_Y_Batch(const glm::vec4* positionYaw, size_t count, glm::vec3 s, glm::mat4* out);
+void Matrix_TRS_Batch(const glm::vec3* t, const glm::quat* q, size_t count, glm::vec3 s, glm::mat4* out);
+
 // Função que calcula a norma Euclidiana de um vetor cujos coeficientes são
 // definidos em uma base ortonormal qualquer.
 float norm(glm::vec4 v);
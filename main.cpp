@@ -1,7 +1,21 @@
 #include "..\include\Window.h"
 
-int main(){
-    Window window;
+#include <cstring>
+
+// Uso: fcg_trab_final [--record arquivo.rec | --replay arquivo.rec]
+int main(int argc, char* argv[]){
+    const char* recordFilename = nullptr;
+    const char* replayFilename = nullptr;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0) {
+            recordFilename = argv[++i];
+        }
+        else if (strcmp(argv[i], "--replay") == 0) {
+            replayFilename = argv[++i];
+        }
+    }
+
+    Window window(recordFilename, replayFilename);
     window.run();
     return 0;
 }
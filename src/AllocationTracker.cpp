@@ -0,0 +1,289 @@
+#include "AllocationTracker.h"
+
+// Headers de C++
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+// Capacidade da tabela de pontos de alocação (potência de 2)
+#define ALLOCATION_CALLSITE_CAPACITY 1024
+
+// Contadores de cada thread, em memória estática para continuarem válidos depois que a thread termina
+static AllocationCounters threadSlots[ALLOCATION_MAX_THREADS];
+static std::atomic<int> usedThreadSlots(0);
+
+// Estado da verificação por quadro (somente na thread principal)
+static uint64_t frameStartAllocations = 0;
+static uint64_t frameStartMainAllocations = 0;
+static uint64_t steadyFrames = 0;
+static uint64_t steadyFramesWithAllocations = 0;
+static uint64_t steadyAllocations = 0;
+
+#ifdef ALLOCATION_CALLSITES
+// Tabela de endereçamento aberto, preenchida sem travas
+struct AllocationCallsite {
+    std::atomic<void*> address;
+    std::atomic<uint64_t> count;
+};
+static AllocationCallsite callsites[ALLOCATION_CALLSITE_CAPACITY];
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define ALLOCATION_RETURN_ADDRESS() _ReturnAddress()
+#else
+    #define ALLOCATION_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+#else
+    #define ALLOCATION_RETURN_ADDRESS() nullptr
+#endif
+
+// Contadores da thread atual - o conjunto é reservado no primeiro uso; o ponteiro thread_local é POD,
+// portanto não aloca na criação
+AllocationCounters &AllocationTracker::threadCounters() {
+    thread_local AllocationCounters* counters = nullptr;
+    if (counters == nullptr) {
+        int slot = usedThreadSlots.fetch_add(1, std::memory_order_relaxed);
+        counters = &threadSlots[slot < ALLOCATION_MAX_THREADS ? slot : ALLOCATION_MAX_THREADS - 1];
+    }
+    return *counters;
+}
+
+// Soma dos contadores de todas as threads que já alocaram
+uint64_t AllocationTracker::totalAllocations() {
+    int slots = usedThreadSlots.load(std::memory_order_relaxed);
+    if (slots > ALLOCATION_MAX_THREADS) {
+        slots = ALLOCATION_MAX_THREADS;
+    }
+
+    uint64_t total = 0;
+    for (int slot = 0; slot < slots; slot++) {
+        total += threadSlots[slot].allocations.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// Registra uma alocação
+void AllocationTracker::recordAllocation(std::size_t size, void* callsite) {
+    AllocationCounters &counters = threadCounters();
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+
+#ifdef ALLOCATION_CALLSITES
+    if (callsite != nullptr) {
+        size_t slot = ((uintptr_t) callsite >> 4) & (ALLOCATION_CALLSITE_CAPACITY - 1);
+        for (size_t probe = 0; probe < ALLOCATION_CALLSITE_CAPACITY; probe++) {
+            AllocationCallsite &entry = callsites[(slot + probe) & (ALLOCATION_CALLSITE_CAPACITY - 1)];
+            void* expected = nullptr;
+            if (entry.address.load(std::memory_order_relaxed) == callsite
+                || entry.address.compare_exchange_strong(expected, callsite)
+                || expected == callsite) {
+                entry.count.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+#else
+    (void) callsite;
+#endif
+}
+
+void AllocationTracker::recordFree() {
+    threadCounters().frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Guarda o número de alocações no início do quadro
+void AllocationTracker::beginFrame() {
+    frameStartAllocations = totalAllocations();
+    frameStartMainAllocations = threadCounters().allocations.load(std::memory_order_relaxed);
+}
+
+// Retorna quantas alocações ocorreram no quadro, somando as threads do sistema de tarefas. Em builds de debug,
+// quadros em regime (após o aquecimento) que alocam interrompem a execução.
+uint64_t AllocationTracker::endFrame(bool steadyState) {
+    uint64_t allocations = totalAllocations() - frameStartAllocations;
+
+    if (steadyState) {
+        steadyFrames++;
+        steadyAllocations += allocations;
+        if (allocations > 0) {
+            uint64_t mainAllocations = threadCounters().allocations.load(std::memory_order_relaxed) - frameStartMainAllocations;
+            steadyFramesWithAllocations++;
+            fprintf(stderr, "ERROR: %llu alocacoes em um quadro em regime (%llu em outras threads).\n",
+                    (unsigned long long) allocations, (unsigned long long) (allocations - mainAllocations));
+        }
+        assert(allocations == 0 && "Quadros em regime nao devem alocar memoria");
+    }
+
+    return allocations;
+}
+
+// Imprime o resumo da sessão
+void AllocationTracker::printSummary() {
+    AllocationCounters &counters = threadCounters();
+    printf("Alocacoes: %llu no total (%llu bytes, %llu liberacoes na thread principal)\n",
+           (unsigned long long) totalAllocations(), (unsigned long long) counters.bytes.load(std::memory_order_relaxed),
+           (unsigned long long) counters.frees.load(std::memory_order_relaxed));
+    printf("Quadros em regime: %llu, com alocacao: %llu, alocacoes: %llu\n",
+           (unsigned long long) steadyFrames, (unsigned long long) steadyFramesWithAllocations, (unsigned long long) steadyAllocations);
+
+#ifdef ALLOCATION_CALLSITES
+    // Os dez pontos com mais alocações (endereços podem ser resolvidos com addr2line)
+    bool printed[ALLOCATION_CALLSITE_CAPACITY] = {false};
+    for (int rank = 0; rank < 10; rank++) {
+        int best = -1;
+        for (int i = 0; i < ALLOCATION_CALLSITE_CAPACITY; i++) {
+            if (!printed[i] && callsites[i].address.load() != nullptr
+                && (best < 0 || callsites[i].count.load() > callsites[best].count.load())) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        printed[best] = true;
+        printf("- %p: %llu alocacoes\n", callsites[best].address.load(), (unsigned long long) callsites[best].count.load());
+    }
+#endif
+}
+
+// Operadores globais de alocação - encaminham para malloc/free, registrando cada chamada
+
+void* operator new(std::size_t size) {
+    AllocationTracker::recordAllocation(size, ALLOCATION_RETURN_ADDRESS());
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    AllocationTracker::recordAllocation(size, ALLOCATION_RETURN_ADDRESS());
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    AllocationTracker::recordAllocation(size, ALLOCATION_RETURN_ADDRESS());
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    AllocationTracker::recordAllocation(size, ALLOCATION_RETURN_ADDRESS());
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer != nullptr) {
+        AllocationTracker::recordFree();
+    }
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    if (pointer != nullptr) {
+        AllocationTracker::recordFree();
+    }
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    operator delete[](pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    operator delete[](pointer);
+}
+
+// Formas alinhadas (alinhamento acima de __STDCPP_DEFAULT_NEW_ALIGNMENT__), também registradas
+
+// aligned_alloc exige um tamanho múltiplo do alinhamento; no Windows, a memória alinhada tem função própria
+static void* AlignedAllocate(std::size_t size, std::align_val_t alignment) {
+    std::size_t bytes = (std::size_t) alignment;
+    std::size_t rounded = (size + bytes - 1) / bytes * bytes;
+#ifdef _WIN32
+    return _aligned_malloc(rounded == 0 ? bytes : rounded, bytes);
+#else
+    return std::aligned_alloc(bytes, rounded == 0 ? bytes : rounded);
+#endif
+}
+
+static void AlignedFree(void* pointer) {
+    if (pointer != nullptr) {
+        AllocationTracker::recordFree();
+    }
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    AllocationTracker::recordAllocation(size, ALLOCATION_RETURN_ADDRESS());
+    void* pointer = AlignedAllocate(size, alignment);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    AllocationTracker::recordAllocation(size, ALLOCATION_RETURN_ADDRESS());
+    void* pointer = AlignedAllocate(size, alignment);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    AllocationTracker::recordAllocation(size, ALLOCATION_RETURN_ADDRESS());
+    return AlignedAllocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    AllocationTracker::recordAllocation(size, ALLOCATION_RETURN_ADDRESS());
+    return AlignedAllocate(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    AlignedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    AlignedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    AlignedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    AlignedFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    AlignedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    AlignedFree(pointer);
+}
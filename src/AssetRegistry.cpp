@@ -0,0 +1,142 @@
+#include "AssetRegistry.h"
+
+#include <cstdio>
+#include <filesystem>
+
+#include "GLState.h"
+
+// Chave de um recurso: caminho canônico seguido das opções de importação
+std::string AssetRegistry::makeKey(const char* path, const char* options) {
+    // "weakly_canonical" resolve "..", "." e links simbólicos mesmo que o arquivo não exista
+    std::error_code error;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+
+    std::string key = error ? std::string(path) : canonical.generic_string();
+    if (options != nullptr && options[0] != '\0') {
+        key += "?";
+        key += options;
+    }
+    return key;
+}
+
+// Busca um recurso já carregado
+Asset* AssetRegistry::acquire(const std::string &key) {
+    auto found = this->assets.find(key);
+    if (found == this->assets.end()) {
+        return nullptr;
+    }
+
+    found->second.refCount += 1;
+    return &found->second;
+}
+
+// Adiciona um recurso recém carregado
+Asset* AssetRegistry::add(const std::string &key, AssetType type) {
+    Asset &asset = this->assets[key];
+    asset.type = type;
+    asset.key = key;
+    asset.refCount = 1;
+    asset.textureId = 0;
+    asset.samplerId = 0;
+    asset.programId = 0;
+    asset.cpuBytes = 0;
+    asset.gpuBytes = 0;
+    return &asset;
+}
+
+// Devolve uma referência
+void AssetRegistry::release(Asset* asset) {
+    if (asset == nullptr) {
+        return;
+    }
+
+    asset->refCount -= 1;
+    if (asset->refCount > 0) {
+        return;
+    }
+
+    std::string key = asset->key;
+    freeAsset(*asset);
+    this->assets.erase(key);
+}
+
+// Libera os objetos de OpenGL de um recurso
+void AssetRegistry::freeAsset(Asset &asset) {
+    switch (asset.type) {
+        case ASSET_MESH:
+            if (asset.mesh) {
+                asset.mesh->release();
+                asset.mesh.reset();
+            }
+            break;
+        case ASSET_TEXTURE:
+            glDeleteTextures(1, &asset.textureId);
+            glDeleteSamplers(1, &asset.samplerId);
+            break;
+        case ASSET_PROGRAM:
+            glDeleteProgram(asset.programId);
+            break;
+    }
+
+    asset.textureId = 0;
+    asset.samplerId = 0;
+    asset.programId = 0;
+    asset.cpuBytes = 0;
+    asset.gpuBytes = 0;
+
+    // Os nomes liberados podem ser reutilizados por novos objetos
+    GLState::invalidate();
+}
+
+// Libera todos os recursos restantes
+void AssetRegistry::shutdown() {
+    for (auto &entry : this->assets) {
+        Asset &asset = entry.second;
+        if (asset.refCount > 0) {
+            fprintf(stderr, "WARNING: %s \"%s\" still has %d reference(s) at shutdown.\n",
+                    typeName(asset.type), asset.key.c_str(), asset.refCount);
+        }
+        freeAsset(asset);
+    }
+    this->assets.clear();
+}
+
+// Imprime a memória ocupada por cada recurso
+void AssetRegistry::printReport() const {
+    size_t totalCpu = 0;
+    size_t totalGpu = 0;
+
+    printf("Recursos carregados:\n");
+    printf("  %-8s %5s %12s %12s  %s\n", "type", "refs", "cpu_kb", "gpu_kb", "key");
+    for (const auto &entry : this->assets) {
+        const Asset &asset = entry.second;
+
+        // Malhas podem descartar a geometria da CPU depois do registro
+        size_t cpuBytes = asset.cpuBytes;
+        size_t gpuBytes = asset.gpuBytes;
+        if (asset.type == ASSET_MESH && asset.mesh) {
+            cpuBytes = asset.mesh->getCpuBytes();
+            gpuBytes = asset.mesh->getGpuBytes();
+        }
+
+        printf("  %-8s %5d %12.1f %12.1f  %s\n", typeName(asset.type), asset.refCount,
+               (double) cpuBytes / 1024.0, (double) gpuBytes / 1024.0, asset.key.c_str());
+        totalCpu += cpuBytes;
+        totalGpu += gpuBytes;
+    }
+    printf("  %-8s %5zu %12.1f %12.1f\n", "total", this->assets.size(), (double) totalCpu / 1024.0, (double) totalGpu / 1024.0);
+}
+
+size_t AssetRegistry::size() const {
+    return this->assets.size();
+}
+
+// Nome de cada tipo de recurso para o relatório
+const char* AssetRegistry::typeName(AssetType type) {
+    switch (type) {
+        case ASSET_MESH:    return "mesh";
+        case ASSET_TEXTURE: return "texture";
+        case ASSET_PROGRAM: return "program";
+        default:            return "unknown";
+    }
+}
@@ -1,5 +1,7 @@
 #include "Camera.h"
 
+#include "glm/mat3x3.hpp"
+
 // Vetor "up"
 glm::vec4 Camera::upVector = glm::vec4(0.0f,1.0f,0.0f,0.0f);
 
@@ -16,6 +18,11 @@ Camera::Camera() {
 
     this->nearPlane = -0.1f;
     this->farPlane = -100.0f;
+
+    this->matrices.aspectRatio = 0.0f;
+    this->viewVectorDirty = true;
+    this->viewDirty = true;
+    this->projectionDirty = true;
 }
 
 // Ponto "l", para onde a câmera (look-at) estará sempre olhando.
@@ -25,7 +32,10 @@ glm::vec4 Camera::getLookAt() {
 
 // Seta o ponto de Look-At
 void Camera::setLookAt(glm::vec4 vec) {
-    this->lookAt = vec;
+    if (vec != this->lookAt) {
+        this->lookAt = vec;
+        this->viewDirty = true;
+    }
 }
 
 // Vetor "view", sentido para onde a câmera está virada
@@ -33,8 +43,13 @@ glm::vec4 Camera::getViewVector() {
     return this->viewVector;
 }
 
-// Atualiza o View Vector em câmera Look-At
+// Atualiza o View Vector em câmera Look-At (depende somente da posição esférica)
 void Camera::updateViewVector() {
+    if (!this->viewVectorDirty) {
+        return;
+    }
+    this->viewVectorDirty = false;
+    this->viewDirty = true;
 
     // Calcula a posição cartesiana a partir da posição esférica
     glm::vec4 vec = lookAt;
@@ -67,6 +82,7 @@ void Camera::updateViewVector(float angleX, float angleY) {
         // Atualiza vetor view
         this->viewVector = normalize(this->viewVector
                                         * Matrix_Rotate(angleX, Camera::upVector));
+        this->viewDirty = true;
     }
 }
 
@@ -86,11 +102,15 @@ void Camera::updateSphericAngles(float dx, float dy) {
     // Atualiza as coordendas esféricas
     this->sphericPosition.phi = newPhi;
     this->sphericPosition.theta -= 0.003f * dx;
+    this->viewVectorDirty = true;
+    this->viewDirty = true;
 }
 
 // Atualiza as coordenadas esféricas em câmera livre
 void Camera::updateSphericAngles(float angle) {
     this->sphericPosition.theta -= angle;
+    this->viewVectorDirty = true;
+    this->viewDirty = true;
 }
 
 // Atualiza a nova distância em coordendas esféricas
@@ -105,58 +125,102 @@ void Camera::updateSphericDistance(float distance) {
         this->sphericPosition.distance = 0.5f;
         this->useFreeCamera = true;
     }
+    this->viewVectorDirty = true;
+    this->viewDirty = true;
 }
 
 // Atualiza as coordenadas cartesianas
 void Camera::updateCartesianCoordinates(glm::vec4 coords){
-    this->cartesianPosition = coords;
+    if (coords != this->cartesianPosition) {
+        this->cartesianPosition = coords;
+        this->viewDirty = true;
+    }
 }
 
-// Calcula matriz View
-glm::mat4 Camera::getView() {
-    // Para câmera livre
+// Posição da câmera: a própria posição na câmera livre, ou a posição esférica em torno do ponto "l" na Look-At
+glm::vec4 Camera::getEyePosition() const {
     if (this->useFreeCamera) {
-        return Matrix_Camera_View(this->cartesianPosition, this->viewVector, Camera::upVector);
+        return this->cartesianPosition;
     }
-    // Para câmera Look-At
-    else {
-        glm::vec4 pos;
-        pos.x = this->sphericPosition.distance * cos(this->sphericPosition.phi) * sin(this->sphericPosition.theta);
-        pos.y = this->sphericPosition.distance * sin(this->sphericPosition.phi);
-        pos.z = this->sphericPosition.distance * cos(this->sphericPosition.phi) * cos(this->sphericPosition.theta);
-        pos.w = 1.0f;
 
-        glm::vec4 position = lookAt + pos;
-        position.w = 1.0f;
+    glm::vec4 position = this->lookAt;
+    position.x += this->sphericPosition.distance * cos(this->sphericPosition.phi) * sin(this->sphericPosition.theta);
+    position.y += this->sphericPosition.distance * sin(this->sphericPosition.phi);
+    position.z += this->sphericPosition.distance * cos(this->sphericPosition.phi) * cos(this->sphericPosition.theta);
+    position.w = 1.0f;
+    return position;
+}
 
-        return Matrix_Camera_View(position, this->viewVector, Camera::upVector);
+// Recalcula as partes sujas das matrizes e devolve uma cópia
+CameraMatrices Camera::snapshot(float aspectRatio) {
+    if (!this->useFreeCamera) {
+        this->updateViewVector();
     }
-}
 
-// Calcula matriz Perspective
-glm::mat4 Camera::getPerspective(float aspectRatio) const {
-    return Matrix_Perspective(FOV, aspectRatio, this->nearPlane, this->farPlane);
-}
+    if (aspectRatio != this->matrices.aspectRatio) {
+        this->matrices.aspectRatio = aspectRatio;
+        this->projectionDirty = true;
+    }
 
-// Atualiza a câmera
-void Camera::updateCamera(float delta_t) {
+    if (this->viewDirty) {
+        this->matrices.position = this->getEyePosition();
+        this->matrices.view = Matrix_Camera_View(this->matrices.position, this->viewVector, Camera::upVector);
 
-    float cameraSpeed = 2.0f;
-    glm::vec4 w = -(normalize(this->getViewVector()));
-    glm::vec4 u = normalize(crossproduct(Camera::upVector, w));
-    if (this->keys.W){
-        this->cartesianPosition -= w * cameraSpeed * delta_t;
+        // A inversa de uma mudança de base ortonormal: rotação transposta e a posição da câmera como translação
+        this->matrices.inverseView = glm::mat4(glm::transpose(glm::mat3(this->matrices.view)));
+        this->matrices.inverseView[3] = this->matrices.position;
+    }
+    if (this->projectionDirty) {
+        this->matrices.projection = Matrix_Perspective(FOV, aspectRatio, this->nearPlane, this->farPlane);
     }
-    if (this->keys.S){
-        this->cartesianPosition += w * cameraSpeed * delta_t;
+    if (this->viewDirty || this->projectionDirty) {
+        this->matrices.viewProjection = this->matrices.projection * this->matrices.view;
+        extractFrustumPlanes(this->matrices.viewProjection, this->matrices.frustumPlanes);
+    }
+
+    this->viewDirty = false;
+    this->projectionDirty = false;
+    return this->matrices;
+}
+
+// Extrai os planos do frustum (método de Gribb e Hartmann)
+void Camera::extractFrustumPlanes(const glm::mat4 &viewProjection, glm::vec4 planes[6]) {
+    // Linhas da matriz (glm armazena as colunas)
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++) {
+        rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
     }
-    if (this->keys.A){
-        this->cartesianPosition -= u * cameraSpeed * delta_t;
+
+    planes[0] = rows[3] + rows[0]; // Esquerda
+    planes[1] = rows[3] - rows[0]; // Direita
+    planes[2] = rows[3] + rows[1]; // Baixo
+    planes[3] = rows[3] - rows[1]; // Cima
+    planes[4] = rows[3] + rows[2]; // Perto
+    planes[5] = rows[3] - rows[2]; // Longe
+
+    for (int i = 0; i < 6; i++) {
+        float length = sqrt(planes[i].x * planes[i].x + planes[i].y * planes[i].y + planes[i].z * planes[i].z);
+        planes[i] /= length;
     }
-    if (this->keys.D){
-        this->cartesianPosition += u * cameraSpeed * delta_t;
+}
+
+// Atualiza a câmera
+void Camera::updateCamera() {
+
+    // Sem teclas de movimento no passo, a posição não muda
+    if (this->keys.heldW != 0.0f || this->keys.heldS != 0.0f || this->keys.heldA != 0.0f || this->keys.heldD != 0.0f) {
+        // O vetor "view" já é unitário
+        float cameraSpeed = 2.0f;
+        glm::vec4 w = -this->viewVector;
+        glm::vec4 u = normalize(crossproduct(Camera::upVector, w));
+        glm::vec4 position = this->cartesianPosition;
+        position -= w * cameraSpeed * this->keys.heldW;
+        position += w * cameraSpeed * this->keys.heldS;
+        position -= u * cameraSpeed * this->keys.heldA;
+        position += u * cameraSpeed * this->keys.heldD;
+        position.y = 0.8f;
+        this->updateCartesianCoordinates(position);
     }
-    this->cartesianPosition.y = 0.8f;
 
     // Caso em Look-At, atualiza o view vector
     if (!this->useFreeCamera) {
@@ -172,4 +236,6 @@ bool Camera::isUseFreeCamera() const{
 
 void Camera::revertFreeCamera() {
     this->useFreeCamera = !this->useFreeCamera;
+    this->viewVectorDirty = true;
+    this->viewDirty = true;
 }
@@ -0,0 +1,191 @@
+#include "CrowdGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Construtor - a grade é criada em initialize()
+CrowdGrid::CrowdGrid() {
+    this->boundsMin = glm::vec3(0.0f, 0.0f, 0.0f);
+    this->cellSize = CROWD_SEPARATION_RADIUS;
+    this->columns = 0;
+    this->rows = 0;
+    this->count = 0;
+}
+
+// Cria a grade e reserva os vetores dos agentes
+void CrowdGrid::initialize(glm::vec3 boundsMin, glm::vec3 boundsMax, float cellSize, int capacity) {
+    this->boundsMin = boundsMin;
+    this->cellSize = cellSize;
+    this->columns = std::max(1, (int) std::ceil((boundsMax.x - boundsMin.x) / cellSize));
+    this->rows = std::max(1, (int) std::ceil((boundsMax.z - boundsMin.z) / cellSize));
+    this->count = 0;
+
+    this->cellHeads.assign((size_t) this->columns * (size_t) this->rows, -1);
+    this->next.assign(capacity, -1);
+    this->previous.assign(capacity, -1);
+    this->cells.assign(capacity, -1);
+    this->positions.assign(capacity, glm::vec3(0.0f, 0.0f, 0.0f));
+}
+
+// Célula da posição, presa à borda da grade
+int CrowdGrid::cellAt(glm::vec3 position) const {
+    int column = std::min(std::max((int) std::floor((position.x - this->boundsMin.x) / this->cellSize), 0), this->columns - 1);
+    int row = std::min(std::max((int) std::floor((position.z - this->boundsMin.z) / this->cellSize), 0), this->rows - 1);
+    return row * this->columns + column;
+}
+
+// Insere o agente no início da lista da célula
+void CrowdGrid::link(int agent, int cell) {
+    int head = this->cellHeads[cell];
+    this->next[agent] = head;
+    this->previous[agent] = -1;
+    if (head >= 0) {
+        this->previous[head] = agent;
+    }
+    this->cellHeads[cell] = agent;
+    this->cells[agent] = cell;
+}
+
+// Retira o agente da lista da sua célula
+void CrowdGrid::unlink(int agent) {
+    int cell = this->cells[agent];
+    if (cell < 0) {
+        return;
+    }
+    if (this->previous[agent] >= 0) {
+        this->next[this->previous[agent]] = this->next[agent];
+    }
+    else {
+        this->cellHeads[cell] = this->next[agent];
+    }
+    if (this->next[agent] >= 0) {
+        this->previous[this->next[agent]] = this->previous[agent];
+    }
+    this->next[agent] = -1;
+    this->previous[agent] = -1;
+    this->cells[agent] = -1;
+}
+
+// Adiciona o agente de índice getCount()
+bool CrowdGrid::insert(glm::vec3 position) {
+    if (this->count >= (int) this->cells.size()) {
+        return false;
+    }
+    int agent = this->count++;
+    this->positions[agent] = position;
+    this->link(agent, this->cellAt(position));
+    return true;
+}
+
+// Atualiza a posição, trocando de célula somente quando necessário
+void CrowdGrid::update(int agent, glm::vec3 position) {
+    this->positions[agent] = position;
+    int cell = this->cellAt(position);
+    if (cell != this->cells[agent]) {
+        this->unlink(agent);
+        this->link(agent, cell);
+    }
+}
+
+// Remove um agente
+void CrowdGrid::remove(int agent) {
+    this->unlink(agent);
+}
+
+// Move o agente para outro índice, mantendo a sua posição na lista da célula
+void CrowdGrid::relocate(int from, int to) {
+    if (from == to) {
+        return;
+    }
+    this->unlink(to);
+
+    int cell = this->cells[from];
+    this->positions[to] = this->positions[from];
+    this->cells[to] = cell;
+    this->next[to] = this->next[from];
+    this->previous[to] = this->previous[from];
+
+    if (this->previous[to] >= 0) {
+        this->next[this->previous[to]] = to;
+    }
+    else if (cell >= 0) {
+        this->cellHeads[cell] = to;
+    }
+    if (this->next[to] >= 0) {
+        this->previous[this->next[to]] = to;
+    }
+
+    this->next[from] = -1;
+    this->previous[from] = -1;
+    this->cells[from] = -1;
+}
+
+// Define o número de agentes após a compactação
+void CrowdGrid::truncate(int count) {
+    this->count = std::min(std::max(count, 0), this->count);
+}
+
+// Remove todos os agentes
+void CrowdGrid::clear() {
+    std::fill(this->cellHeads.begin(), this->cellHeads.end(), -1);
+    std::fill(this->next.begin(), this->next.end(), -1);
+    std::fill(this->previous.begin(), this->previous.end(), -1);
+    std::fill(this->cells.begin(), this->cells.end(), -1);
+    this->count = 0;
+}
+
+// Separação em relação aos vizinhos das 3x3 células ao redor do agente
+glm::vec3 CrowdGrid::separation(int agent, uint64_t &pairTests) const {
+    glm::vec3 push = glm::vec3(0.0f, 0.0f, 0.0f);
+    int cell = this->cells[agent];
+    if (cell < 0) {
+        return push;
+    }
+
+    glm::vec3 position = this->positions[agent];
+    int column = cell % this->columns;
+    int row = cell / this->columns;
+    float radius = CROWD_SEPARATION_RADIUS;
+    int neighbors = 0;
+
+    for (int r = std::max(row - 1, 0); r <= std::min(row + 1, this->rows - 1); r++) {
+        for (int c = std::max(column - 1, 0); c <= std::min(column + 1, this->columns - 1); c++) {
+            for (int other = this->cellHeads[r * this->columns + c]; other >= 0; other = this->next[other]) {
+                if (other == agent) {
+                    continue;
+                }
+
+                pairTests++;
+                float dx = position.x - this->positions[other].x;
+                float dz = position.z - this->positions[other].z;
+                float distanceSquared = dx * dx + dz * dz;
+                if (distanceSquared >= radius * radius) {
+                    continue;
+                }
+
+                float distance = std::sqrt(distanceSquared);
+                if (distance < 1e-5f) {
+                    // Agentes sobrepostos: direção fixa derivada dos índices, em sentidos opostos para o par
+                    float angle = 2.39996323f * (float) std::min(agent, other);
+                    float sign = agent < other ? 1.0f : -1.0f;
+                    push.x += sign * std::cos(angle);
+                    push.z += sign * std::sin(angle);
+                }
+                else {
+                    float weight = 1.0f - distance / radius;
+                    push.x += weight * dx / distance;
+                    push.z += weight * dz / distance;
+                }
+
+                if (++neighbors >= CROWD_MAX_NEIGHBORS) {
+                    return push;
+                }
+            }
+        }
+    }
+    return push;
+}
+
+int CrowdGrid::getCount() const {
+    return this->count;
+}
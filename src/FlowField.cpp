@@ -0,0 +1,276 @@
+#include "FlowField.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "glm/geometric.hpp"
+#include "Profiler.h"
+
+// Vizinhança 8: deslocamentos e custos (ortogonais 1, diagonais raiz de 2)
+static const int NEIGHBOR_COLUMNS[8] = { 1, -1,  0,  0,  1,  1, -1, -1 };
+static const int NEIGHBOR_ROWS[8]    = { 0,  0,  1, -1,  1, -1,  1, -1 };
+static const float NEIGHBOR_COSTS[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+
+// Construtor - a grade é criada em initialize()
+FlowField::FlowField() {
+    this->boundsMin = glm::vec3(0.0f, 0.0f, 0.0f);
+    this->cellSize = FLOW_FIELD_CELL_SIZE;
+    this->columns = 0;
+    this->rows = 0;
+    this->hasObstacles = false;
+    this->targetCell = -1;
+}
+
+// Cria a grade cobrindo a região no plano XZ
+void FlowField::initialize(glm::vec3 boundsMin, glm::vec3 boundsMax, float cellSize) {
+    this->boundsMin = boundsMin;
+    this->cellSize = cellSize;
+    this->columns = std::max(1, (int) std::ceil((boundsMax.x - boundsMin.x) / cellSize));
+    this->rows = std::max(1, (int) std::ceil((boundsMax.z - boundsMin.z) / cellSize));
+
+    size_t cells = (size_t) this->columns * (size_t) this->rows;
+    this->blocked.assign(cells, 0);
+    this->costs.assign(cells, FLOW_FIELD_UNREACHED);
+    this->directions.assign(cells, glm::vec2(0.0f, 0.0f));
+    this->lineOfSight.assign(cells, 1);
+    this->hasObstacles = false;
+    this->targetCell = -1;
+
+    // Uma célula só tem o custo reduzido quando um vizinho sai da fila com o custo final, o que acontece uma
+    // vez por vizinho: no pior caso, 8 entradas por célula, mais a do alvo
+    this->queue.clear();
+    this->queue.reserve(cells * 8 + 1);
+}
+
+// Marca como bloqueadas as células tocadas pela caixa
+void FlowField::addObstacle(glm::vec3 min, glm::vec3 max) {
+    int column0 = std::max(0, (int) std::floor((min.x - this->boundsMin.x) / this->cellSize));
+    int column1 = std::min(this->columns - 1, (int) std::floor((max.x - this->boundsMin.x) / this->cellSize));
+    int row0 = std::max(0, (int) std::floor((min.z - this->boundsMin.z) / this->cellSize));
+    int row1 = std::min(this->rows - 1, (int) std::floor((max.z - this->boundsMin.z) / this->cellSize));
+
+    for (int row = row0; row <= row1; row++) {
+        for (int column = column0; column <= column1; column++) {
+            this->blocked[this->cellIndex(column, row)] = 1;
+            this->hasObstacles = true;
+        }
+    }
+
+    // Força o recálculo no próximo update(), mesmo que o alvo não mude de célula
+    this->targetCell = -1;
+}
+
+int FlowField::cellIndex(int column, int row) const {
+    return row * this->columns + column;
+}
+
+bool FlowField::isFree(int column, int row) const {
+    return column >= 0 && column < this->columns && row >= 0 && row < this->rows && !this->blocked[this->cellIndex(column, row)];
+}
+
+// Célula que contém a posição
+int FlowField::cellAt(glm::vec3 position) const {
+    int column = (int) std::floor((position.x - this->boundsMin.x) / this->cellSize);
+    int row = (int) std::floor((position.z - this->boundsMin.z) / this->cellSize);
+    if (column < 0 || column >= this->columns || row < 0 || row >= this->rows) {
+        return -1;
+    }
+    return this->cellIndex(column, row);
+}
+
+// Posição dentro de uma célula bloqueada (fora da grade nada é bloqueado)
+bool FlowField::isBlocked(glm::vec3 position) const {
+    int cell = this->cellAt(position);
+    return cell >= 0 && this->blocked[cell];
+}
+
+// Recalcula o campo se o alvo mudou de célula
+bool FlowField::update(glm::vec3 target, bool force) {
+    if (this->columns == 0) {
+        return false;
+    }
+
+    // Alvos fora da grade usam a célula mais próxima da borda
+    int column = std::min(std::max((int) std::floor((target.x - this->boundsMin.x) / this->cellSize), 0), this->columns - 1);
+    int row = std::min(std::max((int) std::floor((target.z - this->boundsMin.z) / this->cellSize), 0), this->rows - 1);
+    int cell = this->cellIndex(column, row);
+
+    if (cell == this->targetCell && !force) {
+        return false;
+    }
+
+    // Sem obstáculos toda célula enxerga o alvo e direction() segue em linha reta: o Dijkstra não é usado
+    this->targetCell = cell;
+    if (!this->hasObstacles) {
+        return false;
+    }
+
+    PROFILE_SCOPE("FlowField::update");
+    this->computeCosts(cell);
+    this->computeDirections();
+    this->computeLineOfSight(cell);
+    return true;
+}
+
+// Dijkstra a partir da célula do alvo
+void FlowField::computeCosts(int target) {
+    std::fill(this->costs.begin(), this->costs.end(), FLOW_FIELD_UNREACHED);
+
+    // Ordem do heap: menor custo no topo
+    auto greater = [](const QueueEntry &a, const QueueEntry &b) { return a.cost > b.cost; };
+
+    this->queue.clear();
+    this->costs[target] = 0.0f;
+    this->queue.push_back({0.0f, target});
+
+    while (!this->queue.empty()) {
+        std::pop_heap(this->queue.begin(), this->queue.end(), greater);
+        QueueEntry entry = this->queue.back();
+        this->queue.pop_back();
+
+        // Entrada obsoleta: a célula já foi alcançada com custo menor
+        if (entry.cost > this->costs[entry.cell]) {
+            continue;
+        }
+
+        int column = entry.cell % this->columns;
+        int row = entry.cell / this->columns;
+
+        for (int n = 0; n < 8; n++) {
+            int neighborColumn = column + NEIGHBOR_COLUMNS[n];
+            int neighborRow = row + NEIGHBOR_ROWS[n];
+            if (!this->isFree(neighborColumn, neighborRow)) {
+                continue;
+            }
+
+            // Diagonais não cortam cantos de obstáculos
+            if (n >= 4 && (!this->isFree(neighborColumn, row) || !this->isFree(column, neighborRow))) {
+                continue;
+            }
+
+            int neighbor = this->cellIndex(neighborColumn, neighborRow);
+            float cost = entry.cost + NEIGHBOR_COSTS[n];
+            if (cost < this->costs[neighbor]) {
+                assert(this->queue.size() < this->queue.capacity());
+                this->costs[neighbor] = cost;
+                this->queue.push_back({cost, neighbor});
+                std::push_heap(this->queue.begin(), this->queue.end(), greater);
+            }
+        }
+    }
+}
+
+// Cada célula alcançada aponta para o vizinho de menor custo
+void FlowField::computeDirections() {
+    for (int row = 0; row < this->rows; row++) {
+        for (int column = 0; column < this->columns; column++) {
+            int cell = this->cellIndex(column, row);
+            glm::vec2 best = glm::vec2(0.0f, 0.0f);
+            float bestCost = this->costs[cell];
+
+            for (int n = 0; n < 8 && bestCost < FLOW_FIELD_UNREACHED; n++) {
+                int neighborColumn = column + NEIGHBOR_COLUMNS[n];
+                int neighborRow = row + NEIGHBOR_ROWS[n];
+                if (!this->isFree(neighborColumn, neighborRow)) {
+                    continue;
+                }
+                if (n >= 4 && (!this->isFree(neighborColumn, row) || !this->isFree(column, neighborRow))) {
+                    continue;
+                }
+
+                float cost = this->costs[this->cellIndex(neighborColumn, neighborRow)];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    best = glm::normalize(glm::vec2((float) NEIGHBOR_COLUMNS[n], (float) NEIGHBOR_ROWS[n]));
+                }
+            }
+
+            this->directions[cell] = best;
+        }
+    }
+}
+
+// Células com linha de visão até o alvo seguem em linha reta, sem o serrilhado da grade.
+// A visibilidade é propagada a partir do alvo, em anéis de distância crescente: o segmento entre o centro de
+// uma célula e o do alvo cruza, um passo mais perto no eixo principal, uma ou duas células do anel anterior, e
+// a célula enxerga o alvo se estiver livre e todas elas o enxergarem. Cada célula é visitada uma única vez
+void FlowField::computeLineOfSight(int target) {
+    if (!this->hasObstacles) {
+        std::fill(this->lineOfSight.begin(), this->lineOfSight.end(), 1);
+        return;
+    }
+
+    int targetColumn = target % this->columns;
+    int targetRow = target / this->columns;
+    this->lineOfSight[target] = 1;
+
+    int rings = std::max(std::max(targetColumn, this->columns - 1 - targetColumn), std::max(targetRow, this->rows - 1 - targetRow));
+    for (int ring = 1; ring <= rings; ring++) {
+        // Perímetro do anel: linhas de cima e de baixo inteiras, colunas laterais sem os cantos
+        for (int side = 0; side < 4; side++) {
+            int count = side < 2 ? 2 * ring + 1 : 2 * ring - 1;
+            for (int i = 0; i < count; i++) {
+                int deltaColumn = side < 2 ? i - ring : (side == 2 ? -ring : ring);
+                int deltaRow = side < 2 ? (side == 0 ? -ring : ring) : i - ring + 1;
+                int column = targetColumn + deltaColumn;
+                int row = targetRow + deltaRow;
+                if (column < 0 || column >= this->columns || row < 0 || row >= this->rows) {
+                    continue;
+                }
+                this->lineOfSight[this->cellIndex(column, row)] = this->seesThrough(deltaColumn, deltaRow, targetColumn, targetRow);
+            }
+        }
+    }
+}
+
+// Visibilidade da célula no deslocamento (deltaColumn, deltaRow) do alvo, a partir do anel anterior
+bool FlowField::seesThrough(int deltaColumn, int deltaRow, int targetColumn, int targetRow) const {
+    if (this->blocked[this->cellIndex(targetColumn + deltaColumn, targetRow + deltaRow)]) {
+        return false;
+    }
+
+    // Eixo principal: o de maior deslocamento. Um passo mais perto nele, o segmento está na posição "minor" do outro
+    bool columnMajor = std::abs(deltaColumn) >= std::abs(deltaRow);
+    int major = columnMajor ? deltaColumn : deltaRow;
+    int minor = columnMajor ? deltaRow : deltaColumn;
+    int nextMajor = major - (major > 0 ? 1 : -1);
+    float position = (float) minor * (float) nextMajor / (float) major;
+    int minor0 = (int) std::floor(position + 1e-4f);
+    int minor1 = (int) std::ceil(position - 1e-4f);
+
+    for (int nextMinor = minor0; nextMinor <= minor1; nextMinor++) {
+        int column = targetColumn + (columnMajor ? nextMajor : nextMinor);
+        int row = targetRow + (columnMajor ? nextMinor : nextMajor);
+        if (!this->lineOfSight[this->cellIndex(column, row)]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Direção a ser seguida a partir da posição
+glm::vec3 FlowField::direction(glm::vec3 position, glm::vec3 target) const {
+    glm::vec3 straight = glm::vec3(target.x - position.x, 0.0f, target.z - position.z);
+    float length = glm::length(straight);
+    if (length < 1e-6f) {
+        return glm::vec3(0.0f, 0.0f, 0.0f);
+    }
+
+    // Fora da grade, com linha de visão ou em uma célula isolada: direto para o alvo
+    int cell = this->cellAt(position);
+    if (cell < 0 || this->lineOfSight[cell] || this->costs[cell] >= FLOW_FIELD_UNREACHED || cell == this->targetCell) {
+        return straight / length;
+    }
+
+    glm::vec2 flow = this->directions[cell];
+    return glm::vec3(flow.x, 0.0f, flow.y);
+}
+
+int FlowField::getColumns() const {
+    return this->columns;
+}
+
+int FlowField::getRows() const {
+    return this->rows;
+}
@@ -0,0 +1,48 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+// Reserva a memória da arena uma única vez
+FrameArena::FrameArena(size_t capacity) {
+    this->memory = static_cast<unsigned char*>(std::malloc(capacity));
+    if (this->memory == nullptr) {
+        throw std::runtime_error("Erro ao reservar a arena de quadro.");
+    }
+    this->capacity = capacity;
+    this->offset = 0;
+    this->highWater = 0;
+}
+
+FrameArena::~FrameArena() {
+    std::free(this->memory);
+}
+
+// Avança o ponteiro da arena, respeitando o alinhamento pedido
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    uintptr_t base = (uintptr_t) this->memory;
+    uintptr_t aligned = (base + this->offset + alignment - 1) & ~(uintptr_t) (alignment - 1);
+    size_t newOffset = (size_t) (aligned - base) + size;
+
+    if (newOffset > this->capacity) {
+        return nullptr;
+    }
+
+    this->offset = newOffset;
+    this->highWater = std::max(this->highWater, newOffset);
+    return (void*) aligned;
+}
+
+// Descarta todas as alocações do quadro
+void FrameArena::reset() {
+    this->offset = 0;
+}
+
+size_t FrameArena::used() const {
+    return this->offset;
+}
+
+size_t FrameArena::peak() const {
+    return this->highWater;
+}
@@ -0,0 +1,34 @@
+#include "GLExtensions.h"
+
+#include <cstdio>
+
+bool GLExtensions::computeSupported = false;
+PFNGLDISPATCHCOMPUTEPROC_EXT GLExtensions::dispatchCompute = nullptr;
+PFNGLMEMORYBARRIERPROC_EXT GLExtensions::memoryBarrier = nullptr;
+PFNGLDRAWELEMENTSINDIRECTPROC_EXT GLExtensions::drawElementsIndirect = nullptr;
+PFNGLDRAWARRAYSINDIRECTPROC_EXT GLExtensions::drawArraysIndirect = nullptr;
+
+// Carrega as funções de OpenGL 4.3
+bool GLExtensions::load(GLADloadproc loader) {
+    GLExtensions::computeSupported = false;
+
+    bool version43 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3);
+    if (!version43) {
+        printf("OpenGL %d.%d: caminhos de OpenGL 4.3 desabilitados.\n", GLVersion.major, GLVersion.minor);
+        return false;
+    }
+
+    GLExtensions::dispatchCompute = (PFNGLDISPATCHCOMPUTEPROC_EXT) loader("glDispatchCompute");
+    GLExtensions::memoryBarrier = (PFNGLMEMORYBARRIERPROC_EXT) loader("glMemoryBarrier");
+    GLExtensions::drawElementsIndirect = (PFNGLDRAWELEMENTSINDIRECTPROC_EXT) loader("glDrawElementsIndirect");
+    GLExtensions::drawArraysIndirect = (PFNGLDRAWARRAYSINDIRECTPROC_EXT) loader("glDrawArraysIndirect");
+
+    GLExtensions::computeSupported = GLExtensions::dispatchCompute != nullptr
+                                     && GLExtensions::memoryBarrier != nullptr
+                                     && GLExtensions::drawElementsIndirect != nullptr
+                                     && GLExtensions::drawArraysIndirect != nullptr;
+
+    printf("OpenGL %d.%d: compute shaders %s.\n", GLVersion.major, GLVersion.minor,
+           GLExtensions::computeSupported ? "habilitados" : "indisponiveis");
+    return GLExtensions::computeSupported;
+}
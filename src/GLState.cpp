@@ -0,0 +1,198 @@
+#include "GLState.h"
+
+#include <cstring>
+
+#include "Metrics.h"
+
+// Valor que não corresponde a nenhum objeto, forçando a primeira chamada
+#define GL_STATE_UNKNOWN 0xFFFFFFFFu
+
+GLuint GLState::program = GL_STATE_UNKNOWN;
+GLuint GLState::vertexArray = GL_STATE_UNKNOWN;
+GLuint GLState::arrayBuffer = GL_STATE_UNKNOWN;
+GLuint GLState::activeUnit = GL_STATE_UNKNOWN;
+GLuint GLState::textures[GL_STATE_MAX_TEXTURE_UNITS];
+GLuint GLState::samplers[GL_STATE_MAX_TEXTURE_UNITS];
+CachedProgram GLState::programs[GL_STATE_MAX_PROGRAMS];
+int GLState::nextProgramSlot = 0;
+CachedProgram* GLState::current = nullptr;
+
+// Contagem de chamadas enviadas e evitadas
+void GLState::issued() {
+    Metrics::add(COUNTER_STATE_CHANGES);
+}
+
+void GLState::skipped() {
+    Metrics::add(COUNTER_STATE_CHANGES_SKIPPED);
+}
+
+// Liga um programa de GPU e seleciona o cache de uniforms correspondente
+void GLState::useProgram(GLuint program) {
+    if (GLState::program == program) {
+        skipped();
+        return;
+    }
+    glUseProgram(program);
+    GLState::program = program;
+    issued();
+
+    // Busca o cache do programa; se não existir, substitui o mais antigo
+    GLState::current = nullptr;
+    if (program == 0) {
+        return;
+    }
+    for (CachedProgram &cached : GLState::programs) {
+        if (cached.program == program) {
+            GLState::current = &cached;
+            return;
+        }
+    }
+
+    CachedProgram &slot = GLState::programs[GLState::nextProgramSlot];
+    GLState::nextProgramSlot = (GLState::nextProgramSlot + 1) % GL_STATE_MAX_PROGRAMS;
+    slot.program = program;
+    for (CachedUniform &uniform : slot.uniforms) {
+        uniform.size = 0;
+    }
+    GLState::current = &slot;
+}
+
+void GLState::bindVertexArray(GLuint vertexArray) {
+    if (GLState::vertexArray == vertexArray) {
+        skipped();
+        return;
+    }
+    glBindVertexArray(vertexArray);
+    GLState::vertexArray = vertexArray;
+    issued();
+}
+
+// Somente GL_ARRAY_BUFFER é guardado: GL_ELEMENT_ARRAY_BUFFER faz parte do estado do VAO
+void GLState::bindBuffer(GLenum target, GLuint buffer) {
+    if (target == GL_ARRAY_BUFFER) {
+        if (GLState::arrayBuffer == buffer) {
+            skipped();
+            return;
+        }
+        GLState::arrayBuffer = buffer;
+    }
+    glBindBuffer(target, buffer);
+    issued();
+}
+
+void GLState::activeTexture(GLenum texture) {
+    GLuint unit = texture - GL_TEXTURE0;
+    if (GLState::activeUnit == unit) {
+        skipped();
+        return;
+    }
+    glActiveTexture(texture);
+    GLState::activeUnit = unit;
+    issued();
+}
+
+// Somente GL_TEXTURE_2D é guardado, por unidade de textura
+void GLState::bindTexture(GLenum target, GLuint texture) {
+    bool cached = target == GL_TEXTURE_2D && GLState::activeUnit < GL_STATE_MAX_TEXTURE_UNITS;
+    if (cached) {
+        if (GLState::textures[GLState::activeUnit] == texture) {
+            skipped();
+            return;
+        }
+        GLState::textures[GLState::activeUnit] = texture;
+    }
+    glBindTexture(target, texture);
+    issued();
+}
+
+void GLState::bindSampler(GLuint unit, GLuint sampler) {
+    if (unit < GL_STATE_MAX_TEXTURE_UNITS) {
+        if (GLState::samplers[unit] == sampler) {
+            skipped();
+            return;
+        }
+        GLState::samplers[unit] = sampler;
+    }
+    glBindSampler(unit, sampler);
+    issued();
+}
+
+// Compara com o último valor enviado ao uniform do programa ligado
+bool GLState::uniformChanged(GLint location, const void* value, uint32_t size) {
+    // Localizações fora do cache (ou sem programa conhecido) são sempre enviadas
+    if (GLState::current == nullptr || location < 0 || location >= GL_STATE_MAX_UNIFORMS) {
+        return true;
+    }
+
+    CachedUniform &uniform = GLState::current->uniforms[location];
+    if (uniform.size == size && memcmp(uniform.bits, value, size) == 0) {
+        return false;
+    }
+    uniform.size = size;
+    memcpy(uniform.bits, value, size);
+    return true;
+}
+
+void GLState::uniform1i(GLint location, GLint v0) {
+    if (location < 0 || !uniformChanged(location, &v0, sizeof(v0))) {
+        skipped();
+        return;
+    }
+    glUniform1i(location, v0);
+    issued();
+}
+
+void GLState::uniform1f(GLint location, GLfloat v0) {
+    if (location < 0 || !uniformChanged(location, &v0, sizeof(v0))) {
+        skipped();
+        return;
+    }
+    glUniform1f(location, v0);
+    issued();
+}
+
+void GLState::uniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    GLfloat value[2] = {v0, v1};
+    if (location < 0 || !uniformChanged(location, value, sizeof(value))) {
+        skipped();
+        return;
+    }
+    glUniform2f(location, v0, v1);
+    issued();
+}
+
+void GLState::uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    GLfloat value[4] = {v0, v1, v2, v3};
+    if (location < 0 || !uniformChanged(location, value, sizeof(value))) {
+        skipped();
+        return;
+    }
+    glUniform4f(location, v0, v1, v2, v3);
+    issued();
+}
+
+void GLState::uniformMatrix4fv(GLint location, const GLfloat* value) {
+    if (location < 0 || !uniformChanged(location, value, 16 * sizeof(GLfloat))) {
+        skipped();
+        return;
+    }
+    glUniformMatrix4fv(location, 1, GL_FALSE, value);
+    issued();
+}
+
+// Esquece todo o estado conhecido
+void GLState::invalidate() {
+    GLState::program = GL_STATE_UNKNOWN;
+    GLState::vertexArray = GL_STATE_UNKNOWN;
+    GLState::arrayBuffer = GL_STATE_UNKNOWN;
+    GLState::activeUnit = GL_STATE_UNKNOWN;
+    for (int unit = 0; unit < GL_STATE_MAX_TEXTURE_UNITS; unit++) {
+        GLState::textures[unit] = GL_STATE_UNKNOWN;
+        GLState::samplers[unit] = GL_STATE_UNKNOWN;
+    }
+    for (CachedProgram &cached : GLState::programs) {
+        cached.program = 0;
+    }
+    GLState::nextProgramSlot = 0;
+    GLState::current = nullptr;
+}
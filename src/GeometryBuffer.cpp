@@ -0,0 +1,217 @@
+#include "GeometryBuffer.h"
+
+#include <cstddef>
+
+#include "GLState.h"
+
+// Construtor do buffer compartilhado - os objetos de OpenGL são criados no primeiro append()
+GeometryBuffer::GeometryBuffer() {
+    this->vertexArrayObjectId = 0;
+    this->vertexBufferId = 0;
+    this->indexBufferId = 0;
+    this->vertexCapacity = 0;
+    this->indexCapacity = 0;
+    this->vertexCount = 0;
+    this->indexCount = 0;
+}
+
+// Cria o VAO e os buffers com a capacidade inicial
+void GeometryBuffer::create() {
+    this->vertexCapacity = GEOMETRY_INITIAL_VERTICES;
+    this->indexCapacity = GEOMETRY_INITIAL_INDICES;
+
+    glGenVertexArrays(1, &this->vertexArrayObjectId);
+    GLState::bindVertexArray(this->vertexArrayObjectId);
+
+    glGenBuffers(1, &this->vertexBufferId);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->vertexBufferId);
+    glBufferData(GL_ARRAY_BUFFER, this->vertexCapacity * sizeof(StaticVertex), NULL, GL_STATIC_DRAW);
+
+    // O buffer de índices fica associado ao VAO
+    glGenBuffers(1, &this->indexBufferId);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indexBufferId);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indexCapacity * sizeof(GLuint), NULL, GL_STATIC_DRAW);
+
+    this->bindAttributes();
+
+    GLState::bindVertexArray(0);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Aponta os atributos do VAO (já ligado) para o buffer de vértices atual
+void GeometryBuffer::bindAttributes() {
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->vertexBufferId);
+
+    // "(location = 0)" em "shader_vertex.glsl" - vec4 com w = 1.0
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(StaticVertex), (void*) offsetof(StaticVertex, position));
+    glEnableVertexAttribArray(0);
+
+    // "(location = 1)" em "shader_vertex.glsl"
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(StaticVertex), (void*) offsetof(StaticVertex, normal));
+    glEnableVertexAttribArray(1);
+
+    // "(location = 2)" em "shader_vertex.glsl"
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(StaticVertex), (void*) offsetof(StaticVertex, texcoord));
+    glEnableVertexAttribArray(2);
+}
+
+// Cria um buffer maior e copia o conteúdo usado na própria GPU
+GLuint GeometryBuffer::resizeBuffer(GLuint buffer, size_t usedBytes, size_t newBytes) {
+    GLuint newBuffer;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr) newBytes, NULL, GL_STATIC_DRAW);
+
+    if (usedBytes > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr) usedBytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &buffer);
+    return newBuffer;
+}
+
+// Aumenta a capacidade (dobrando) até comportar o pedido
+void GeometryBuffer::grow(size_t minVertices, size_t minIndices) {
+    GLState::bindVertexArray(this->vertexArrayObjectId);
+
+    if (minVertices > this->vertexCapacity) {
+        size_t capacity = this->vertexCapacity;
+        while (capacity < minVertices) {
+            capacity *= 2;
+        }
+        this->vertexBufferId = resizeBuffer(this->vertexBufferId, this->vertexCount * sizeof(StaticVertex), capacity * sizeof(StaticVertex));
+        this->vertexCapacity = capacity;
+        this->bindAttributes();
+    }
+
+    if (minIndices > this->indexCapacity) {
+        size_t capacity = this->indexCapacity;
+        while (capacity < minIndices) {
+            capacity *= 2;
+        }
+        this->indexBufferId = resizeBuffer(this->indexBufferId, this->indexCount * sizeof(GLuint), capacity * sizeof(GLuint));
+        this->indexCapacity = capacity;
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indexBufferId);
+    }
+
+    GLState::bindVertexArray(0);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Envia uma malha para o final do buffer
+GeometryRange GeometryBuffer::append(const StaticVertex* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount) {
+    if (this->vertexArrayObjectId == 0) {
+        this->create();
+    }
+    if (this->vertexCount + vertexCount > this->vertexCapacity || this->indexCount + indexCount > this->indexCapacity) {
+        this->grow(this->vertexCount + vertexCount, this->indexCount + indexCount);
+    }
+
+    GeometryRange range;
+    range.baseVertex = (GLint) this->vertexCount;
+    range.firstIndex = this->indexCount;
+    range.vertexCount = vertexCount;
+    range.indexCount = indexCount;
+
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->vertexBufferId);
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr) (this->vertexCount * sizeof(StaticVertex)), (GLsizeiptr) (vertexCount * sizeof(StaticVertex)), vertices);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // O buffer de índices é alterado através do VAO, ao qual está associado
+    GLState::bindVertexArray(this->vertexArrayObjectId);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr) (this->indexCount * sizeof(GLuint)), (GLsizeiptr) (indexCount * sizeof(GLuint)), indices);
+    GLState::bindVertexArray(0);
+
+    this->vertexCount += vertexCount;
+    this->indexCount += indexCount;
+
+    return range;
+}
+
+// Liga um buffer de matrizes de modelo aos atributos por instância do VAO compartilhado.
+// Desenhos não instanciados leem somente a primeira matriz, ignorada pelo shader.
+void GeometryBuffer::setInstanceBuffer(GLuint buffer) {
+    if (this->vertexArrayObjectId == 0) {
+        this->create();
+    }
+
+    GLState::bindVertexArray(this->vertexArrayObjectId);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    // "(location = 3)" em "shader_vertex.glsl": uma mat4 ocupa quatro localizações, uma por coluna
+    for (GLuint column = 0; column < 4; column++) {
+        GLuint location = 3 + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(float), (void*) (column * 4 * sizeof(float)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+
+    GLState::bindVertexArray(0);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Liga o buffer de projéteis aos atributos por instância do VAO compartilhado, inicialmente desabilitados
+void GeometryBuffer::setProjectileBuffer(GLuint buffer) {
+    if (this->vertexArrayObjectId == 0) {
+        this->create();
+    }
+
+    GLState::bindVertexArray(this->vertexArrayObjectId);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    // "(location = 9)" e "(location = 10)" em "shader_vertex.glsl"
+    for (GLuint attribute = 0; attribute < 2; attribute++) {
+        GLuint location = 9 + attribute;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*) (attribute * 4 * sizeof(float)));
+        glDisableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+
+    GLState::bindVertexArray(0);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Habilita ou desabilita os atributos dos projéteis no VAO compartilhado, que já deve estar ligado
+void GeometryBuffer::setProjectileAttributesEnabled(bool enabled) {
+    for (GLuint location = 9; location <= 10; location++) {
+        if (enabled) {
+            glEnableVertexAttribArray(location);
+        }
+        else {
+            glDisableVertexAttribArray(location);
+        }
+    }
+}
+
+// Libera os objetos de OpenGL
+void GeometryBuffer::release() {
+    if (this->vertexBufferId != 0) {
+        glDeleteBuffers(1, &this->vertexBufferId);
+        this->vertexBufferId = 0;
+    }
+    if (this->indexBufferId != 0) {
+        glDeleteBuffers(1, &this->indexBufferId);
+        this->indexBufferId = 0;
+    }
+    if (this->vertexArrayObjectId != 0) {
+        glDeleteVertexArrays(1, &this->vertexArrayObjectId);
+        this->vertexArrayObjectId = 0;
+    }
+    this->vertexCapacity = 0;
+    this->indexCapacity = 0;
+    this->vertexCount = 0;
+    this->indexCount = 0;
+    GLState::invalidate();
+}
+
+GLuint GeometryBuffer::getVertexArrayObject() const {
+    return this->vertexArrayObjectId;
+}
+
+// Memória reservada na GPU (capacidade total, incluindo a parte ainda livre)
+size_t GeometryBuffer::getGpuBytes() const {
+    return this->vertexCapacity * sizeof(StaticVertex) + this->indexCapacity * sizeof(GLuint);
+}
@@ -0,0 +1,201 @@
+#include "GpuTimer.h"
+
+#include <algorithm>
+
+// Inicializa os acumuladores - as queries só são criadas em initialize()
+GpuTimer::GpuTimer() {
+    this->frameNumber = 0;
+    this->initialized = false;
+    this->lastGpuMs = 0.0;
+    this->lastCpuMs = 0.0;
+    this->sumGpuMs = 0.0;
+    this->sumCpuMs = 0.0;
+    this->resolvedFrames = 0;
+    this->droppedFrames = 0;
+    this->log = nullptr;
+
+    for (int pass = 0; pass < GPU_PASS_COUNT; pass++) {
+        this->lastPassMs[pass] = 0.0;
+        this->sumPassMs[pass] = 0.0;
+        this->maxPassMs[pass] = 0.0;
+    }
+
+    for (GpuTimerFrame &frame : this->frames) {
+        frame.pending = false;
+        frame.frameNumber = 0;
+        frame.cpuMs = 0.0;
+    }
+}
+
+// Cria todas as queries de uma vez - nenhuma query é criada durante o jogo
+void GpuTimer::initialize(const char* logFilename) {
+    for (GpuTimerFrame &frame : this->frames) {
+        glGenQueries(2, frame.frameQueries);
+        glGenQueries(2 * GPU_PASS_COUNT, &frame.passQueries[0][0]);
+    }
+    this->initialized = true;
+
+    this->log = fopen(logFilename, "w");
+    if (this->log == NULL) {
+        fprintf(stderr, "ERROR: Cannot open file \"%s\".\n", logFilename);
+    }
+    else {
+        fprintf(this->log, "frame,cpu_ms,gpu_ms");
+        for (int pass = 0; pass < GPU_PASS_COUNT; pass++) {
+            fprintf(this->log, ",%s_ms", passName((GpuPass) pass));
+        }
+        fprintf(this->log, "\n");
+    }
+}
+
+// Lê os resultados de um quadro antigo, descartando-o caso a GPU ainda não tenha terminado
+void GpuTimer::resolve(GpuTimerFrame &frame) {
+    frame.pending = false;
+
+    GLint available = 0;
+    glGetQueryObjectiv(frame.frameQueries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        this->droppedFrames++;
+        return;
+    }
+
+    GLuint64 begin, end;
+    glGetQueryObjectui64v(frame.frameQueries[0], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(frame.frameQueries[1], GL_QUERY_RESULT, &end);
+    this->lastGpuMs = (double) (end - begin) / 1.0e6;
+    this->lastCpuMs = frame.cpuMs;
+
+    for (int pass = 0; pass < GPU_PASS_COUNT; pass++) {
+        double ms = 0.0;
+        if (frame.passUsed[pass]) {
+            glGetQueryObjectui64v(frame.passQueries[pass][0], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(frame.passQueries[pass][1], GL_QUERY_RESULT, &end);
+            ms = (double) (end - begin) / 1.0e6;
+        }
+        this->lastPassMs[pass] = ms;
+        this->sumPassMs[pass] += ms;
+        this->maxPassMs[pass] = std::max(this->maxPassMs[pass], ms);
+    }
+
+    this->sumGpuMs += this->lastGpuMs;
+    this->sumCpuMs += this->lastCpuMs;
+    this->resolvedFrames++;
+
+    // Registra os tempos de CPU e GPU do mesmo quadro lado a lado
+    if (this->log != NULL) {
+        fprintf(this->log, "%lu,%.4f,%.4f", frame.frameNumber, this->lastCpuMs, this->lastGpuMs);
+        for (double ms : this->lastPassMs) {
+            fprintf(this->log, ",%.4f", ms);
+        }
+        fprintf(this->log, "\n");
+    }
+}
+
+// Marca o início do quadro
+void GpuTimer::beginFrame() {
+    if (!this->initialized) {
+        return;
+    }
+
+    GpuTimerFrame &frame = this->frames[this->frameNumber % GPU_TIMER_LATENCY];
+
+    // As queries deste slot foram emitidas GPU_TIMER_LATENCY quadros atrás
+    if (frame.pending) {
+        this->resolve(frame);
+    }
+
+    for (bool &used : frame.passUsed) {
+        used = false;
+    }
+    frame.frameNumber = this->frameNumber;
+    glQueryCounter(frame.frameQueries[0], GL_TIMESTAMP);
+}
+
+// Marca o final do quadro, guardando o tempo de CPU correspondente
+void GpuTimer::endFrame(double cpuMs) {
+    if (!this->initialized) {
+        return;
+    }
+
+    GpuTimerFrame &frame = this->frames[this->frameNumber % GPU_TIMER_LATENCY];
+    glQueryCounter(frame.frameQueries[1], GL_TIMESTAMP);
+    frame.cpuMs = cpuMs;
+    frame.pending = true;
+
+    this->frameNumber++;
+}
+
+// Início de uma seção de renderização
+void GpuTimer::beginPass(GpuPass pass) {
+    if (!this->initialized) {
+        return;
+    }
+
+    GpuTimerFrame &frame = this->frames[this->frameNumber % GPU_TIMER_LATENCY];
+    glQueryCounter(frame.passQueries[pass][0], GL_TIMESTAMP);
+}
+
+// Fim de uma seção de renderização
+void GpuTimer::endPass(GpuPass pass) {
+    if (!this->initialized) {
+        return;
+    }
+
+    GpuTimerFrame &frame = this->frames[this->frameNumber % GPU_TIMER_LATENCY];
+    glQueryCounter(frame.passQueries[pass][1], GL_TIMESTAMP);
+    frame.passUsed[pass] = true;
+}
+
+// Getters dos últimos resultados disponíveis
+
+double GpuTimer::getPassMs(GpuPass pass) const {
+    return this->lastPassMs[pass];
+}
+
+double GpuTimer::getGpuMs() const {
+    return this->lastGpuMs;
+}
+
+double GpuTimer::getCpuMs() const {
+    return this->lastCpuMs;
+}
+
+// Imprime o resumo da sessão e libera as queries
+void GpuTimer::shutdown() {
+    if (!this->initialized) {
+        return;
+    }
+
+    if (this->resolvedFrames > 0) {
+        double frames = (double) this->resolvedFrames;
+        printf("Tempos de quadro (%lu quadros, %lu descartados): CPU %.3f ms, GPU %.3f ms\n",
+               this->resolvedFrames, this->droppedFrames, this->sumCpuMs / frames, this->sumGpuMs / frames);
+        for (int pass = 0; pass < GPU_PASS_COUNT; pass++) {
+            printf("- GPU %-10s media %.3f ms, max %.3f ms\n",
+                   passName((GpuPass) pass), this->sumPassMs[pass] / frames, this->maxPassMs[pass]);
+        }
+    }
+
+    if (this->log != NULL) {
+        fclose(this->log);
+        this->log = nullptr;
+    }
+
+    for (GpuTimerFrame &frame : this->frames) {
+        glDeleteQueries(2, frame.frameQueries);
+        glDeleteQueries(2 * GPU_PASS_COUNT, &frame.passQueries[0][0]);
+    }
+    this->initialized = false;
+}
+
+// Nome de cada seção para o registro
+const char* GpuTimer::passName(GpuPass pass) {
+    switch (pass) {
+        case GPU_PASS_SCENERY:   return "scenery";
+        case GPU_PASS_PLAYER:    return "player";
+        case GPU_PASS_HORDE:     return "horde";
+        case GPU_PASS_BOOMERANG: return "boomerang";
+        case GPU_PASS_HUD:       return "hud";
+        default:                 return "unknown";
+    }
+}
@@ -0,0 +1,527 @@
+#include "HordeRenderer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+
+#include "GLState.h"
+#include "matrices.h"
+#include "Metrics.h"
+#include "Profiler.h"
+
+// Construtor - os objetos de OpenGL são criados em initialize()
+HordeRenderer::HordeRenderer() {
+    this->capacity = 0;
+    this->boundsCenterY = 0.0f;
+    this->boundsRadius = 0.0f;
+    this->instanceBufferId = 0;
+    this->visibleCount = 0;
+    this->gpuCulling = false;
+    this->computeProgramId = 0;
+    this->enemyBufferId = 0;
+    for (GLuint &buffer : this->commandBufferIds) {
+        buffer = 0;
+    }
+    this->commandIndex = 0;
+    for (HordeCullReadback &readback : this->cullReadbacks) {
+        readback.buffer = 0;
+        readback.fence = nullptr;
+        readback.enemyCount = 0;
+    }
+    this->cullFrame = 0;
+    this->enemyCountUniform = -1;
+    this->frustumPlanesUniform = -1;
+    this->cameraPositionUniform = -1;
+    this->instanceScaleUniform = -1;
+    this->boundsUniform = -1;
+    this->impostorRangeUniform = -1;
+    this->simulatedStateUniform = -1;
+    this->meshBudgetUniform = -1;
+    this->impostorsEnabled = true;
+    this->impostorVaoId = 0;
+    this->impostorBufferId = 0;
+    this->impostorCount = 0;
+    for (GLuint &buffer : this->impostorCommandBufferIds) {
+        buffer = 0;
+    }
+    this->impostorStart = FLT_MAX;
+    this->impostorBand = IMPOSTOR_FADE_BAND;
+    this->meshDistance = IMPOSTOR_DISTANCE;
+}
+
+// Cria os buffers da horda
+void HordeRenderer::initialize(GeometryBuffer &geometry, const SceneObject &object, glm::vec3 bboxMin, glm::vec3 bboxMax, GLuint capacity, GLuint computeProgram) {
+    this->object = object;
+    this->capacity = capacity;
+
+    // Esfera envolvente no espaço do modelo, centrada no eixo de rotação
+    float maxX = std::max(std::fabs(bboxMin.x), std::fabs(bboxMax.x));
+    float maxZ = std::max(std::fabs(bboxMin.z), std::fabs(bboxMax.z));
+    float halfY = 0.5f * (bboxMax.y - bboxMin.y);
+    this->boundsCenterY = 0.5f * (bboxMin.y + bboxMax.y);
+    this->boundsRadius = std::sqrt(maxX * maxX + maxZ * maxZ + halfY * halfY);
+
+    // Buffer de matrizes por instância, escrito pela CPU ou pelo compute shader, até o orçamento de malhas
+    GLuint meshCapacity = std::min(capacity, (GLuint) HORDE_MESH_BUDGET);
+    glGenBuffers(1, &this->instanceBufferId);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->instanceBufferId);
+    glBufferData(GL_ARRAY_BUFFER, meshCapacity * sizeof(glm::mat4), NULL, GL_DYNAMIC_DRAW);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    geometry.setInstanceBuffer(this->instanceBufferId);
+
+    this->cpuInstances.reserve(meshCapacity);
+    this->cpuVisible.reserve(meshCapacity);
+    this->cpuVisibleExtras.reserve(meshCapacity);
+
+    // Impostores: um quadrilátero (triangle strip gerado no vertex shader) por instância
+    glGenVertexArrays(1, &this->impostorVaoId);
+    GLState::bindVertexArray(this->impostorVaoId);
+    glGenBuffers(1, &this->impostorBufferId);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->impostorBufferId);
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(HordeInstance), NULL, GL_DYNAMIC_DRAW);
+
+    // "(location = 0)" e "(location = 1)" em "impostor_vertex.glsl"
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(HordeInstance), (void*) offsetof(HordeInstance, positionYaw));
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(HordeInstance), (void*) offsetof(HordeInstance, animation));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::bindVertexArray(0);
+
+    this->cpuImpostors.reserve(capacity);
+
+    if (computeProgram == 0 || !GLExtensions::computeSupported) {
+        return;
+    }
+
+    // Caminho em GPU: posições dos inimigos e comandos de desenho indireto
+    this->computeProgramId = computeProgram;
+    this->enemyCountUniform     = glGetUniformLocation(computeProgram, "enemy_count");
+    this->frustumPlanesUniform  = glGetUniformLocation(computeProgram, "frustum_planes");
+    this->cameraPositionUniform = glGetUniformLocation(computeProgram, "camera_position");
+    this->instanceScaleUniform  = glGetUniformLocation(computeProgram, "instance_scale");
+    this->boundsUniform         = glGetUniformLocation(computeProgram, "bounds");
+    this->impostorRangeUniform  = glGetUniformLocation(computeProgram, "impostor_range");
+    this->simulatedStateUniform = glGetUniformLocation(computeProgram, "simulated_state");
+    this->meshBudgetUniform     = glGetUniformLocation(computeProgram, "mesh_budget");
+
+    glGenBuffers(1, &this->enemyBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->enemyBufferId);
+    glBufferData(GL_COPY_WRITE_BUFFER, capacity * sizeof(HordeInstance), NULL, GL_DYNAMIC_DRAW);
+
+    glGenBuffers(HORDE_COMMAND_BUFFERS, this->commandBufferIds);
+    for (GLuint buffer : this->commandBufferIds) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, sizeof(DrawElementsIndirectCommand), NULL, GL_DYNAMIC_DRAW);
+    }
+    glGenBuffers(HORDE_COMMAND_BUFFERS, this->impostorCommandBufferIds);
+    for (GLuint buffer : this->impostorCommandBufferIds) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, sizeof(ImpostorCommand), NULL, GL_DYNAMIC_DRAW);
+    }
+    for (HordeCullReadback &readback : this->cullReadbacks) {
+        glGenBuffers(1, &readback.buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, readback.buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, sizeof(HordeCullCounts), NULL, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    this->gpuCulling = true;
+}
+
+// Distância de troca para impostor: a menor entre a distância fixa, aquela em que o modelo ocupa
+// IMPOSTOR_SCREEN_PIXELS de altura (projection[1][1] = 1 / tan(fov / 2)) e a ajustada ao orçamento de malhas
+void HordeRenderer::updateImpostorRange(glm::vec3 scale, float modelHeight, const CameraMatrices &camera, float viewportHeight) {
+    float screenDistance = modelHeight * scale.y * camera.projection[1][1] * viewportHeight / (2.0f * IMPOSTOR_SCREEN_PIXELS);
+    float switchDistance = std::min(std::min(IMPOSTOR_DISTANCE, screenDistance), this->meshDistance);
+    this->impostorBand = IMPOSTOR_FADE_BAND;
+    this->impostorStart = this->impostorsEnabled ? switchDistance - 0.5f * IMPOSTOR_FADE_BAND : FLT_MAX;
+}
+
+// Aproxima a distância de troca enquanto mais inimigos que o orçamento pedem a malha e a afasta
+// (até IMPOSTOR_DISTANCE) quando eles ficam abaixo da metade do orçamento
+void HordeRenderer::updateMeshDistance(GLuint meshRequests) {
+    if (meshRequests > HORDE_MESH_BUDGET) {
+        this->meshDistance = std::max(HORDE_MESH_MIN_DISTANCE, this->meshDistance * 0.9f);
+    }
+    else if (meshRequests < HORDE_MESH_BUDGET / 2) {
+        this->meshDistance = std::min(IMPOSTOR_DISTANCE, this->meshDistance * 1.05f);
+    }
+}
+
+// Descarta os inimigos e prepara as instâncias do quadro
+void HordeRenderer::prepare(const HordeInstance* enemies, GLuint count, glm::vec3 scale, float modelHeight,
+                            const CameraMatrices &camera, float viewportHeight) {
+    PROFILE_SCOPE("HordeRenderer::prepare");
+
+    count = std::min(count, this->capacity);
+    this->updateImpostorRange(scale, modelHeight, camera, viewportHeight);
+
+    // Planos do frustum e posição da câmera já calculados pela câmera para o quadro
+    if (this->gpuCulling) {
+        this->prepareGpu(enemies, count, scale, camera.frustumPlanes, glm::vec3(camera.position));
+    }
+    else {
+        this->prepareCpu(enemies, count, scale, camera.frustumPlanes, glm::vec3(camera.position));
+    }
+}
+
+// Descarte em GPU lendo o estado da horda simulada na GPU
+void HordeRenderer::prepareSimulated(GLuint stateBuffer, GLuint slotCount, glm::vec3 scale, float modelHeight,
+                                     const CameraMatrices &camera, float viewportHeight) {
+    PROFILE_SCOPE("HordeRenderer::prepareSimulated");
+
+    if (!this->gpuCulling) {
+        fprintf(stderr, "ERROR: Descarte da horda simulada na GPU sem OpenGL 4.3.\n");
+        return;
+    }
+
+    this->pollCullReadbacks();
+    this->updateImpostorRange(scale, modelHeight, camera, viewportHeight);
+    this->dispatchCull(stateBuffer, std::min(slotCount, this->capacity), true, scale, camera.frustumPlanes, glm::vec3(camera.position));
+}
+
+// Descarte na CPU, enviando somente as matrizes dos inimigos visíveis
+void HordeRenderer::prepareCpu(const HordeInstance* enemies, GLuint count, glm::vec3 scale, const glm::vec4 planes[6], glm::vec3 cameraPosition) {
+    float centerY = this->boundsCenterY * scale.y;
+    float radius = this->boundsRadius * std::max(scale.x, std::max(scale.y, scale.z));
+
+    this->cpuVisible.clear();
+    this->cpuVisibleExtras.clear();
+    this->cpuImpostors.clear();
+    GLuint drawn = 0;
+    GLuint meshRequests = 0;
+    for (GLuint i = 0; i < count; i++) {
+        glm::vec4 enemy = enemies[i].positionYaw;
+        glm::vec3 center = glm::vec3(enemy.x, enemy.y + centerY, enemy.z);
+
+        // Descarte por distância
+        glm::vec3 offset = center - cameraPosition;
+        float maxDistance = HORDE_CULL_DISTANCE + radius;
+        if (glm::dot(offset, offset) > maxDistance * maxDistance) {
+            continue;
+        }
+
+        // Descarte por frustum: esfera totalmente atrás de algum plano
+        bool inside = true;
+        for (int plane = 0; plane < 6 && inside; plane++) {
+            inside = glm::dot(glm::vec3(planes[plane]), center) + planes[plane].w >= -radius;
+        }
+        if (!inside) {
+            continue;
+        }
+
+        drawn++;
+
+        // Transição para impostor: 0 = somente malha, 1 = somente impostor
+        float blend = (std::sqrt(glm::dot(offset, offset)) - this->impostorStart) / this->impostorBand;
+        blend = std::min(std::max(blend, 0.0f), 1.0f);
+
+        // Além do orçamento de malhas, somente impostor
+        if (blend < 1.0f) {
+            meshRequests++;
+            if (this->cpuVisible.size() >= HORDE_MESH_BUDGET) {
+                blend = 1.0f;
+            }
+        }
+
+        if (blend < 1.0f) {
+            this->cpuVisible.push_back(enemy);
+            this->cpuVisibleExtras.push_back(glm::vec2(enemies[i].animation.x, blend));
+        }
+        if (blend > 0.0f) {
+            HordeInstance impostor = enemies[i];
+            impostor.animation.y = blend;
+            this->cpuImpostors.push_back(impostor);
+        }
+    }
+
+    // Matrizes de modelo T*S*R_y dos visíveis, montadas em lote; a fase da animação e a transição
+    // seguem na linha inferior (sempre 0, 0, 0, 1) das duas primeiras colunas
+    this->cpuInstances.resize(this->cpuVisible.size());
+    Matrix_TRS_Y_Batch(this->cpuVisible.data(), this->cpuVisible.size(), scale, this->cpuInstances.data());
+    for (size_t i = 0; i < this->cpuInstances.size(); i++) {
+        this->cpuInstances[i][0][3] = this->cpuVisibleExtras[i].x;
+        this->cpuInstances[i][1][3] = this->cpuVisibleExtras[i].y;
+    }
+
+    this->visibleCount = (GLuint) this->cpuInstances.size();
+    this->impostorCount = (GLuint) this->cpuImpostors.size();
+    this->updateMeshDistance(meshRequests);
+    Metrics::add(COUNTER_INSTANCES_CULLED, count - drawn);
+    Metrics::add(COUNTER_IMPOSTORS, this->impostorCount);
+
+    if (this->visibleCount > 0) {
+        GLState::bindBuffer(GL_ARRAY_BUFFER, this->instanceBufferId);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, this->visibleCount * sizeof(glm::mat4), this->cpuInstances.data());
+    }
+    if (this->impostorCount > 0) {
+        GLState::bindBuffer(GL_ARRAY_BUFFER, this->impostorBufferId);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, this->impostorCount * sizeof(HordeInstance), this->cpuImpostors.data());
+    }
+}
+
+// Descarte em GPU: a CPU envia somente posição, rotação e fase da animação de cada inimigo
+void HordeRenderer::prepareGpu(const HordeInstance* enemies, GLuint count, glm::vec3 scale, const glm::vec4 planes[6], glm::vec3 cameraPosition) {
+    // Contagens de quadros anteriores que a GPU já terminou, para as métricas e o orçamento de malhas
+    this->pollCullReadbacks();
+
+    // Todos os inimigos andam a cada passo (posição, rotação e fase da animação), então o trecho alterado
+    // é o vetor inteiro: o envio completo é a própria diferença do quadro
+    if (count > 0) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, this->enemyBufferId);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, count * sizeof(HordeInstance), enemies);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    this->dispatchCull(this->enemyBufferId, count, false, scale, planes, cameraPosition);
+}
+
+// Executa o compute shader de descarte sobre "count" inimigos de "enemyBuffer"
+void HordeRenderer::dispatchCull(GLuint enemyBuffer, GLuint count, bool simulated, glm::vec3 scale, const glm::vec4 planes[6], glm::vec3 cameraPosition) {
+    this->commandIndex = (this->commandIndex + 1) % HORDE_COMMAND_BUFFERS;
+    this->visibleCount = count;
+    this->impostorCount = this->impostorsEnabled ? count : 0;
+    if (count == 0) {
+        return;
+    }
+
+    // Comando com zero instâncias - o compute shader incrementa "instanceCount" para cada inimigo visível
+    DrawElementsIndirectCommand command;
+    command.count = (GLuint) this->object.num_indices;
+    command.instanceCount = 0;
+    command.firstIndex = (GLuint) this->object.first_index;
+    command.baseVertex = this->object.base_vertex;
+    command.baseInstance = 0;
+
+    // Quadrilátero de 4 vértices, também com zero instâncias
+    ImpostorCommand impostorCommand;
+    impostorCommand.command.count = 4;
+    impostorCommand.command.instanceCount = 0;
+    impostorCommand.command.first = 0;
+    impostorCommand.command.baseInstance = 0;
+    impostorCommand.drawnCount = 0;
+    impostorCommand.meshRequests = 0;
+
+    GLuint commandBuffer = this->commandBufferIds[this->commandIndex];
+    GLuint impostorCommandBuffer = this->impostorCommandBufferIds[this->commandIndex];
+    glBindBuffer(GL_COPY_WRITE_BUFFER, commandBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(command), &command);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, impostorCommandBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(impostorCommand), &impostorCommand);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    float centerY = this->boundsCenterY * scale.y;
+    float radius = this->boundsRadius * std::max(scale.x, std::max(scale.y, scale.z));
+
+    GLState::useProgram(this->computeProgramId);
+    GLState::uniform1i(this->enemyCountUniform, (GLint) count);
+    for (int plane = 0; plane < 6; plane++) {
+        GLState::uniform4f(this->frustumPlanesUniform + plane, planes[plane].x, planes[plane].y, planes[plane].z, planes[plane].w);
+    }
+    GLState::uniform4f(this->cameraPositionUniform, cameraPosition.x, cameraPosition.y, cameraPosition.z, HORDE_CULL_DISTANCE);
+    GLState::uniform4f(this->instanceScaleUniform, scale.x, scale.y, scale.z, 0.0f);
+    GLState::uniform4f(this->boundsUniform, centerY, radius, 0.0f, 0.0f);
+    GLState::uniform4f(this->impostorRangeUniform, this->impostorStart, this->impostorBand, 0.0f, 0.0f);
+    GLState::uniform1i(this->simulatedStateUniform, simulated ? 1 : 0);
+    GLState::uniform1i(this->meshBudgetUniform, (GLint) std::min(this->capacity, (GLuint) HORDE_MESH_BUDGET));
+
+    // "binding = 0" a "binding = 4" em "horde_cull_compute.glsl"
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, enemyBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, this->instanceBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, this->impostorBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, impostorCommandBuffer);
+
+    GLExtensions::dispatchCompute((count + HORDE_CULL_GROUP_SIZE - 1) / HORDE_CULL_GROUP_SIZE, 1, 1);
+
+    // As matrizes são lidas como atributos de vértice, o comando pelo desenho indireto e as contagens pela cópia
+    GLExtensions::memoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    this->queueCullReadback(count);
+}
+
+// Copia as contagens do quadro para um buffer de leitura e marca o ponto com uma fence
+void HordeRenderer::queueCullReadback(GLuint enemyCount) {
+    HordeCullReadback &readback = this->cullReadbacks[this->cullFrame % HORDE_CULL_READBACK_BUFFERS];
+    this->cullFrame++;
+
+    // A leitura mais antiga ainda não terminou: as métricas daquele quadro são descartadas, sem esperar a GPU
+    if (readback.fence != nullptr) {
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, readback.buffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, this->commandBufferIds[this->commandIndex]);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offsetof(DrawElementsIndirectCommand, instanceCount),
+                        offsetof(HordeCullCounts, visible), sizeof(GLuint));
+    glBindBuffer(GL_COPY_READ_BUFFER, this->impostorCommandBufferIds[this->commandIndex]);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, offsetof(HordeCullCounts, impostors), sizeof(ImpostorCommand));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.enemyCount = enemyCount;
+}
+
+// Lê, do mais antigo para o mais recente, as contagens cujas fences já foram sinalizadas
+void HordeRenderer::pollCullReadbacks() {
+    for (unsigned int i = 0; i < HORDE_CULL_READBACK_BUFFERS; i++) {
+        HordeCullReadback &readback = this->cullReadbacks[(this->cullFrame + i) % HORDE_CULL_READBACK_BUFFERS];
+        if (readback.fence == nullptr) {
+            continue;
+        }
+
+        GLenum status = glClientWaitSync(readback.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+
+        HordeCullCounts counts;
+        glBindBuffer(GL_COPY_READ_BUFFER, readback.buffer);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(counts), &counts);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        GLuint visible = std::min(counts.visible, readback.enemyCount);
+        GLuint drawn = std::min(counts.impostors.drawnCount, readback.enemyCount);
+        GLuint impostorCount = std::min(counts.impostors.command.instanceCount, readback.enemyCount);
+        this->updateMeshDistance(counts.impostors.meshRequests);
+        Metrics::add(COUNTER_INSTANCES_CULLED, readback.enemyCount - drawn);
+        Metrics::add(COUNTER_IMPOSTORS, impostorCount);
+        Metrics::add(COUNTER_TRIANGLES, (this->object.num_indices / 3) * visible + 2 * impostorCount);
+    }
+}
+
+// Descarta as leituras em voo (ao trocar de caminho ou liberar os buffers)
+void HordeRenderer::discardCullReadbacks() {
+    for (HordeCullReadback &readback : this->cullReadbacks) {
+        if (readback.fence != nullptr) {
+            glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+        }
+    }
+}
+
+// Desenha as instâncias visíveis com uma única chamada
+void HordeRenderer::draw() {
+    if (this->visibleCount == 0) {
+        return;
+    }
+
+    Metrics::add(COUNTER_DRAW_CALLS);
+
+    if (this->gpuCulling) {
+        // O número de instâncias só é conhecido pela GPU (triângulos contabilizados quadros depois, em pollCullReadbacks)
+        GLState::bindBuffer(GL_DRAW_INDIRECT_BUFFER, this->commandBufferIds[this->commandIndex]);
+        GLExtensions::drawElementsIndirect(this->object.rendering_mode, GL_UNSIGNED_INT, (void*) 0);
+        GLState::bindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        return;
+    }
+
+    Metrics::add(COUNTER_TRIANGLES, (this->object.num_indices / 3) * this->visibleCount);
+    glDrawElementsInstancedBaseVertex(this->object.rendering_mode,
+                                      (GLsizei) this->object.num_indices,
+                                      GL_UNSIGNED_INT,
+                                      (void*) (this->object.first_index * sizeof(GLuint)),
+                                      (GLsizei) this->visibleCount,
+                                      this->object.base_vertex);
+}
+
+// Desenha os impostores com uma única chamada
+void HordeRenderer::drawImpostors() {
+    if (!this->hasImpostors()) {
+        return;
+    }
+
+    Metrics::add(COUNTER_DRAW_CALLS);
+    GLState::bindVertexArray(this->impostorVaoId);
+
+    if (this->gpuCulling) {
+        GLState::bindBuffer(GL_DRAW_INDIRECT_BUFFER, this->impostorCommandBufferIds[this->commandIndex]);
+        GLExtensions::drawArraysIndirect(GL_TRIANGLE_STRIP, (void*) 0);
+        GLState::bindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        return;
+    }
+
+    Metrics::add(COUNTER_TRIANGLES, 2 * this->impostorCount);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei) this->impostorCount);
+}
+
+bool HordeRenderer::hasImpostors() const {
+    return this->impostorsEnabled && this->impostorCount > 0;
+}
+
+// Liga ou desliga os impostores
+void HordeRenderer::toggleImpostors() {
+    this->impostorsEnabled = !this->impostorsEnabled;
+    printf("Impostores da horda: %s\n", this->impostorsEnabled ? "ligados" : "desligados");
+}
+
+bool HordeRenderer::isUsingImpostors() const {
+    return this->impostorsEnabled;
+}
+
+// Alterna entre o descarte em GPU e na CPU
+void HordeRenderer::toggleGpuCulling() {
+    if (this->computeProgramId == 0) {
+        printf("Descarte em GPU indisponivel (OpenGL 4.3 necessario).\n");
+        return;
+    }
+    this->gpuCulling = !this->gpuCulling;
+    this->discardCullReadbacks();
+    printf("Descarte da horda: %s\n", this->gpuCulling ? "GPU" : "CPU");
+}
+
+bool HordeRenderer::isGpuCulling() const {
+    return this->gpuCulling;
+}
+
+// Libera os objetos de OpenGL (o programa de compute pertence ao registro de recursos)
+void HordeRenderer::release() {
+    if (this->instanceBufferId != 0) {
+        glDeleteBuffers(1, &this->instanceBufferId);
+        this->instanceBufferId = 0;
+    }
+    if (this->enemyBufferId != 0) {
+        glDeleteBuffers(1, &this->enemyBufferId);
+        this->enemyBufferId = 0;
+    }
+    if (this->commandBufferIds[0] != 0) {
+        glDeleteBuffers(HORDE_COMMAND_BUFFERS, this->commandBufferIds);
+        for (GLuint &buffer : this->commandBufferIds) {
+            buffer = 0;
+        }
+    }
+    if (this->impostorCommandBufferIds[0] != 0) {
+        glDeleteBuffers(HORDE_COMMAND_BUFFERS, this->impostorCommandBufferIds);
+        for (GLuint &buffer : this->impostorCommandBufferIds) {
+            buffer = 0;
+        }
+    }
+    this->discardCullReadbacks();
+    for (HordeCullReadback &readback : this->cullReadbacks) {
+        if (readback.buffer != 0) {
+            glDeleteBuffers(1, &readback.buffer);
+            readback.buffer = 0;
+        }
+    }
+    if (this->impostorBufferId != 0) {
+        glDeleteBuffers(1, &this->impostorBufferId);
+        this->impostorBufferId = 0;
+    }
+    if (this->impostorVaoId != 0) {
+        glDeleteVertexArrays(1, &this->impostorVaoId);
+        this->impostorVaoId = 0;
+    }
+    this->computeProgramId = 0;
+    this->gpuCulling = false;
+    GLState::invalidate();
+}
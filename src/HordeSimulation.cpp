@@ -0,0 +1,541 @@
+#include "HordeSimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include "GLState.h"
+#include "Metrics.h"
+#include "Profiler.h"
+
+// Construtor - os objetos de OpenGL são criados em initialize()
+HordeSimulation::HordeSimulation() {
+    this->capacity = 0;
+    this->slotCount = 0;
+    this->generation = 0;
+    this->useCompute = false;
+    for (int i = 0; i < 2; i++) {
+        this->stateBufferIds[i] = 0;
+        this->simulationVaoIds[i] = 0;
+    }
+    this->zeroBufferId = 0;
+    this->current = 0;
+    this->spawned = 0;
+    this->waveSeed = 12345u;
+    this->feedbackProgramId = 0;
+    this->computeProgramId = 0;
+    this->feedbackUniforms = Uniforms();
+    this->computeUniforms = Uniforms();
+    this->reductionTextureId = 0;
+    this->reductionFramebufferId = 0;
+    this->resultBufferId = 0;
+    for (HordeReadback &readback : this->readbacks) {
+        readback.buffer = 0;
+        readback.fence = nullptr;
+        readback.spawned = 0;
+        readback.generation = 0;
+        readback.compute = false;
+    }
+    this->frameCounter = 0;
+    this->accumulated = HordeSimulationResults{0, 0, 0};
+    this->lastAlive = 0;
+    for (HordeStateReadback &readback : this->stateReadbacks) {
+        readback.buffer = 0;
+        readback.fence = nullptr;
+        readback.slotCount = 0;
+        readback.generation = 0;
+    }
+    this->stateFrame = 0;
+    this->stateCopyCount = 0;
+}
+
+// Busca as localizações dos uniforms comuns aos dois programas de simulação
+HordeSimulation::Uniforms HordeSimulation::findUniforms(GLuint program) {
+    Uniforms uniforms;
+    uniforms.deltaTime        = glGetUniformLocation(program, "delta_t");
+    uniforms.target           = glGetUniformLocation(program, "target");
+    uniforms.playerBboxMin    = glGetUniformLocation(program, "player_bbox_min");
+    uniforms.playerBboxMax    = glGetUniformLocation(program, "player_bbox_max");
+    uniforms.projectileCount  = glGetUniformLocation(program, "projectile_count");
+    uniforms.projectileBoxes  = glGetUniformLocation(program, "projectile_boxes");
+    uniforms.projectileSweeps = glGetUniformLocation(program, "projectile_sweeps");
+    uniforms.halfExtents      = glGetUniformLocation(program, "half_extents");
+    uniforms.animationRate    = glGetUniformLocation(program, "animation_rate");
+    uniforms.slotCount        = glGetUniformLocation(program, "slot_count");
+    return uniforms;
+}
+
+// Cria os buffers de estado, a redução e as leituras assíncronas
+void HordeSimulation::initialize(GLuint capacity, GLuint feedbackProgram, GLuint computeProgram) {
+    this->capacity = capacity;
+    this->feedbackProgramId = feedbackProgram;
+    this->feedbackUniforms = findUniforms(feedbackProgram);
+    this->pending.reserve(capacity);
+    this->stateCopy.resize(capacity);
+
+    // Buffers de estado e os VAOs que os leem como vértices no passo de transform feedback
+    glGenBuffers(2, this->stateBufferIds);
+    glGenVertexArrays(2, this->simulationVaoIds);
+    for (int i = 0; i < 2; i++) {
+        GLState::bindVertexArray(this->simulationVaoIds[i]);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, this->stateBufferIds[i]);
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(HordeAgent), NULL, GL_DYNAMIC_COPY);
+
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(HordeAgent), (void*) offsetof(HordeAgent, state0));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(HordeAgent), (void*) offsetof(HordeAgent, state1));
+        glEnableVertexAttribArray(1);
+    }
+    GLState::bindVertexArray(0);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Zeros copiados para o buffer de destino antes de cada passo: as posições não escritas ficam "mortas"
+    std::vector<HordeAgent> zeros(capacity, HordeAgent{glm::vec4(0.0f), glm::vec4(0.0f)});
+    glGenBuffers(1, &this->zeroBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->zeroBufferId);
+    glBufferData(GL_COPY_WRITE_BUFFER, capacity * sizeof(HordeAgent), zeros.data(), GL_STATIC_COPY);
+
+    // Framebuffer 1x1 em ponto flutuante: somas exatas até 2^24 zumbis.
+    // A textura é criada na última unidade, sem desligar as texturas dos modelos.
+    glGenTextures(1, &this->reductionTextureId);
+    GLState::activeTexture(GL_TEXTURE0 + GL_STATE_MAX_TEXTURE_UNITS - 1);
+    GLState::bindTexture(GL_TEXTURE_2D, this->reductionTextureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 1, 1, 0, GL_RGBA, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &this->reductionFramebufferId);
+    glBindFramebuffer(GL_FRAMEBUFFER, this->reductionFramebufferId);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->reductionTextureId, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        fprintf(stderr, "ERROR: Framebuffer de reducao da horda incompleto.\n");
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Buffers de leitura: 4 floats (framebuffer) ou 4 inteiros (contadores)
+    for (HordeReadback &readback : this->readbacks) {
+        glGenBuffers(1, &readback.buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, readback.buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, 4 * sizeof(GLuint), NULL, GL_STREAM_READ);
+    }
+    for (HordeStateReadback &readback : this->stateReadbacks) {
+        glGenBuffers(1, &readback.buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, readback.buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, capacity * sizeof(HordeAgent), NULL, GL_STREAM_READ);
+    }
+
+    // Caminho de OpenGL 4.3: contadores atômicos em um SSBO
+    if (computeProgram != 0 && GLExtensions::computeSupported) {
+        this->computeProgramId = computeProgram;
+        this->computeUniforms = findUniforms(computeProgram);
+
+        glGenBuffers(1, &this->resultBufferId);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, this->resultBufferId);
+        glBufferData(GL_COPY_WRITE_BUFFER, 4 * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+        this->useCompute = true;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+// Enfileira um zumbi
+bool HordeSimulation::spawn(glm::vec3 position, glm::vec3 direction, float speed, float phase) {
+    if (this->slotCount + this->pending.size() >= this->capacity) {
+        return false;
+    }
+
+    HordeAgent agent;
+    agent.state0 = glm::vec4(position, speed);
+    agent.state1 = glm::vec4(atan2f(direction.z, direction.x), 0.0f, 1.0f, phase);
+    this->pending.push_back(agent);
+    return true;
+}
+
+// Enfileira uma onda massiva, com posições pseudo-aleatórias reproduzíveis
+GLuint HordeSimulation::spawnWave(GLuint count, float radius, float speed) {
+    for (GLuint i = 0; i < count; i++) {
+        this->waveSeed = this->waveSeed * 1664525u + 1013904223u;
+        float angle = (float) (this->waveSeed >> 8) / 16777216.0f * 6.2831853f;
+        this->waveSeed = this->waveSeed * 1664525u + 1013904223u;
+        float distance = radius * (0.75f + 0.25f * (float) (this->waveSeed >> 8) / 16777216.0f);
+
+        glm::vec3 position = glm::vec3(distance * cosf(angle), 0.0f, distance * sinf(angle));
+        if (!this->spawn(position, glm::vec3(0.0f, 0.0f, 1.0f), speed, angle / 6.2831853f)) {
+            printf("Simulacao da horda cheia: %u zumbis\n", this->capacity);
+            return i;
+        }
+    }
+    return count;
+}
+
+// Escreve os zumbis enfileirados nas posições seguintes do buffer de estado atual
+void HordeSimulation::uploadPending() {
+    if (this->pending.empty()) {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->stateBufferIds[this->current]);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, this->slotCount * sizeof(HordeAgent), this->pending.size() * sizeof(HordeAgent), this->pending.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    this->slotCount += (GLuint) this->pending.size();
+    this->spawned += this->pending.size();
+    this->pending.clear();
+}
+
+// Envia os uniforms do quadro ao programa de simulação já ligado
+void HordeSimulation::setUniforms(const Uniforms &uniforms, const HordeSimulationInput &input) {
+    GLState::uniform1f(uniforms.deltaTime, input.deltaTime);
+    GLState::uniform4f(uniforms.target, input.target.x, input.target.y, input.target.z, 1.0f);
+    GLState::uniform4f(uniforms.playerBboxMin, input.playerBboxMin.x, input.playerBboxMin.y, input.playerBboxMin.z, 1.0f);
+    GLState::uniform4f(uniforms.playerBboxMax, input.playerBboxMax.x, input.playerBboxMax.y, input.playerBboxMax.z, 1.0f);
+    GLState::uniform1i(uniforms.projectileCount, (GLint) input.projectileCount);
+    if (input.projectileCount > 0) {
+        // Os vetores de projéteis mudam a cada quadro e são enviados sem passar pelo cache de GLState
+        glUniform4fv(uniforms.projectileBoxes, (GLsizei) input.projectileCount, &input.projectileBoxes[0].x);
+        glUniform4fv(uniforms.projectileSweeps, (GLsizei) input.projectileCount, &input.projectileSweeps[0].x);
+    }
+    GLState::uniform4f(uniforms.halfExtents, input.xDifference, input.zDifference, 0.0f, 0.0f);
+    GLState::uniform1f(uniforms.animationRate, input.animationRate);
+    GLState::uniform1i(uniforms.slotCount, (GLint) this->slotCount);
+}
+
+// Executa um passo da simulação
+void HordeSimulation::simulate(const HordeSimulationInput &input) {
+    PROFILE_SCOPE("HordeSimulation::simulate");
+
+    this->uploadPending();
+    if (this->slotCount == 0) {
+        this->lastAlive = 0;
+        return;
+    }
+
+    // Destino zerado até o limite atual: as posições que não receberem um zumbi vivo ficam livres
+    glBindBuffer(GL_COPY_READ_BUFFER, this->zeroBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->stateBufferIds[1 - this->current]);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, this->slotCount * sizeof(HordeAgent));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (this->useCompute) {
+        this->simulateCompute(input);
+    }
+    else {
+        this->simulateFeedback(input);
+    }
+    this->queueReadback();
+    this->frameCounter++;
+}
+
+// OpenGL 3.3: um ponto por zumbi, com o estado dos vivos capturado por transform feedback no outro buffer
+void HordeSimulation::simulateFeedback(const HordeSimulationInput &input) {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, this->reductionFramebufferId);
+    glViewport(0, 0, 1, 1);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // As reduções de todos os pontos são somadas no mesmo pixel
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    GLState::useProgram(this->feedbackProgramId);
+    this->setUniforms(this->feedbackUniforms, input);
+
+    GLState::bindVertexArray(this->simulationVaoIds[this->current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, this->stateBufferIds[1 - this->current]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, (GLsizei) this->slotCount);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    Metrics::add(COUNTER_DRAW_CALLS);
+
+    glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    this->current = 1 - this->current;
+}
+
+// OpenGL 4.3: vivos copiados para o outro buffer nas posições reservadas pelo contador atômico
+void HordeSimulation::simulateCompute(const HordeSimulationInput &input) {
+    GLuint zero[4] = {0, 0, 0, 0};
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->resultBufferId);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(zero), zero);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    GLState::useProgram(this->computeProgramId);
+    this->setUniforms(this->computeUniforms, input);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, this->stateBufferIds[this->current]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, this->resultBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, this->stateBufferIds[1 - this->current]);
+    GLExtensions::dispatchCompute((this->slotCount + HORDE_SIM_GROUP_SIZE - 1) / HORDE_SIM_GROUP_SIZE, 1, 1);
+
+    // O estado é lido pelo descarte (SSBO) ou copiado para a CPU, e os contadores são copiados para leitura
+    GLExtensions::memoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    this->current = 1 - this->current;
+}
+
+// Copia as reduções do quadro para um buffer de leitura e marca o ponto com uma fence
+void HordeSimulation::queueReadback() {
+    HordeReadback &readback = this->readbacks[this->frameCounter % HORDE_SIM_READBACK_BUFFERS];
+
+    // Todas as leituras em voo: a mais antiga espera a GPU, para que nenhuma morte seja perdida
+    if (readback.fence != nullptr) {
+        glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        this->consumeReadback(readback);
+    }
+
+    if (this->useCompute) {
+        glBindBuffer(GL_COPY_READ_BUFFER, this->resultBufferId);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, readback.buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, 4 * sizeof(GLuint));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    else {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, this->reductionFramebufferId);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+        glReadPixels(0, 0, 1, 1, GL_RGBA, GL_FLOAT, (void*) 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    }
+
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.spawned = this->spawned;
+    readback.generation = this->generation;
+    readback.compute = this->useCompute;
+}
+
+// Lê uma redução terminada e a soma às reduções ainda não entregues
+void HordeSimulation::consumeReadback(HordeReadback &readback) {
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+
+    GLuint values[4];
+    glBindBuffer(GL_COPY_READ_BUFFER, readback.buffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(values), values);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    if (!readback.compute) {
+        float sums[4];
+        memcpy(sums, values, sizeof(sums));
+        for (int i = 0; i < 4; i++) {
+            values[i] = (GLuint) sums[i];
+        }
+    }
+
+    // Resultados de antes de um reinício não se referem mais aos zumbis atuais
+    if (readback.generation != this->generation) {
+        return;
+    }
+
+    this->accumulated.playerHits += values[0];
+    this->accumulated.kills += values[1];
+    this->accumulated.alive = values[2];
+    this->lastAlive = values[2];
+
+    // Zumbis escritos no início do buffer naquele passo (no transform feedback, os mortos no passo também),
+    // somados aos enviados depois: novo limite das posições ocupadas. Os envios só acontecem logo antes de um
+    // passo, que os compacta junto com os demais, então nenhum zumbi fica além desse limite.
+    GLuint written = readback.compute ? values[2] : values[1] + values[2];
+    uint64_t bound = (uint64_t) written + (this->spawned - readback.spawned);
+    this->slotCount = (GLuint) std::min((uint64_t) this->slotCount, bound);
+}
+
+// Consome, do mais antigo para o mais recente, as leituras já terminadas pela GPU
+bool HordeSimulation::pollResults(HordeSimulationResults &results) {
+    PROFILE_SCOPE("HordeSimulation::pollResults");
+
+    bool consumed = false;
+    for (unsigned int i = 0; i < HORDE_SIM_READBACK_BUFFERS; i++) {
+        HordeReadback &readback = this->readbacks[(this->frameCounter + i) % HORDE_SIM_READBACK_BUFFERS];
+        if (readback.fence == nullptr) {
+            continue;
+        }
+
+        GLenum status = glClientWaitSync(readback.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        this->consumeReadback(readback);
+        consumed = true;
+    }
+
+    // Inclui as leituras consumidas à força em queueReadback()
+    results = this->accumulated;
+    this->accumulated.playerHits = 0;
+    this->accumulated.kills = 0;
+    return consumed;
+}
+
+// Copia o estado escrito no último passo e marca o ponto com uma fence
+void HordeSimulation::queueStateCopy() {
+    HordeStateReadback &readback = this->stateReadbacks[this->stateFrame % HORDE_SIM_READBACK_BUFFERS];
+    this->stateFrame++;
+
+    // A cópia mais antiga ainda não terminou: é descartada, sem esperar a GPU
+    if (readback.fence != nullptr) {
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+    }
+
+    readback.slotCount = this->slotCount;
+    readback.generation = this->generation;
+    if (this->slotCount == 0) {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, this->stateBufferIds[this->current]);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, readback.buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, this->slotCount * sizeof(HordeAgent));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+// Lê somente a cópia mais recente já terminada; as anteriores a ela são descartadas
+const HordeAgent* HordeSimulation::getStateCopy(GLuint &count) {
+    HordeStateReadback* newest = nullptr;
+    for (unsigned int i = 0; i < HORDE_SIM_READBACK_BUFFERS; i++) {
+        HordeStateReadback &readback = this->stateReadbacks[(this->stateFrame + i) % HORDE_SIM_READBACK_BUFFERS];
+        if (readback.fence == nullptr) {
+            continue;
+        }
+
+        GLenum status = glClientWaitSync(readback.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+        newest = &readback;
+    }
+
+    if (newest != nullptr && newest->generation == this->generation) {
+        glBindBuffer(GL_COPY_READ_BUFFER, newest->buffer);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, newest->slotCount * sizeof(HordeAgent), this->stateCopy.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        this->stateCopyCount = newest->slotCount;
+    }
+
+    count = this->stateCopyCount;
+    return this->stateCopy.data();
+}
+
+// Descarta as cópias do estado em voo e a última cópia lida
+void HordeSimulation::discardStateCopies() {
+    for (HordeStateReadback &readback : this->stateReadbacks) {
+        if (readback.fence != nullptr) {
+            glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+        }
+    }
+    this->stateCopyCount = 0;
+}
+
+// Lê os zumbis vivos, incluindo os ainda não enviados, e descarta o estado na GPU
+GLuint HordeSimulation::readAlive(HordeAgent* agents, GLuint maxAgents) {
+    std::vector<HordeAgent> state(this->slotCount);
+    if (this->slotCount > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, this->stateBufferIds[this->current]);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, this->slotCount * sizeof(HordeAgent), state.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    state.insert(state.end(), this->pending.begin(), this->pending.end());
+
+    GLuint count = 0;
+    for (const HordeAgent &agent : state) {
+        if (agent.state1.z != 0.0f && count < maxAgents) {
+            agents[count++] = agent;
+        }
+    }
+
+    this->clear();
+    return count;
+}
+
+// Descarta todos os zumbis e leituras em voo
+void HordeSimulation::clear() {
+    for (HordeReadback &readback : this->readbacks) {
+        if (readback.fence != nullptr) {
+            glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+        }
+    }
+    this->discardStateCopies();
+    this->pending.clear();
+    this->slotCount = 0;
+    this->generation++;
+    this->accumulated = HordeSimulationResults{0, 0, 0};
+    this->lastAlive = 0;
+}
+
+bool HordeSimulation::isCompute() const {
+    return this->useCompute;
+}
+
+// Buffer escrito no último passo, com os zumbis nas primeiras getSlotCount() posições
+GLuint HordeSimulation::getStateBuffer() const {
+    return this->stateBufferIds[this->current];
+}
+
+GLuint HordeSimulation::getSlotCount() const {
+    return this->slotCount;
+}
+
+GLuint HordeSimulation::getAliveCount() const {
+    return this->lastAlive;
+}
+
+// Libera os objetos de OpenGL
+void HordeSimulation::release() {
+    this->clear();
+
+    for (HordeReadback &readback : this->readbacks) {
+        if (readback.buffer != 0) {
+            glDeleteBuffers(1, &readback.buffer);
+            readback.buffer = 0;
+        }
+    }
+    for (HordeStateReadback &readback : this->stateReadbacks) {
+        if (readback.buffer != 0) {
+            glDeleteBuffers(1, &readback.buffer);
+            readback.buffer = 0;
+        }
+    }
+    if (this->zeroBufferId != 0) {
+        glDeleteBuffers(1, &this->zeroBufferId);
+        this->zeroBufferId = 0;
+    }
+    if (this->resultBufferId != 0) {
+        glDeleteBuffers(1, &this->resultBufferId);
+        this->resultBufferId = 0;
+    }
+    if (this->reductionFramebufferId != 0) {
+        glDeleteFramebuffers(1, &this->reductionFramebufferId);
+        this->reductionFramebufferId = 0;
+    }
+    if (this->reductionTextureId != 0) {
+        glDeleteTextures(1, &this->reductionTextureId);
+        this->reductionTextureId = 0;
+    }
+    if (this->simulationVaoIds[0] != 0) {
+        glDeleteVertexArrays(2, this->simulationVaoIds);
+        this->simulationVaoIds[0] = this->simulationVaoIds[1] = 0;
+    }
+    if (this->stateBufferIds[0] != 0) {
+        glDeleteBuffers(2, this->stateBufferIds);
+        this->stateBufferIds[0] = this->stateBufferIds[1] = 0;
+    }
+    this->useCompute = false;
+    GLState::invalidate();
+}
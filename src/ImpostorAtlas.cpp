@@ -0,0 +1,150 @@
+#include "ImpostorAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "GLState.h"
+#include "matrices.h"
+
+// Linhas do atlas
+#define IMPOSTOR_ATLAS_ROWS ((IMPOSTOR_VIEWS + IMPOSTOR_ATLAS_COLUMNS - 1) / IMPOSTOR_ATLAS_COLUMNS)
+
+// Construtor - os objetos de OpenGL são criados em initialize()
+ImpostorAtlas::ImpostorAtlas() {
+    this->textureId = 0;
+    this->depthRenderbufferId = 0;
+    this->framebufferId = 0;
+    this->textureUnit = 0;
+    this->width = 0.0f;
+    this->height = 0.0f;
+    this->bottom = 0.0f;
+    this->cameraDistance = 0.0f;
+    for (GLint &value : this->previousViewport) {
+        value = 0;
+    }
+}
+
+// Cria a textura do atlas e o framebuffer de captura
+bool ImpostorAtlas::initialize(glm::vec3 bboxMin, glm::vec3 bboxMax, GLuint textureUnit) {
+    this->textureUnit = textureUnit;
+
+    // Raio horizontal que cobre o modelo em qualquer rotação em Y
+    float maxX = std::max(std::fabs(bboxMin.x), std::fabs(bboxMax.x));
+    float maxZ = std::max(std::fabs(bboxMin.z), std::fabs(bboxMax.z));
+    float radius = std::sqrt(maxX * maxX + maxZ * maxZ);
+
+    this->width = 2.0f * radius;
+    this->height = bboxMax.y - bboxMin.y;
+    this->bottom = bboxMin.y;
+    this->cameraDistance = radius + 1.0f;
+
+    GLsizei atlasWidth = IMPOSTOR_ATLAS_COLUMNS * IMPOSTOR_CELL_SIZE;
+    GLsizei atlasHeight = IMPOSTOR_ATLAS_ROWS * IMPOSTOR_CELL_SIZE;
+
+    // Textura RGBA: o alfa nulo marca os texels fora da silhueta
+    glGenTextures(1, &this->textureId);
+    GLState::activeTexture(GL_TEXTURE0 + textureUnit);
+    GLState::bindTexture(GL_TEXTURE_2D, this->textureId);
+    GLState::bindSampler(textureUnit, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlasWidth, atlasHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, IMPOSTOR_MAX_MIP_LEVEL);
+
+    glGenRenderbuffers(1, &this->depthRenderbufferId);
+    glBindRenderbuffer(GL_RENDERBUFFER, this->depthRenderbufferId);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, atlasWidth, atlasHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &this->framebufferId);
+    glBindFramebuffer(GL_FRAMEBUFFER, this->framebufferId);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->textureId, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, this->depthRenderbufferId);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (!complete) {
+        fprintf(stderr, "ERROR: Framebuffer do atlas de impostores incompleto.\n");
+        this->release();
+        return false;
+    }
+
+    printf("Atlas de impostores: %d vistas (%dx%d).\n", IMPOSTOR_VIEWS, atlasWidth, atlasHeight);
+    return true;
+}
+
+// Liga o framebuffer do atlas e limpa todas as vistas
+void ImpostorAtlas::beginCapture() {
+    glGetIntegerv(GL_VIEWPORT, this->previousViewport);
+    glBindFramebuffer(GL_FRAMEBUFFER, this->framebufferId);
+    glViewport(0, 0, IMPOSTOR_ATLAS_COLUMNS * IMPOSTOR_CELL_SIZE, IMPOSTOR_ATLAS_ROWS * IMPOSTOR_CELL_SIZE);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+// Restringe o desenho à vista "view" e retorna as matrizes da captura
+void ImpostorAtlas::captureView(int view, glm::mat4 &viewMatrix, glm::mat4 &projection) {
+    int column = view % IMPOSTOR_ATLAS_COLUMNS;
+    int row = view / IMPOSTOR_ATLAS_COLUMNS;
+    glViewport(column * IMPOSTOR_CELL_SIZE, row * IMPOSTOR_CELL_SIZE, IMPOSTOR_CELL_SIZE, IMPOSTOR_CELL_SIZE);
+
+    // Câmera na direção da vista, na altura da origem do modelo, olhando para o eixo Y
+    float angle = 2.0f * 3.14159265f * (float) view / (float) IMPOSTOR_VIEWS;
+    glm::vec4 direction = glm::vec4(sinf(angle), 0.0f, cosf(angle), 0.0f);
+    glm::vec4 position = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f) + this->cameraDistance * direction;
+    viewMatrix = Matrix_Camera_View(position, -direction, glm::vec4(0.0f, 1.0f, 0.0f, 0.0f));
+
+    // O retângulo [-width/2, width/2] x [bottom, bottom + height] ocupa a vista inteira
+    float halfWidth = 0.5f * this->width;
+    projection = Matrix_Orthographic(-halfWidth, halfWidth, this->bottom, this->bottom + this->height, -0.01f, -2.0f * this->cameraDistance);
+}
+
+// Volta ao framebuffer da janela e gera os mipmaps do atlas
+void ImpostorAtlas::endCapture() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(this->previousViewport[0], this->previousViewport[1], this->previousViewport[2], this->previousViewport[3]);
+
+    GLState::activeTexture(GL_TEXTURE0 + this->textureUnit);
+    GLState::bindTexture(GL_TEXTURE_2D, this->textureId);
+    glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+bool ImpostorAtlas::isReady() const {
+    return this->framebufferId != 0;
+}
+
+GLuint ImpostorAtlas::getTextureUnit() const {
+    return this->textureUnit;
+}
+
+float ImpostorAtlas::getWidth() const {
+    return this->width;
+}
+
+float ImpostorAtlas::getHeight() const {
+    return this->height;
+}
+
+float ImpostorAtlas::getBottom() const {
+    return this->bottom;
+}
+
+// Libera os objetos de OpenGL
+void ImpostorAtlas::release() {
+    if (this->framebufferId != 0) {
+        glDeleteFramebuffers(1, &this->framebufferId);
+        this->framebufferId = 0;
+    }
+    if (this->depthRenderbufferId != 0) {
+        glDeleteRenderbuffers(1, &this->depthRenderbufferId);
+        this->depthRenderbufferId = 0;
+    }
+    if (this->textureId != 0) {
+        glDeleteTextures(1, &this->textureId);
+        this->textureId = 0;
+    }
+    GLState::invalidate();
+}
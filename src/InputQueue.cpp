@@ -0,0 +1,177 @@
+#include "InputQueue.h"
+
+#include <algorithm>
+#include <cstdio>
+
+// Capacidade inicial da fila - evita realocações durante o jogo
+#define INPUT_QUEUE_CAPACITY 256
+
+// Inicializa a fila vazia e todas as teclas soltas
+InputQueue::InputQueue() {
+    this->events.reserve(INPUT_QUEUE_CAPACITY);
+    for (bool &key : this->state) {
+        key = false;
+    }
+    this->pendingDx = 0.0f;
+    this->pendingDy = 0.0f;
+    this->hasPendingCursor = false;
+    this->screenWidth = 800;
+    this->screenHeight = 800;
+    this->oldestEventTime = -1.0;
+}
+
+// Guarda o instante do evento mais antigo ainda não apresentado
+void InputQueue::markEvent(double timestamp) {
+    if (this->oldestEventTime < 0.0 || timestamp < this->oldestEventTime) {
+        this->oldestEventTime = timestamp;
+    }
+}
+
+// Enfileira um evento de tecla ou botão do mouse
+void InputQueue::push(InputKey key, bool pressed, double timestamp) {
+    InputEvent event;
+    event.key = key;
+    event.pressed = pressed;
+    event.timestamp = timestamp;
+    this->events.push_back(event);
+}
+
+// Acumula o deslocamento do cursor até o próximo "latch"
+void InputQueue::pushCursor(float dx, float dy, double timestamp) {
+    this->pendingDx += dx;
+    this->pendingDy += dy;
+    if (!this->hasPendingCursor) {
+        this->hasPendingCursor = true;
+        this->markEvent(timestamp);
+    }
+}
+
+// Descarta eventos pendentes e solta todas as teclas
+void InputQueue::clear(Camera &camera) {
+    this->events.clear();
+    for (bool &key : this->state) {
+        key = false;
+    }
+    this->pendingDx = 0.0f;
+    this->pendingDy = 0.0f;
+    this->hasPendingCursor = false;
+    camera.keys = Keys();
+}
+
+// Consome os eventos do passo de simulação
+void InputQueue::consume(Camera &camera, double stepStart, double stepEnd) {
+
+    // Tempo pressionado e cliques de cada tecla dentro do passo
+    double held[INPUT_KEY_COUNT];
+    double since[INPUT_KEY_COUNT];
+    bool pressedInStep[INPUT_KEY_COUNT];
+    for (int key = 0; key < INPUT_KEY_COUNT; key++) {
+        held[key] = 0.0;
+        since[key] = stepStart;
+        pressedInStep[key] = false;
+    }
+
+    // Percorre os eventos em ordem de chegada, integrando o tempo entre pressionar e soltar
+    for (const InputEvent &event : this->events) {
+        double time = std::clamp(event.timestamp, stepStart, stepEnd);
+        int key = event.key;
+
+        if (event.pressed && !this->state[key]) {
+            this->state[key] = true;
+            since[key] = time;
+            pressedInStep[key] = true;
+        }
+        else if (!event.pressed && this->state[key]) {
+            this->state[key] = false;
+            held[key] += time - since[key];
+        }
+
+        this->markEvent(event.timestamp);
+    }
+    this->events.clear();
+
+    // Teclas que continuam pressionadas contam até o final do passo
+    for (int key = 0; key < INPUT_KEY_COUNT; key++) {
+        if (this->state[key]) {
+            held[key] += stepEnd - since[key];
+        }
+    }
+
+    // Atualiza o estado das teclas na câmera
+    Keys &keys = camera.keys;
+    keys.W = this->state[INPUT_W];
+    keys.A = this->state[INPUT_A];
+    keys.S = this->state[INPUT_S];
+    keys.D = this->state[INPUT_D];
+    keys.M1 = this->state[INPUT_M1];
+    keys.M2 = this->state[INPUT_M2];
+    keys.F = this->state[INPUT_F];
+    keys.heldW = (float) held[INPUT_W];
+    keys.heldA = (float) held[INPUT_A];
+    keys.heldS = (float) held[INPUT_S];
+    keys.heldD = (float) held[INPUT_D];
+    keys.pressedM1 = pressedInStep[INPUT_M1];
+    keys.pressedM2 = pressedInStep[INPUT_M2];
+    keys.pressedF = pressedInStep[INPUT_F];
+}
+
+// Aplica o deslocamento acumulado do cursor na câmera
+void InputQueue::latchCursor(Camera &camera) {
+    if (!this->hasPendingCursor) {
+        return;
+    }
+
+    float dx = this->pendingDx;
+    float dy = this->pendingDy;
+
+    if (camera.isUseFreeCamera()) {
+        // Em câmera livre, calcula o ângulo rotação horizontal conforme a porcentagem da tela movida
+        float angleX = dx/((float) this->screenWidth/2)  * 2 * M_PI;
+        float angleY = dy/((float) this->screenHeight/2) * 2 * M_PI;
+        camera.updateViewVector(angleX, angleY);
+        camera.updateSphericAngles(angleX);
+    }
+    else {
+        // Em câmera look-at, atualiza os angulos esféricos para os do cursor
+        camera.updateSphericAngles(dx, dy);
+    }
+
+    this->pendingDx = 0.0f;
+    this->pendingDy = 0.0f;
+    this->hasPendingCursor = false;
+}
+
+// Computa a latência entre o evento mais antigo aplicado e a apresentação do quadro
+void InputQueue::markPresented(double presentTime) {
+    if (this->oldestEventTime < 0.0) {
+        return;
+    }
+
+    double sample = presentTime - this->oldestEventTime;
+    this->latency.last = sample;
+    this->latency.sum += sample;
+    this->latency.max = std::max(this->latency.max, sample);
+    this->latency.samples++;
+
+    this->oldestEventTime = -1.0;
+}
+
+void InputQueue::setScreenSize(int width, int height) {
+    this->screenWidth = width;
+    this->screenHeight = height;
+}
+
+const LatencyStats &InputQueue::getLatency() const {
+    return this->latency;
+}
+
+// Imprime o resumo de latência no terminal
+void InputQueue::printLatency() const {
+    if (this->latency.samples == 0) {
+        return;
+    }
+    printf("Latencia entrada-apresentacao: media %.2f ms, max %.2f ms (%lu amostras)\n",
+           1000.0 * this->latency.sum / (double) this->latency.samples,
+           1000.0 * this->latency.max,
+           this->latency.samples);
+}
@@ -0,0 +1,307 @@
+#include "InputRecording.h"
+
+#include <cstring>
+
+// Flags de cada passo gravado
+#define RECORD_PAUSED 0x01
+#define RECORD_ATTACK_PRIMARY 0x02
+#define RECORD_ATTACK_SECONDARY 0x04
+#define RECORD_DELTA_TIME 0x08
+#define RECORD_VIEW 0x10
+#define RECORD_ATTACK_PISTOL 0x20
+
+// Códigos do tempo pressionado de cada tecla de movimento
+#define HELD_ZERO 0
+#define HELD_FULL 1     // Pressionada durante todo o passo
+#define HELD_REPEAT 2   // Mesmo valor do passo anterior
+#define HELD_EXPLICIT 3 // Valor gravado em seguida
+
+// Código de um tempo pressionado em relação à duração do passo e ao passo anterior
+static int HeldCode(float held, float previous, float deltaTime) {
+    if (held == 0.0f) {
+        return HELD_ZERO;
+    }
+    if (held == deltaTime) {
+        return HELD_FULL;
+    }
+    if (held == previous) {
+        return HELD_REPEAT;
+    }
+    return HELD_EXPLICIT;
+}
+
+// Construtor - o arquivo é criado em open()
+InputRecorder::InputRecorder() {
+    this->file = nullptr;
+    this->header.magic = RECORDING_MAGIC;
+    this->header.hashInterval = RECORDING_HASH_INTERVAL;
+    this->header.tickCount = 0;
+    this->bytes = 0;
+}
+
+InputRecorder::~InputRecorder() {
+    this->close();
+}
+
+// Cria o arquivo e grava o cabeçalho
+bool InputRecorder::open(const char* filename, const SimulationConfig &config, uint32_t hashInterval) {
+    this->close();
+
+    this->file = fopen(filename, "wb");
+    if (this->file == nullptr) {
+        fprintf(stderr, "ERROR: Nao foi possivel criar a gravacao \"%s\".\n", filename);
+        return false;
+    }
+
+    this->header.magic = RECORDING_MAGIC;
+    this->header.hashInterval = hashInterval > 0 ? hashInterval : RECORDING_HASH_INTERVAL;
+    this->header.tickCount = 0;
+    this->header.config = config;
+    this->previous = SimulationInput();
+    this->bytes = sizeof(RecordingHeader);
+    fwrite(&this->header, sizeof(RecordingHeader), 1, this->file);
+
+    printf("Gravando a entrada em \"%s\" (semente %u).\n", filename, config.seed);
+    return true;
+}
+
+// Grava somente o que mudou em relação ao passo anterior
+void InputRecorder::record(const SimulationInput &input) {
+    if (this->file == nullptr) {
+        return;
+    }
+
+    uint8_t flags = 0;
+    if (input.paused) flags |= RECORD_PAUSED;
+    if (input.attackPrimary) flags |= RECORD_ATTACK_PRIMARY;
+    if (input.attackSecondary) flags |= RECORD_ATTACK_SECONDARY;
+    if (input.attackPistol) flags |= RECORD_ATTACK_PISTOL;
+    if (input.deltaTime != this->previous.deltaTime) flags |= RECORD_DELTA_TIME;
+    if (input.viewDirection != this->previous.viewDirection) flags |= RECORD_VIEW;
+
+    const float held[4] = {input.heldW, input.heldA, input.heldS, input.heldD};
+    const float previousHeld[4] = {this->previous.heldW, this->previous.heldA, this->previous.heldS, this->previous.heldD};
+    uint8_t codes = 0;
+    for (int key = 0; key < 4; key++) {
+        codes |= (uint8_t) (HeldCode(held[key], previousHeld[key], input.deltaTime) << (2 * key));
+    }
+
+    // Monta o registro em um buffer local e o grava de uma vez
+    uint8_t buffer[2 + 8 * sizeof(float)];
+    size_t size = 0;
+    buffer[size++] = flags;
+    buffer[size++] = codes;
+    if (flags & RECORD_DELTA_TIME) {
+        memcpy(buffer + size, &input.deltaTime, sizeof(float));
+        size += sizeof(float);
+    }
+    if (flags & RECORD_VIEW) {
+        memcpy(buffer + size, &input.viewDirection, 3 * sizeof(float));
+        size += 3 * sizeof(float);
+    }
+    for (int key = 0; key < 4; key++) {
+        if (((codes >> (2 * key)) & 3) == HELD_EXPLICIT) {
+            memcpy(buffer + size, &held[key], sizeof(float));
+            size += sizeof(float);
+        }
+    }
+
+    fwrite(buffer, 1, size, this->file);
+    this->bytes += size;
+    this->header.tickCount++;
+    this->previous = input;
+}
+
+// Grava o hash do estado nos passos múltiplos do intervalo
+void InputRecorder::recordState(const Simulation &simulation) {
+    if (this->file == nullptr || simulation.getTick() % this->header.hashInterval != 0) {
+        return;
+    }
+    uint64_t hash = simulation.hashState();
+    fwrite(&hash, sizeof(hash), 1, this->file);
+    this->bytes += sizeof(hash);
+}
+
+// Completa o número de passos no cabeçalho e fecha o arquivo
+void InputRecorder::close() {
+    if (this->file == nullptr) {
+        return;
+    }
+
+    fseek(this->file, 0, SEEK_SET);
+    fwrite(&this->header, sizeof(RecordingHeader), 1, this->file);
+    fclose(this->file);
+    this->file = nullptr;
+
+    printf("Gravacao: %llu passos, %.1f KB (%.1f bytes por passo)\n", (unsigned long long) this->header.tickCount,
+           (double) this->bytes / 1024.0, this->header.tickCount > 0 ? (double) this->bytes / (double) this->header.tickCount : 0.0);
+}
+
+bool InputRecorder::isOpen() const {
+    return this->file != nullptr;
+}
+
+// Construtor - a gravação é carregada em open()
+InputReplay::InputReplay() {
+    this->offset = 0;
+    this->header.magic = 0;
+    this->header.hashInterval = RECORDING_HASH_INTERVAL;
+    this->header.tickCount = 0;
+    this->ticks = 0;
+    this->checks = 0;
+    this->divergences = 0;
+    this->firstDivergence = 0;
+}
+
+// Carrega a gravação e valida o cabeçalho
+bool InputReplay::open(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "ERROR: Nao foi possivel abrir a gravacao \"%s\".\n", filename);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    this->data.resize(size > 0 ? (size_t) size : 0);
+    bool ok = size >= (long) sizeof(RecordingHeader) && fread(this->data.data(), 1, this->data.size(), file) == this->data.size();
+    fclose(file);
+
+    if (ok) {
+        memcpy(&this->header, this->data.data(), sizeof(RecordingHeader));
+        ok = this->header.magic == RECORDING_MAGIC && this->header.hashInterval > 0;
+    }
+    if (!ok) {
+        fprintf(stderr, "ERROR: Gravacao invalida: \"%s\".\n", filename);
+        this->data.clear();
+        return false;
+    }
+
+    this->rewind();
+    printf("Reproduzindo \"%s\": %llu passos (semente %u).\n", filename, (unsigned long long) this->header.tickCount, this->header.config.seed);
+    return true;
+}
+
+// Lê bytes da posição atual, se houver
+bool InputReplay::read(void* destination, size_t size) {
+    if (this->offset + size > this->data.size()) {
+        return false;
+    }
+    memcpy(destination, this->data.data() + this->offset, size);
+    this->offset += size;
+    return true;
+}
+
+const SimulationConfig &InputReplay::getConfig() const {
+    return this->header.config;
+}
+
+// Decodifica a entrada do próximo passo
+bool InputReplay::next(SimulationInput &input) {
+    if (this->ticks >= this->header.tickCount) {
+        return false;
+    }
+
+    uint8_t flags = 0;
+    uint8_t codes = 0;
+    if (!this->read(&flags, 1) || !this->read(&codes, 1)) {
+        return false;
+    }
+
+    input = this->previous;
+    input.paused = (flags & RECORD_PAUSED) != 0;
+    input.attackPrimary = (flags & RECORD_ATTACK_PRIMARY) != 0;
+    input.attackSecondary = (flags & RECORD_ATTACK_SECONDARY) != 0;
+    input.attackPistol = (flags & RECORD_ATTACK_PISTOL) != 0;
+    if ((flags & RECORD_DELTA_TIME) && !this->read(&input.deltaTime, sizeof(float))) {
+        return false;
+    }
+    if ((flags & RECORD_VIEW) && !this->read(&input.viewDirection, 3 * sizeof(float))) {
+        return false;
+    }
+
+    float* held[4] = {&input.heldW, &input.heldA, &input.heldS, &input.heldD};
+    for (int key = 0; key < 4; key++) {
+        switch ((codes >> (2 * key)) & 3) {
+            case HELD_ZERO:
+                *held[key] = 0.0f;
+                break;
+            case HELD_FULL:
+                *held[key] = input.deltaTime;
+                break;
+            case HELD_REPEAT:
+                break;
+            default:
+                if (!this->read(held[key], sizeof(float))) {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    this->previous = input;
+    this->ticks++;
+    return true;
+}
+
+// Compara o hash do estado com o gravado nos passos múltiplos do intervalo
+bool InputReplay::verify(const Simulation &simulation) {
+    if (simulation.getTick() % this->header.hashInterval != 0) {
+        return true;
+    }
+
+    uint64_t expected = 0;
+    if (!this->read(&expected, sizeof(expected))) {
+        return true;
+    }
+    this->checks++;
+
+    if (simulation.hashState() == expected) {
+        return true;
+    }
+    if (this->divergences == 0) {
+        this->firstDivergence = this->ticks;
+        fprintf(stderr, "ERROR: A reproducao divergiu da gravacao no passo %llu.\n", (unsigned long long) this->ticks);
+    }
+    this->divergences++;
+    return false;
+}
+
+// Volta ao primeiro passo
+void InputReplay::rewind() {
+    this->offset = sizeof(RecordingHeader);
+    this->previous = SimulationInput();
+    this->ticks = 0;
+    this->checks = 0;
+    this->divergences = 0;
+    this->firstDivergence = 0;
+}
+
+bool InputReplay::isOpen() const {
+    return !this->data.empty();
+}
+
+uint64_t InputReplay::getTickCount() const {
+    return this->header.tickCount;
+}
+
+uint64_t InputReplay::getDivergences() const {
+    return this->divergences;
+}
+
+// Imprime o resultado das comparações de hash
+void InputReplay::printSummary() const {
+    if (!this->isOpen()) {
+        return;
+    }
+    if (this->divergences == 0) {
+        printf("Reproducao: %llu de %llu passos, %llu hashes conferidos, sem divergencias\n", (unsigned long long) this->ticks,
+               (unsigned long long) this->header.tickCount, (unsigned long long) this->checks);
+    }
+    else {
+        printf("Reproducao: %llu de %llu passos, %llu de %llu hashes divergentes (primeira no passo %llu)\n", (unsigned long long) this->ticks,
+               (unsigned long long) this->header.tickCount, (unsigned long long) this->divergences, (unsigned long long) this->checks,
+               (unsigned long long) this->firstDivergence);
+    }
+}
@@ -0,0 +1,207 @@
+#include "JobSystem.h"
+
+#include <cstdio>
+
+#include "Profiler.h"
+
+// Índice da thread atual no sistema de tarefas (a thread principal e threads externas usam a fila 0)
+static thread_local int jobWorkerIndex = 0;
+
+// Construtor - as threads são criadas em initialize()
+JobSystem::JobSystem() {
+    this->threadCount = 1;
+    this->running.store(false, std::memory_order_relaxed);
+    this->queuedJobs.store(0, std::memory_order_relaxed);
+    this->frames = 0;
+}
+
+JobSystem::~JobSystem() {
+    this->shutdown();
+}
+
+// Cria as filas e as threads auxiliares
+void JobSystem::initialize(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = (int) std::thread::hardware_concurrency();
+    }
+    this->threadCount = std::min(std::max(threadCount, 1), JOB_MAX_THREADS);
+
+    this->queues.reset(new JobQueue[this->threadCount]);
+    this->stats.reset(new JobWorkerStats[this->threadCount]);
+    this->frames = 0;
+
+    jobWorkerIndex = 0;
+    this->running.store(true, std::memory_order_release);
+    for (int worker = 1; worker < this->threadCount; worker++) {
+        this->threads.emplace_back(&JobSystem::workerLoop, this, worker);
+    }
+
+    printf("Sistema de tarefas: %d threads.\n", this->threadCount);
+}
+
+// Termina as threads e imprime a utilização média de cada uma
+void JobSystem::shutdown() {
+    if (!this->running.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+        this->running.store(false, std::memory_order_release);
+    }
+    this->wake.notify_all();
+    for (std::thread &thread : this->threads) {
+        thread.join();
+    }
+    this->threads.clear();
+
+    printf("Sistema de tarefas (%lu quadros):\n", this->frames);
+    for (int worker = 0; worker < this->threadCount; worker++) {
+        const JobWorkerStats &worker_stats = this->stats[worker];
+        double average = this->frames > 0 ? 100.0 * worker_stats.utilizationSum / (double) this->frames : 0.0;
+        printf("  thread %d: %5.1f%% de uso medio, %llu tarefas, %llu roubadas\n", worker, average,
+               (unsigned long long) worker_stats.jobs.load(std::memory_order_relaxed),
+               (unsigned long long) worker_stats.steals.load(std::memory_order_relaxed));
+    }
+}
+
+// Laço das threads auxiliares: executa tarefas próprias ou roubadas, e dorme quando não há nenhuma
+void JobSystem::workerLoop(int worker) {
+    jobWorkerIndex = worker;
+
+    while (this->running.load(std::memory_order_acquire)) {
+        Job job;
+        if (this->popJob(worker, job) || this->stealJob(worker, job)) {
+            this->execute(worker, job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(this->sleepMutex);
+        this->wake.wait(lock, [this]() {
+            return !this->running.load(std::memory_order_acquire) || this->queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+// Retira a tarefa mais recente da própria fila
+bool JobSystem::popJob(int worker, Job &job) {
+    JobQueue &queue = this->queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.tail) {
+        return false;
+    }
+    queue.tail--;
+    job = queue.jobs[queue.tail % JOB_QUEUE_CAPACITY];
+    this->queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+// Rouba a tarefa mais antiga da fila de outra thread
+bool JobSystem::stealJob(int worker, Job &job) {
+    for (int offset = 1; offset < this->threadCount; offset++) {
+        JobQueue &queue = this->queues[(worker + offset) % this->threadCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.head == queue.tail) {
+            continue;
+        }
+        job = queue.jobs[queue.head % JOB_QUEUE_CAPACITY];
+        queue.head++;
+        this->queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+        this->stats[worker].steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Executa uma tarefa, medindo o tempo ocupado da thread
+void JobSystem::execute(int worker, const Job &job) {
+    uint64_t begin = Profiler::now();
+    job.function(job.context, job.begin, job.end);
+    uint64_t end = Profiler::now();
+
+    JobWorkerStats &worker_stats = this->stats[worker];
+    worker_stats.busyNs.fetch_add(end - begin, std::memory_order_relaxed);
+    worker_stats.jobs.fetch_add(1, std::memory_order_relaxed);
+
+    if (job.counter != nullptr) {
+        job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+int JobSystem::currentWorker() const {
+    return jobWorkerIndex < this->threadCount ? jobWorkerIndex : 0;
+}
+
+// Enfileira uma tarefa na fila da thread atual
+void JobSystem::schedule(JobFunction function, void* context, size_t begin, size_t end, JobCounter* counter) {
+    Job job = {function, context, begin, end, counter};
+    if (counter != nullptr) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int worker = this->currentWorker();
+    bool queued = false;
+    if (this->threadCount > 1 && this->queues) {
+        JobQueue &queue = this->queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tail - queue.head < JOB_QUEUE_CAPACITY) {
+            queue.jobs[queue.tail % JOB_QUEUE_CAPACITY] = job;
+            queue.tail++;
+            queued = true;
+        }
+    }
+
+    // Sem threads auxiliares ou com a fila cheia, a tarefa é executada na hora
+    if (!queued) {
+        this->execute(worker, job);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+        this->queuedJobs.fetch_add(1, std::memory_order_acq_rel);
+    }
+    this->wake.notify_one();
+}
+
+// Executa tarefas (próprias ou roubadas) até que o contador chegue a zero
+void JobSystem::wait(JobCounter &counter) {
+    int worker = this->currentWorker();
+    while (counter.pending.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (this->threadCount > 1 && (this->popJob(worker, job) || this->stealJob(worker, job))) {
+            this->execute(worker, job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Utilização de cada thread no quadro que terminou
+void JobSystem::endFrame(double frameSeconds) {
+    if (!this->stats || frameSeconds <= 0.0) {
+        return;
+    }
+
+    for (int worker = 0; worker < this->threadCount; worker++) {
+        JobWorkerStats &worker_stats = this->stats[worker];
+        uint64_t busy = worker_stats.busyNs.load(std::memory_order_relaxed);
+        double fraction = (double) (busy - worker_stats.frameBusyNs) / (frameSeconds * 1e9);
+        worker_stats.frameBusyNs = busy;
+        worker_stats.utilization = (float) std::min(fraction, 1.0);
+        worker_stats.utilizationSum += worker_stats.utilization;
+    }
+    this->frames++;
+}
+
+int JobSystem::getThreadCount() const {
+    return this->threadCount;
+}
+
+float JobSystem::getUtilization(int worker) const {
+    if (!this->stats || worker < 0 || worker >= this->threadCount) {
+        return 0.0f;
+    }
+    return this->stats[worker].utilization;
+}
@@ -4,6 +4,7 @@
 
 #include "LoadedObj.h"
 #include <stdexcept>
+#include "Profiler.h"
 
 LoadedObj::LoadedObj(){
 
@@ -11,6 +12,8 @@ LoadedObj::LoadedObj(){
 
 LoadedObj::LoadedObj(const char* filename, const char* basepath, bool triangulate)
 {
+    PROFILE_SCOPE("LoadedObj::LoadedObj");
+
     printf("Carregando objetos do arquivo \"%s\"...\n", filename);
 
     // Se basepath == NULL, então setamos basepath como o dirname do
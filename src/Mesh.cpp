@@ -0,0 +1,264 @@
+#include "Mesh.h"
+
+#include <cassert>
+#include <limits>
+
+#include "matrices.h"
+#include "Profiler.h"
+
+// Carrega o OBJ, computa normais e envia a geometria para a GPU
+Mesh::Mesh(const char* path, std::map<std::string, SceneObject> &virtualScene, GeometryBuffer &geometry, bool keepCpuData) {
+    this->path = path;
+    this->vertexArrayObjectId = 0;
+    this->range = {0, 0, 0, 0};
+    this->gpuBytes = 0;
+
+    const float maxval = std::numeric_limits<float>::max();
+    this->bboxMin = glm::vec3(maxval, maxval, maxval);
+    this->bboxMax = glm::vec3(-maxval, -maxval, -maxval);
+
+    this->obj = LoadedObj(path);
+    this->cpuDataResident = true;
+    ComputeNormals(this->obj);
+    this->BuildTrianglesAndAddToVirtualScene(virtualScene, geometry);
+
+    if (!keepCpuData) {
+        this->releaseCpuData();
+    }
+}
+
+// Função que computa as normais de um ObjModel, caso elas não tenham sido especificadas.
+void Mesh::ComputeNormals(LoadedObj &obj)
+{
+    PROFILE_SCOPE("Mesh::ComputeNormals");
+
+    if ( !obj.attrib.normals.empty() )
+        return;
+
+    // Primeiro computamos as normais para todos os TRIÂNGULOS.
+    // Segundo, computamos as normais dos VÉRTICES através do método proposto por Gouraud.
+
+    size_t num_vertices = obj.attrib.vertices.size() / 3;
+
+    std::vector<int> num_triangles_per_vertex(num_vertices, 0);
+    std::vector<glm::vec4> vertex_normals(num_vertices, glm::vec4(0.0f,0.0f,0.0f,0.0f));
+
+    for (size_t shape = 0; shape < obj.shapes.size(); ++shape)
+    {
+        size_t num_triangles = obj.shapes[shape].mesh.num_face_vertices.size();
+
+        for (size_t triangle = 0; triangle < num_triangles; ++triangle)
+        {
+            assert(obj.shapes[shape].mesh.num_face_vertices[triangle] == 3);
+
+            glm::vec4  vertices[3];
+            for (size_t vertex = 0; vertex < 3; ++vertex)
+            {
+                tinyobj::index_t idx = obj.shapes[shape].mesh.indices[3*triangle + vertex];
+                const float vx = obj.attrib.vertices[3*idx.vertex_index + 0];
+                const float vy = obj.attrib.vertices[3*idx.vertex_index + 1];
+                const float vz = obj.attrib.vertices[3*idx.vertex_index + 2];
+                vertices[vertex] = glm::vec4(vx,vy,vz,1.0);
+            }
+
+            const glm::vec4  a = vertices[0];
+            const glm::vec4  b = vertices[1];
+            const glm::vec4  c = vertices[2];
+
+            const glm::vec4 n = crossproduct(b - a, c - a);
+
+            for (size_t vertex = 0; vertex < 3; ++vertex)
+            {
+                tinyobj::index_t idx = obj.shapes[shape].mesh.indices[3*triangle + vertex];
+                num_triangles_per_vertex[idx.vertex_index] += 1;
+                vertex_normals[idx.vertex_index] += n;
+                obj.shapes[shape].mesh.indices[3*triangle + vertex].normal_index = idx.vertex_index;
+            }
+        }
+    }
+
+    obj.attrib.normals.resize( 3*num_vertices );
+
+    for (size_t i = 0; i < vertex_normals.size(); ++i)
+    {
+        glm::vec4 n = vertex_normals[i] / (float)num_triangles_per_vertex[i];
+        n /= norm(n);
+        obj.attrib.normals[3*i + 0] = n.x;
+        obj.attrib.normals[3*i + 1] = n.y;
+        obj.attrib.normals[3*i + 2] = n.z;
+    }
+}
+
+// Constrói triângulos no formato de vértice comum a partir de um ObjModel, com os intervalos e limites de cada forma.
+void Mesh::BuildTriangles(const LoadedObj &obj, std::vector<StaticVertex> &vertices, std::vector<GLuint> &indices, std::vector<MeshShapeRange> &shapeRanges)
+{
+    vertices.clear();
+    indices.clear();
+    shapeRanges.clear();
+
+    for (size_t shape = 0; shape < obj.shapes.size(); ++shape)
+    {
+        size_t first_index = indices.size();
+        size_t num_triangles = obj.shapes[shape].mesh.num_face_vertices.size();
+
+        const float minval = std::numeric_limits<float>::min();
+        const float maxval = std::numeric_limits<float>::max();
+
+        glm::vec3 bbox_min = glm::vec3(maxval,maxval,maxval);
+        glm::vec3 bbox_max = glm::vec3(minval,minval,minval);
+
+        for (size_t triangle = 0; triangle < num_triangles; ++triangle)
+        {
+            assert(obj.shapes[shape].mesh.num_face_vertices[triangle] == 3);
+
+            for (size_t vertex = 0; vertex < 3; ++vertex)
+            {
+                tinyobj::index_t idx = obj.shapes[shape].mesh.indices[3*triangle + vertex];
+
+                // Índices relativos ao primeiro vértice da malha (somado por glDrawElementsBaseVertex)
+                indices.push_back(first_index + 3*triangle + vertex);
+
+                // Vértice no formato comum; normais e coordenadas de textura ausentes ficam zeradas
+                StaticVertex v = {};
+
+                const float vx = obj.attrib.vertices[3*idx.vertex_index + 0];
+                const float vy = obj.attrib.vertices[3*idx.vertex_index + 1];
+                const float vz = obj.attrib.vertices[3*idx.vertex_index + 2];
+                v.position[0] = vx; // X
+                v.position[1] = vy; // Y
+                v.position[2] = vz; // Z
+
+                bbox_min.x = std::min(bbox_min.x, vx);
+                bbox_min.y = std::min(bbox_min.y, vy);
+                bbox_min.z = std::min(bbox_min.z, vz);
+                bbox_max.x = std::max(bbox_max.x, vx);
+                bbox_max.y = std::max(bbox_max.y, vy);
+                bbox_max.z = std::max(bbox_max.z, vz);
+
+                if ( idx.normal_index != -1 )
+                {
+                    v.normal[0] = obj.attrib.normals[3*idx.normal_index + 0]; // X
+                    v.normal[1] = obj.attrib.normals[3*idx.normal_index + 1]; // Y
+                    v.normal[2] = obj.attrib.normals[3*idx.normal_index + 2]; // Z
+                }
+
+                if ( idx.texcoord_index != -1 )
+                {
+                    v.texcoord[0] = obj.attrib.texcoords[2*idx.texcoord_index + 0];
+                    v.texcoord[1] = obj.attrib.texcoords[2*idx.texcoord_index + 1];
+                }
+
+                vertices.push_back(v);
+            }
+        }
+
+        size_t last_index = indices.size() - 1;
+        shapeRanges.push_back({first_index, last_index - first_index + 1, bbox_min, bbox_max});
+    }
+}
+
+// Constrói triângulos para futura renderização a partir de um ObjModel.
+void Mesh::BuildTrianglesAndAddToVirtualScene(std::map<std::string, SceneObject> &virtualScene, GeometryBuffer &geometry)
+{
+    PROFILE_SCOPE("Mesh::BuildTrianglesAndAddToVirtualScene");
+
+    // Nomes, intervalos de índices e limites das formas, para criar os objetos da cena após o envio
+    std::vector<GLuint> indices;
+    std::vector<StaticVertex> vertices;
+    std::vector<MeshShapeRange> shapeRanges;
+    BuildTriangles(this->obj, vertices, indices, shapeRanges);
+
+    // Limites da malha: união das bounding boxes de todas as formas
+    for (const MeshShapeRange &shapeRange : shapeRanges)
+    {
+        this->bboxMin = glm::min(this->bboxMin, shapeRange.bbox_min);
+        this->bboxMax = glm::max(this->bboxMax, shapeRange.bbox_max);
+    }
+
+    // Sub-aloca a malha no buffer compartilhado
+    this->range = geometry.append(vertices.data(), vertices.size(), indices.data(), indices.size());
+    this->vertexArrayObjectId = geometry.getVertexArrayObject();
+    this->gpuBytes = vertices.size() * sizeof(StaticVertex) + indices.size() * sizeof(GLuint);
+
+    for (size_t shape = 0; shape < shapeRanges.size(); ++shape)
+    {
+        const MeshShapeRange &shapeRange = shapeRanges[shape];
+        SceneObject theobject((this->obj).shapes[shape].name,
+                              this->range.firstIndex + shapeRange.first_index,
+                              shapeRange.num_indices,
+                              GL_TRIANGLES,
+                              this->vertexArrayObjectId,
+                              shapeRange.bbox_min,
+                              shapeRange.bbox_max,
+                              this->range.baseVertex);
+
+        this->sceneObjectNames.push_back((this->obj).shapes[shape].name);
+        virtualScene[(this->obj).shapes[shape].name] = theobject;
+    }
+}
+
+// Descarta a geometria mantida na CPU, devolvendo a memória dos vetores do tinyobj
+void Mesh::releaseCpuData() {
+    LoadedObj empty;
+    std::swap(this->obj, empty);
+    this->cpuDataResident = false;
+}
+
+// Apenas esquece a região da malha: o GeometryBuffer não reaproveita espaço, que só volta quando o buffer
+// compartilhado inteiro é liberado pelo renderizador
+void Mesh::release() {
+    this->vertexArrayObjectId = 0;
+    this->gpuBytes = 0;
+}
+
+// Getters
+
+const std::string &Mesh::getPath() const {
+    return this->path;
+}
+
+const LoadedObj &Mesh::getObj() const {
+    return this->obj;
+}
+
+bool Mesh::isCpuDataResident() const {
+    return this->cpuDataResident;
+}
+
+GLuint Mesh::getVertexArrayObject() const {
+    return this->vertexArrayObjectId;
+}
+
+const GeometryRange &Mesh::getRange() const {
+    return this->range;
+}
+
+size_t Mesh::getGpuBytes() const {
+    return this->gpuBytes;
+}
+
+// Memória ocupada pela geometria mantida na CPU (atributos e índices das formas)
+size_t Mesh::getCpuBytes() const {
+    if (!this->cpuDataResident) {
+        return 0;
+    }
+
+    size_t bytes = (this->obj.attrib.vertices.size() + this->obj.attrib.normals.size() + this->obj.attrib.texcoords.size()) * sizeof(float);
+    for (const tinyobj::shape_t &shape : this->obj.shapes) {
+        bytes += shape.mesh.indices.size() * sizeof(tinyobj::index_t);
+        bytes += shape.mesh.num_face_vertices.size() * sizeof(unsigned char);
+    }
+    return bytes;
+}
+
+glm::vec3 Mesh::getBboxMin() const {
+    return this->bboxMin;
+}
+
+glm::vec3 Mesh::getBboxMax() const {
+    return this->bboxMax;
+}
+
+const std::vector<std::string> &Mesh::getSceneObjectNames() const {
+    return this->sceneObjectNames;
+}
@@ -0,0 +1,152 @@
+#include "Metrics.h"
+
+#include <algorithm>
+
+std::atomic<uint64_t> Metrics::current[COUNTER_COUNT];
+uint64_t Metrics::history[COUNTER_COUNT][METRICS_WINDOW];
+uint64_t Metrics::totals[COUNTER_COUNT];
+unsigned long Metrics::frames = 0;
+FILE* Metrics::csvFile = nullptr;
+const char* Metrics::jsonFilename = nullptr;
+double Metrics::exportInterval = METRICS_EXPORT_INTERVAL;
+double Metrics::lastExportTime = 0.0;
+
+// Finaliza o quadro
+void Metrics::endFrame() {
+    int slot = (int) (Metrics::frames % METRICS_WINDOW);
+
+    for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+        uint64_t value;
+
+        // Medidores mantêm o valor entre quadros; contadores são zerados
+        if (counter == COUNTER_ENEMIES_ALIVE) {
+            value = Metrics::current[counter].load(std::memory_order_relaxed);
+        }
+        else {
+            value = Metrics::current[counter].exchange(0, std::memory_order_relaxed);
+        }
+
+        Metrics::history[counter][slot] = value;
+        Metrics::totals[counter] += value;
+    }
+
+    Metrics::frames++;
+}
+
+// Estatísticas móveis dos últimos quadros
+CounterStats Metrics::stats(Counter counter) {
+    CounterStats result = {0, 0, 0, 0.0};
+
+    unsigned long count = std::min<unsigned long>(Metrics::frames, METRICS_WINDOW);
+    if (count == 0) {
+        return result;
+    }
+
+    result.last = Metrics::history[counter][(Metrics::frames - 1) % METRICS_WINDOW];
+    result.min = UINT64_MAX;
+
+    uint64_t sum = 0;
+    for (unsigned long i = 0; i < count; i++) {
+        uint64_t value = Metrics::history[counter][i];
+        result.min = std::min(result.min, value);
+        result.max = std::max(result.max, value);
+        sum += value;
+    }
+    result.avg = (double) sum / (double) count;
+
+    return result;
+}
+
+// Configura a exportação periódica
+void Metrics::configureExport(const char* csvFilename, const char* jsonFilename, double interval) {
+    Metrics::jsonFilename = jsonFilename;
+    Metrics::exportInterval = interval;
+
+    Metrics::csvFile = fopen(csvFilename, "w");
+    if (Metrics::csvFile == NULL) {
+        fprintf(stderr, "ERROR: Cannot open file \"%s\".\n", csvFilename);
+        return;
+    }
+
+    // Cabeçalho: para cada contador, o último valor e as estatísticas da janela
+    fprintf(Metrics::csvFile, "time,frame");
+    for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+        const char* name = counterName((Counter) counter);
+        fprintf(Metrics::csvFile, ",%s_last,%s_min,%s_avg,%s_max", name, name, name, name);
+    }
+    fprintf(Metrics::csvFile, "\n");
+}
+
+// Reescreve o resumo em JSON
+void Metrics::writeJson(double time) {
+    if (Metrics::jsonFilename == nullptr) {
+        return;
+    }
+
+    FILE* file = fopen(Metrics::jsonFilename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: Cannot open file \"%s\".\n", Metrics::jsonFilename);
+        return;
+    }
+
+    fprintf(file, "{\n  \"time\": %.3f,\n  \"frames\": %lu,\n  \"window\": %d,\n  \"counters\": {\n", time, Metrics::frames, METRICS_WINDOW);
+    for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+        CounterStats s = stats((Counter) counter);
+        fprintf(file, "    \"%s\": {\"last\": %llu, \"min\": %llu, \"avg\": %.3f, \"max\": %llu, \"total\": %llu}%s\n",
+                counterName((Counter) counter),
+                (unsigned long long) s.last, (unsigned long long) s.min, s.avg, (unsigned long long) s.max,
+                (unsigned long long) Metrics::totals[counter],
+                counter + 1 < COUNTER_COUNT ? "," : "");
+    }
+    fprintf(file, "  }\n}\n");
+    fclose(file);
+}
+
+// Exporta caso o intervalo tenha passado
+void Metrics::update(double time) {
+    if (time - Metrics::lastExportTime < Metrics::exportInterval) {
+        return;
+    }
+    Metrics::lastExportTime = time;
+
+    if (Metrics::csvFile != NULL) {
+        fprintf(Metrics::csvFile, "%.3f,%lu", time, Metrics::frames);
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+            CounterStats s = stats((Counter) counter);
+            fprintf(Metrics::csvFile, ",%llu,%llu,%.3f,%llu",
+                    (unsigned long long) s.last, (unsigned long long) s.min, s.avg, (unsigned long long) s.max);
+        }
+        fprintf(Metrics::csvFile, "\n");
+        fflush(Metrics::csvFile);
+    }
+
+    writeJson(time);
+}
+
+// Exportação final e fechamento dos arquivos
+void Metrics::shutdown(double time) {
+    Metrics::lastExportTime = time - Metrics::exportInterval;
+    update(time);
+
+    if (Metrics::csvFile != NULL) {
+        fclose(Metrics::csvFile);
+        Metrics::csvFile = nullptr;
+    }
+}
+
+// Nome de cada contador para exportação
+const char* Metrics::counterName(Counter counter) {
+    switch (counter) {
+        case COUNTER_DRAW_CALLS:            return "draw_calls";
+        case COUNTER_STATE_CHANGES:         return "state_changes";
+        case COUNTER_STATE_CHANGES_SKIPPED: return "state_changes_skipped";
+        case COUNTER_TRIANGLES:             return "triangles";
+        case COUNTER_INSTANCES_CULLED:      return "instances_culled";
+        case COUNTER_IMPOSTORS:             return "impostors";
+        case COUNTER_PAIR_TESTS:            return "pair_tests";
+        case COUNTER_ALLOCATIONS:           return "allocations";
+        case COUNTER_ENEMIES_ALIVE:         return "enemies_alive";
+        case COUNTER_ENEMIES_SPAWNED:       return "enemies_spawned";
+        default:                            return "unknown";
+    }
+}
@@ -0,0 +1,77 @@
+#include "Profiler.h"
+
+// Headers de C++
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+// Lista global de buffers - a trava só é usada no registro de uma nova thread e na exportação
+static std::mutex buffersMutex;
+static std::vector<ProfileBuffer*> buffers;
+
+// Buffer da thread atual, criado e registrado no primeiro uso.
+// Os buffers nunca são liberados, para que zonas de threads já finalizadas possam ser exportadas.
+ProfileBuffer &Profiler::threadBuffer() {
+    thread_local ProfileBuffer* buffer = nullptr;
+
+    if (buffer == nullptr) {
+        buffer = new ProfileBuffer();
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer->threadId = (uint32_t) buffers.size();
+        buffers.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+// Exporta as zonas registradas no formato "trace event" do Chrome
+bool Profiler::exportChromeTrace(const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: Cannot open file \"%s\".\n", filename);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    // Os instantes são exportados relativos à primeira zona registrada
+    uint64_t origin = UINT64_MAX;
+    for (ProfileBuffer* buffer : buffers) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t first = written > PROFILER_BUFFER_CAPACITY ? written - PROFILER_BUFFER_CAPACITY : 0;
+        for (uint64_t i = first; i < written; i++) {
+            uint64_t begin = buffer->zones[i & (PROFILER_BUFFER_CAPACITY - 1)].begin;
+            if (begin < origin) {
+                origin = begin;
+            }
+        }
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+
+    bool firstEvent = true;
+    for (ProfileBuffer* buffer : buffers) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t first = written > PROFILER_BUFFER_CAPACITY ? written - PROFILER_BUFFER_CAPACITY : 0;
+
+        for (uint64_t i = first; i < written; i++) {
+            const ProfileZone &zone = buffer->zones[i & (PROFILER_BUFFER_CAPACITY - 1)];
+
+            // Eventos completos ("X") em microssegundos
+            fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}",
+                    firstEvent ? "" : ",\n",
+                    zone.name,
+                    (double) (zone.begin - origin) / 1000.0,
+                    (double) (zone.end - zone.begin) / 1000.0,
+                    buffer->threadId);
+            firstEvent = false;
+        }
+    }
+
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+
+    printf("Trace de profiling exportado para \"%s\".\n", filename);
+    return true;
+}
@@ -0,0 +1,280 @@
+#include "ProjectileSystem.h"
+
+#include <algorithm>
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+#include "collisions.h"
+#include "Metrics.h"
+#include "Profiler.h"
+
+// Estado de cada projétil
+#define PROJECTILE_PIERCING 0x01  // Continua o voo após atingir um zumbi
+#define PROJECTILE_SPENT 0x02     // Terminou o voo no último passo: removido no próximo update()
+#define PROJECTILE_CONSUMED 0x04  // Gasto em um acerto: não causa mais dano nem é desenhado
+
+// Construtor - os vetores são alocados uma única vez com a capacidade máxima
+ProjectileSystem::ProjectileSystem() {
+    this->count = 0;
+    this->positions.resize(MAX_PROJECTILES);
+    this->origins.resize(MAX_PROJECTILES);
+    this->directions.resize(MAX_PROJECTILES);
+    this->paths.resize(MAX_PROJECTILES);
+    this->sweeps.resize(MAX_PROJECTILES);
+    this->halfSizes.resize(MAX_PROJECTILES);
+    this->speeds.resize(MAX_PROJECTILES);
+    this->ranges.resize(MAX_PROJECTILES);
+    this->lifetimes.resize(MAX_PROJECTILES);
+    this->damages.resize(MAX_PROJECTILES);
+    this->spins.resize(MAX_PROJECTILES);
+    this->distances.resize(MAX_PROJECTILES);
+    this->kinds.resize(MAX_PROJECTILES);
+    this->trajectories.resize(MAX_PROJECTILES);
+    this->flags.resize(MAX_PROJECTILES);
+    this->targets.resize(MAX_PROJECTILES * PROJECTILE_MAX_TARGETS);
+    this->targetCounts.resize(MAX_PROJECTILES);
+}
+
+void ProjectileSystem::clear() {
+    this->count = 0;
+}
+
+// Adiciona um projétil no final dos vetores
+bool ProjectileSystem::launch(const ProjectileLaunch &launch) {
+    if (this->count >= MAX_PROJECTILES || (launch.trajectory == TRAJECTORY_CURVE && launch.path.getSegmentCount() == 0)) {
+        return false;
+    }
+
+    size_t i = this->count++;
+    this->positions[i] = launch.origin;
+    this->origins[i] = launch.origin;
+    this->directions[i] = launch.direction;
+    this->sweeps[i] = glm::vec3(0.0f, 0.0f, 0.0f);
+    this->halfSizes[i] = launch.halfSize;
+    this->speeds[i] = launch.speed;
+    this->ranges[i] = launch.range;
+    this->lifetimes[i] = launch.lifetime;
+    this->damages[i] = launch.damage;
+    this->spins[i] = 0.0f;
+    this->distances[i] = 0.0f;
+    this->kinds[i] = launch.kind;
+    this->trajectories[i] = launch.trajectory;
+    this->flags[i] = launch.piercing ? PROJECTILE_PIERCING : 0;
+    this->targetCounts[i] = 0;
+    if (launch.trajectory == TRAJECTORY_CURVE) {
+        this->paths[i] = launch.path;
+    }
+    return true;
+}
+
+// Remove um projétil, trazendo o último para o seu índice
+void ProjectileSystem::remove(size_t index) {
+    size_t last = --this->count;
+    if (index == last) {
+        return;
+    }
+    this->positions[index] = this->positions[last];
+    this->origins[index] = this->origins[last];
+    this->directions[index] = this->directions[last];
+    this->paths[index] = this->paths[last];
+    this->sweeps[index] = this->sweeps[last];
+    this->halfSizes[index] = this->halfSizes[last];
+    this->speeds[index] = this->speeds[last];
+    this->ranges[index] = this->ranges[last];
+    this->lifetimes[index] = this->lifetimes[last];
+    this->damages[index] = this->damages[last];
+    this->spins[index] = this->spins[last];
+    this->distances[index] = this->distances[last];
+    this->kinds[index] = this->kinds[last];
+    this->trajectories[index] = this->trajectories[last];
+    this->flags[index] = this->flags[last];
+    this->targetCounts[index] = this->targetCounts[last];
+    std::copy_n(this->targets.begin() + (ptrdiff_t) (last * PROJECTILE_MAX_TARGETS), PROJECTILE_MAX_TARGETS,
+                this->targets.begin() + (ptrdiff_t) (index * PROJECTILE_MAX_TARGETS));
+}
+
+// Move o projétil em linha reta até "target" no plano XZ. O deslocamento é testado contra a caixa do cenário
+// reduzida pelos "raios" do projétil: se a bounding box sairia do cenário no meio do passo, ele para no ponto
+// de impacto. Retorna falso se o projétil atingiu a parede
+bool ProjectileSystem::move(size_t index, glm::vec3 target, glm::vec3 sceneryMin, glm::vec3 sceneryMax) {
+    glm::vec3 start = this->positions[index];
+    glm::vec3 displacement = glm::vec3(target.x - start.x, 0.0f, target.z - start.z);
+    glm::vec3 halfSize = glm::vec3(this->halfSizes[index].x, 0.0f, this->halfSizes[index].y);
+
+    float tEnter, tExit;
+    float timeOfImpact = 0.0f;
+    if (collisions::RayToBox(start, displacement, sceneryMin + halfSize, sceneryMax - halfSize, tEnter, tExit) && tEnter <= 0.0f) {
+        timeOfImpact = glm::clamp(tExit, 0.0f, 1.0f);
+    }
+
+    this->sweeps[index] = displacement * timeOfImpact;
+    this->positions[index] += this->sweeps[index];
+    return timeOfImpact >= 1.0f;
+}
+
+// Avança todos os projéteis em uma única passada
+void ProjectileSystem::update(float delta_t, bool isPaused, glm::vec3 sceneryMin, glm::vec3 sceneryMax) {
+    PROFILE_SCOPE("ProjectileSystem::update");
+
+    // Remove os projéteis que terminaram o voo (a ordem dos restantes só depende dos índices removidos)
+    for (size_t i = this->count; i-- > 0;) {
+        if (this->flags[i] & PROJECTILE_SPENT) {
+            this->remove(i);
+        }
+    }
+
+    uint64_t wallTests = 0;
+    for (size_t i = 0; i < this->count; i++) {
+        this->sweeps[i] = glm::vec3(0.0f, 0.0f, 0.0f);
+
+        // Caso esteja pausado, os projéteis ficam parados, mas continuam atingindo os zumbis
+        if (isPaused) {
+            continue;
+        }
+
+        glm::vec3 position = this->positions[i];
+        glm::vec3 origin = this->origins[i];
+        glm::vec3 target = position;
+        bool finished = false;
+
+        switch (this->trajectories[i]) {
+            case TRAJECTORY_CURVE: {
+                // Avança a mesma distância em qualquer trecho da curva, terminando no seu ponto final
+                const Trajectory &path = this->paths[i];
+                this->distances[i] += delta_t * this->speeds[i];
+                target = path.evaluate(this->distances[i]);
+                finished = this->distances[i] >= path.getLength();
+                break;
+            }
+            default:
+                target = position + this->directions[i] * delta_t * this->speeds[i];
+                break;
+        }
+
+        // Alcance: a linha reta termina (a curva termina no seu final)
+        if (this->trajectories[i] != TRAJECTORY_CURVE
+            && glm::distance(glm::vec2(target.x, target.z), glm::vec2(origin.x, origin.z)) > this->ranges[i]) {
+            finished = true;
+        }
+
+        // Tempo de voo
+        this->lifetimes[i] -= delta_t;
+        if (this->lifetimes[i] <= 0.0f) {
+            finished = true;
+        }
+
+        // O último deslocamento ainda é testado contra os zumbis e desenhado antes da remoção
+        if (!this->move(i, target, sceneryMin, sceneryMax) || finished) {
+            this->flags[i] |= PROJECTILE_SPENT;
+        }
+        this->spins[i] += 0.1f;
+        wallTests++;
+    }
+
+    // Um teste contra a caixa do cenário por projétil em movimento
+    Metrics::add(COUNTER_PAIR_TESTS, wallTests);
+}
+
+// Bounding box do projétil no início do último deslocamento, testada ao longo dele
+bool ProjectileSystem::sweep(size_t index, glm::vec3 cylinderBbox_min, glm::vec3 cylinderBbox_max, float &timeOfImpact) const {
+    if (this->flags[index] & PROJECTILE_CONSUMED) {
+        return false;
+    }
+
+    glm::vec3 halfSize = glm::vec3(this->halfSizes[index].x, 0.0f, this->halfSizes[index].y);
+    glm::vec3 start = this->positions[index] - this->sweeps[index];
+    return collisions::SweptCubeToCylinder(cylinderBbox_min, cylinderBbox_max, start - halfSize, start + halfSize,
+                                           this->sweeps[index], timeOfImpact);
+}
+
+// Acerto em um zumbi
+float ProjectileSystem::hit(size_t index, uint32_t enemyId) {
+    if (this->flags[index] & PROJECTILE_CONSUMED) {
+        return 0.0f;
+    }
+    if (!(this->flags[index] & PROJECTILE_PIERCING)) {
+        this->flags[index] |= PROJECTILE_CONSUMED | PROJECTILE_SPENT;
+        return this->damages[index];
+    }
+
+    // Perfurante: o dano é causado somente no primeiro passo em que o projétil atravessa o zumbi
+    if (this->hasHit(index, enemyId)) {
+        return 0.0f;
+    }
+    uint32_t &targetCount = this->targetCounts[index];
+    this->targets[index * PROJECTILE_MAX_TARGETS + targetCount % PROJECTILE_MAX_TARGETS] = enemyId;
+    targetCount++;
+    return this->damages[index];
+}
+
+// Procura o zumbi na lista do projétil
+bool ProjectileSystem::hasHit(size_t index, uint32_t enemyId) const {
+    uint32_t stored = std::min(this->targetCounts[index], (uint32_t) PROJECTILE_MAX_TARGETS);
+    const uint32_t* targets = this->targets.data() + index * PROJECTILE_MAX_TARGETS;
+    for (uint32_t i = 0; i < stored; i++) {
+        if (targets[i] == enemyId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ProjectileSystem::countKind(uint8_t kind) const {
+    size_t total = 0;
+    for (size_t i = 0; i < this->count; i++) {
+        total += this->kinds[i] == kind ? 1 : 0;
+    }
+    return total;
+}
+
+// Acumula bytes no hash FNV-1a de 64 bits (o mesmo de Simulation::hashState)
+static void HashBytes(uint64_t &hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+// Campos que influenciam os passos seguintes, somente dos projéteis vivos
+void ProjectileSystem::hash(uint64_t &hash) const {
+    HashBytes(hash, &this->count, sizeof(this->count));
+    HashBytes(hash, this->positions.data(), this->count * sizeof(glm::vec3));
+    HashBytes(hash, this->sweeps.data(), this->count * sizeof(glm::vec3));
+    HashBytes(hash, this->lifetimes.data(), this->count * sizeof(float));
+    HashBytes(hash, this->spins.data(), this->count * sizeof(float));
+    HashBytes(hash, this->distances.data(), this->count * sizeof(float));
+    HashBytes(hash, this->kinds.data(), this->count * sizeof(uint8_t));
+    HashBytes(hash, this->flags.data(), this->count * sizeof(uint8_t));
+    HashBytes(hash, this->targetCounts.data(), this->count * sizeof(uint32_t));
+    HashBytes(hash, this->targets.data(), this->count * PROJECTILE_MAX_TARGETS * sizeof(uint32_t));
+}
+
+size_t ProjectileSystem::getCount() const {
+    return this->count;
+}
+
+const glm::vec3* ProjectileSystem::getPositions() const {
+    return this->positions.data();
+}
+
+const glm::vec3* ProjectileSystem::getSweeps() const {
+    return this->sweeps.data();
+}
+
+const glm::vec2* ProjectileSystem::getHalfSizes() const {
+    return this->halfSizes.data();
+}
+
+const float* ProjectileSystem::getSpins() const {
+    return this->spins.data();
+}
+
+const uint8_t* ProjectileSystem::getKinds() const {
+    return this->kinds.data();
+}
+
+bool ProjectileSystem::isVisible(size_t index) const {
+    return !(this->flags[index] & PROJECTILE_CONSUMED);
+}
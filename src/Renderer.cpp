@@ -1,5 +1,9 @@
 #include "Renderer.h"
 #include "collisions.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
+#include "GLState.h"
+#include <random>
 
 // Definição de constantes para identificação de modelos
 #define SCENERY 0
@@ -7,14 +11,53 @@
 #define ZOMBIE 2
 #define BOOMERANG 3
 
+// Identificador dos obstáculos da arena no shader (não são modelos carregados de arquivo)
+#define OBSTACLE 4
+
 // Construtor do renderizador
 Renderer::Renderer() {
     this->gpuProgramID = 0;
     this->numLoadedTextures = 0;
+    this->gpuProgramAsset = nullptr;
+    this->hudProgramAsset = nullptr;
+    this->hordeCullProgramID = 0;
+    this->hordeCullProgramAsset = nullptr;
+    this->instanced_uniform = -1;
+    this->vat_info_uniform = -1;
+    this->projectileBufferId = 0;
+    this->gpuSimulation = false;
+    this->hordeFeedbackProgramID = 0;
+    this->hordeFeedbackProgramAsset = nullptr;
+    this->hordeSimulateProgramID = 0;
+    this->hordeSimulateProgramAsset = nullptr;
+    this->impostorProgramID = 0;
+    this->impostorProgramAsset = nullptr;
+    this->impostor_view_uniform = -1;
+    this->impostor_projection_uniform = -1;
+    this->impostor_size_uniform = -1;
+    this->impostor_grid_uniform = -1;
+    this->frameLimitMode = FRAME_LIMIT_FENCE;
+    for (GLsync &fence : this->frameFences) {
+        fence = nullptr;
+    }
+    this->frameIndex = 0;
+    this->hudProgramID = 0;
+    this->showHud = false;
+    for (int i = 0; i < HUD_HISTORY_SIZE; i++) {
+        this->cpuHistory[i] = 0.0f;
+        this->gpuHistory[i] = 0.0f;
+    }
+    this->historyIndex = 0;
+    this->fpsTimer = 0.0;
+    this->fpsFrames = 0;
+    this->fps = 0.0f;
 }
 
 // Inicializa o renderizador
 void Renderer::initialize() {
+    // O cache de estado parte do estado desconhecido do novo contexto
+    GLState::invalidate();
+
     // Habilitamos o Z-buffer.
     glEnable(GL_DEPTH_TEST);
 
@@ -22,20 +65,267 @@ void Renderer::initialize() {
     glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
     glFrontFace(GL_CCW);
+
+    // Cria as queries de tempo de GPU
+    this->gpuTimer.initialize("boomerang_frame_timings.csv");
+
+    // Resolve uma única vez o objeto da cena virtual de cada modelo, evitando buscas por nome durante o jogo
+    this->modelSceneObjects.clear();
+    for (Model &object : this->models) {
+        this->modelSceneObjects.push_back(&this->virtualScene.at(object.getName()));
+    }
+
+    // Caixa desenhada nos obstáculos da arena
+    this->CreateObstacleBox();
+
+    // Threads da simulação da horda
+    this->jobs.initialize();
+
+    // Regras do jogo, com as dimensões das malhas carregadas. O campo de direções e a grade de separação
+    // cobrem a bounding box do cenário no espaço do mundo
+    Model &scenery = this->models[SCENERY];
+    SimulationConfig config;
+    config.sceneryBboxMin = scenery.bbox_min;
+    config.sceneryBboxMax = scenery.bbox_max;
+    config.arenaMin = scenery.getPosition() + scenery.getMesh()->getBboxMin() * scenery.getScale();
+    config.arenaMax = scenery.getPosition() + scenery.getMesh()->getBboxMax() * scenery.getScale();
+    config.robotStart = this->models[ROBOT].getPosition();
+    config.robotDirection = this->models[ROBOT].getDirection();
+    config.robotHalfSize = glm::vec2(this->models[ROBOT].x_difference, this->models[ROBOT].z_difference);
+    config.zombieHalfSize = glm::vec2(this->models[ZOMBIE].x_difference, this->models[ZOMBIE].z_difference);
+    config.boomerangStart = this->models[BOOMERANG].getPosition();
+    config.boomerangHalfSize = glm::vec2(this->models[BOOMERANG].x_difference, this->models[BOOMERANG].z_difference);
+    config.animationRate = this->zombieAnimation.getHeader().cycleRate;
+    config.seed = std::random_device()();
+    this->simulation.initialize(config, &this->jobs);
+
+    // Buffers da horda, ligados ao VAO compartilhado
+    const Mesh* zombieMesh = this->models[ZOMBIE].getMesh();
+    // A horda simulada na GPU passa pelo mesmo descarte, então a capacidade cobre os dois caminhos
+    this->horde.initialize(this->staticGeometry, *this->modelSceneObjects[ZOMBIE], zombieMesh->getBboxMin(), zombieMesh->getBboxMax(), HORDE_SIM_CAPACITY, this->hordeCullProgramID);
+    this->hordeSimulation.initialize(HORDE_SIM_CAPACITY, this->hordeFeedbackProgramID, this->hordeSimulateProgramID);
+    this->simulatedInstances.reserve(HORDE_SIM_CAPACITY);
+
+    // Buffer dos projéteis, com a capacidade máxima do conjunto
+    glGenBuffers(1, &this->projectileBufferId);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->projectileBufferId);
+    glBufferData(GL_ARRAY_BUFFER, MAX_PROJECTILES * sizeof(ProjectileInstance), NULL, GL_DYNAMIC_DRAW);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    this->staticGeometry.setProjectileBuffer(this->projectileBufferId);
+
+    // Vistas dos impostores, capturadas uma única vez
+    this->CaptureImpostors();
+
+    // Envia o atlas de glifos do HUD, em uma unidade de textura após as texturas dos modelos
+    this->textRenderer.initialize(this->hudProgramID, this->numLoadedTextures);
+    this->numLoadedTextures += 1;
+}
+
+// Grava a entrada da partida, a partir do próximo passo
+bool Renderer::startRecording(const char* filename) {
+    return this->recorder.open(filename, this->simulation.getConfig());
+}
+
+// Reinicia a simulação com a configuração gravada e passa a reproduzir a entrada
+bool Renderer::startReplay(const char* filename) {
+    if (!this->replay.open(filename)) {
+        return false;
+    }
+    this->simulation.initialize(this->replay.getConfig(), &this->jobs);
+    return true;
+}
+
+// Finaliza o renderizador
+void Renderer::shutdown() {
+    this->recorder.close();
+    this->replay.printSummary();
+    this->gpuTimer.shutdown();
+    this->jobs.shutdown();
+    this->assets.printReport();
+    printf("Buffer de geometria compartilhado: %.1f KB reservados\n", (double) this->staticGeometry.getGpuBytes() / 1024.0);
+
+    // Os modelos apontam para malhas do registro: são descartados antes da liberação
+    this->models.clear();
+    this->modelSceneObjects.clear();
+    this->virtualScene.clear();
+
+    // Devolve as referências na ordem inversa do carregamento, enquanto o contexto ainda existe
+    for (auto asset = this->ownedAssets.rbegin(); asset != this->ownedAssets.rend(); ++asset) {
+        this->assets.release(*asset);
+    }
+    this->ownedAssets.clear();
+
+    this->assets.release(this->impostorProgramAsset);
+    this->assets.release(this->hordeSimulateProgramAsset);
+    this->assets.release(this->hordeFeedbackProgramAsset);
+    this->assets.release(this->hordeCullProgramAsset);
+    this->assets.release(this->hudProgramAsset);
+    this->assets.release(this->gpuProgramAsset);
+    this->impostorProgramAsset = nullptr;
+    this->hordeSimulateProgramAsset = nullptr;
+    this->hordeFeedbackProgramAsset = nullptr;
+    this->hordeCullProgramAsset = nullptr;
+    this->hudProgramAsset = nullptr;
+    this->gpuProgramAsset = nullptr;
+    this->impostorProgramID = 0;
+    this->hordeSimulateProgramID = 0;
+    this->hordeFeedbackProgramID = 0;
+    this->hordeCullProgramID = 0;
+    this->hudProgramID = 0;
+    this->gpuProgramID = 0;
+
+    if (this->projectileBufferId != 0) {
+        glDeleteBuffers(1, &this->projectileBufferId);
+        this->projectileBufferId = 0;
+    }
+    this->hordeSimulation.release();
+    this->horde.release();
+    this->impostorAtlas.release();
+    this->zombieAnimation.release();
+    this->textRenderer.release();
+    this->assets.shutdown();
+    this->staticGeometry.release();
+}
+
+// Carrega uma malha, enviando-a para a GPU somente se ela ainda não estiver no registro
+const Mesh* Renderer::LoadMesh(const char* path, bool keepCpuData) {
+    std::string key = AssetRegistry::makeKey(path, keepCpuData ? "keep_cpu" : "");
+
+    Asset* asset = this->assets.acquire(key);
+    if (asset == nullptr) {
+        asset = this->assets.add(key, ASSET_MESH);
+        asset->mesh = std::make_unique<Mesh>(path, this->virtualScene, this->staticGeometry, keepCpuData);
+    }
+
+    this->ownedAssets.push_back(asset);
+    return asset->mesh.get();
+}
+
+// Envia para o buffer compartilhado a caixa desenhada em cada obstáculo: base [-0.5, 0.5] em x e z, altura [0, 1]
+void Renderer::CreateObstacleBox() {
+    // Normal e dois eixos (u, v) de cada face; os vértices são centro + (±u ±v) / 2
+    const glm::vec3 normals[6] = {
+        glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+        glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+        glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+    };
+    const glm::vec3 center = glm::vec3(0.0f, 0.5f, 0.0f);
+    const float corners[4][2] = { {-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f} };
+
+    StaticVertex vertices[24];
+    GLuint indices[36];
+    for (int face = 0; face < 6; face++) {
+        glm::vec3 n = normals[face];
+        glm::vec3 up = (face == 2 || face == 3) ? glm::vec3(0.0f, 0.0f, -1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::vec3 u = glm::cross(up, n);
+        glm::vec3 v = glm::cross(n, u);
+
+        for (int corner = 0; corner < 4; corner++) {
+            glm::vec3 position = center + 0.5f * (n + corners[corner][0] * u + corners[corner][1] * v);
+            StaticVertex &vertex = vertices[face * 4 + corner];
+            vertex.position[0] = position.x;
+            vertex.position[1] = position.y;
+            vertex.position[2] = position.z;
+            vertex.normal[0] = n.x;
+            vertex.normal[1] = n.y;
+            vertex.normal[2] = n.z;
+            vertex.texcoord[0] = 0.5f * (corners[corner][0] + 1.0f);
+            vertex.texcoord[1] = 0.5f * (corners[corner][1] + 1.0f);
+        }
+
+        // Dois triângulos no sentido anti-horário, vistos de fora
+        const GLuint quad[6] = { 0, 1, 2, 0, 2, 3 };
+        for (int i = 0; i < 6; i++) {
+            indices[face * 6 + i] = (GLuint) (face * 4) + quad[i];
+        }
+    }
+
+    GeometryRange range = this->staticGeometry.append(vertices, 24, indices, 36);
+    this->obstacleBox = SceneObject("the_obstacle", range.firstIndex, range.indexCount, GL_TRIANGLES, this->staticGeometry.getVertexArrayObject(),
+                                    glm::vec3(-0.5f, 0.0f, -0.5f), glm::vec3(0.5f, 1.0f, 0.5f), range.baseVertex);
+}
+
+// Desenha os obstáculos da configuração da partida, escalando a caixa unitária para cada um
+void Renderer::DrawObstacles() {
+    const SimulationConfig &config = this->simulation.getConfig();
+    GLState::uniform1i(this->object_id_uniform, OBSTACLE);
+    for (int i = 0; i < config.obstacleCount; i++) {
+        glm::vec3 size = config.obstacleMax[i] - config.obstacleMin[i];
+        glm::vec3 base = glm::vec3(0.5f * (config.obstacleMin[i].x + config.obstacleMax[i].x), config.obstacleMin[i].y, 0.5f * (config.obstacleMin[i].z + config.obstacleMax[i].z));
+        glm::mat4 model = Matrix_TRS_Y(base, size, 0.0f);
+        GLState::uniformMatrix4fv(this->model_uniform, glm::value_ptr(model));
+        this->DrawVirtualObject(this->obstacleBox);
+    }
+}
+
+// Carrega um programa de GPU através do registro, devolvendo a referência anterior guardada em "asset"
+GLuint Renderer::LoadGpuProgram(const char* vertexFilename, const char* fragmentFilename, Asset* &asset, const char* const* feedbackVaryings, GLsizei feedbackCount,
+                                const char* geometryFilename)
+{
+    // Devolve a referência anterior primeiro: recarregar os shaders recompila o programa
+    this->assets.release(asset);
+
+    // Programas com transform feedback são linkados de forma diferente e não compartilham a chave
+    std::string key = AssetRegistry::makeKey(vertexFilename, feedbackCount > 0 ? "feedback" : "") + "|" + AssetRegistry::makeKey(fragmentFilename, "");
+    if (geometryFilename != nullptr) {
+        key += "|" + AssetRegistry::makeKey(geometryFilename, "geometry");
+    }
+
+    asset = this->assets.acquire(key);
+    if (asset == nullptr) {
+        GLuint vertex_shader_id = LoadShader_Vertex(vertexFilename);
+        GLuint fragment_shader_id = LoadShader_Fragment(fragmentFilename);
+        GLuint geometry_shader_id = geometryFilename != nullptr ? LoadShader_Geometry(geometryFilename) : 0;
+
+        asset = this->assets.add(key, ASSET_PROGRAM);
+        asset->programId = CreateGpuProgram(vertex_shader_id, fragment_shader_id, feedbackVaryings, feedbackCount, geometry_shader_id);
+    }
+
+    return asset->programId;
+}
+
+// Carrega um programa contendo somente um compute shader, através do registro
+GLuint Renderer::LoadComputeProgram(const char* filename, Asset* &asset)
+{
+    this->assets.release(asset);
+
+    std::string key = AssetRegistry::makeKey(filename, "compute");
+
+    asset = this->assets.acquire(key);
+    if (asset == nullptr) {
+        GLuint compute_shader_id = glCreateShader(GL_COMPUTE_SHADER);
+        this->LoadShader(filename, compute_shader_id);
+
+        GLuint program_id = glCreateProgram();
+        glAttachShader(program_id, compute_shader_id);
+        glLinkProgram(program_id);
+        glDeleteShader(compute_shader_id);
+
+        // Imprime no terminal qualquer erro de linkagem
+        GLint linked_ok = GL_FALSE;
+        glGetProgramiv(program_id, GL_LINK_STATUS, &linked_ok);
+        if ( linked_ok == GL_FALSE )
+        {
+            GLchar log[1024];
+            glGetProgramInfoLog(program_id, sizeof(log), NULL, log);
+            fprintf(stderr, "ERROR: OpenGL linking of program \"%s\" failed.\n== Start of link log\n%s\n== End of link log\n", filename, log);
+        }
+
+        asset = this->assets.add(key, ASSET_PROGRAM);
+        asset->programId = program_id;
+    }
+
+    return asset->programId;
 }
 
 // Função que carrega os shaders de vértices e de fragmentos que serão utilizados para renderização.
 void Renderer::LoadShadersFromFiles()
 {
-    GLuint vertex_shader_id = LoadShader_Vertex("../src/shaders/shader_vertex.glsl");
-    GLuint fragment_shader_id = LoadShader_Fragment("../src/shaders/shader_fragment.glsl");
+    PROFILE_SCOPE("Renderer::LoadShadersFromFiles");
 
-    // Deletamos o programa de GPU anterior, caso ele exista.
-    if (this->gpuProgramID != 0)
-        glDeleteProgram(this->gpuProgramID);
-
-    // Criamos um programa de GPU utilizando os shaders carregados acima.
-    this->gpuProgramID = CreateGpuProgram(vertex_shader_id, fragment_shader_id);
+    // Criamos um programa de GPU utilizando os shaders dos arquivos abaixo.
+    // O programa anterior, caso exista, é devolvido ao registro e deletado.
+    this->gpuProgramID = LoadGpuProgram("../src/shaders/shader_vertex.glsl", "../src/shaders/shader_fragment.glsl", this->gpuProgramAsset);
 
     // Buscamos o endereço das variáveis definidas dentro do Vertex Shader.
     // Utilizaremos estas variáveis para enviar dados para a placa de vídeo.
@@ -45,14 +335,39 @@ void Renderer::LoadShadersFromFiles()
     this->object_id_uniform  = glGetUniformLocation(this->gpuProgramID, "object_id"); // Variável "object_id" em shader_fragment.glsl
     this->bbox_min_uniform   = glGetUniformLocation(this->gpuProgramID, "bbox_min");
     this->bbox_max_uniform   = glGetUniformLocation(this->gpuProgramID, "bbox_max");
+    this->instanced_uniform  = glGetUniformLocation(this->gpuProgramID, "instanced"); // Matriz de modelo por instância (horda)
+    this->vat_info_uniform   = glGetUniformLocation(this->gpuProgramID, "vat_info"); // Animação por textura de vértices
 
     // Variáveis em "shader_fragment.glsl" para acesso das imagens de textura
-    glUseProgram(this->gpuProgramID);
-    glUniform1i(glGetUniformLocation(this->gpuProgramID, "PlaneTexture"), 0);
-    glUniform1i(glGetUniformLocation(this->gpuProgramID, "RobotTexture"), 1);
-    glUniform1i(glGetUniformLocation(this->gpuProgramID, "ZombieTexture"), 2);
-    glUniform1i(glGetUniformLocation(this->gpuProgramID, "BoomerangTexture"), 3);
-    glUseProgram(0);
+    GLState::useProgram(this->gpuProgramID);
+    GLState::uniform1i(glGetUniformLocation(this->gpuProgramID, "PlaneTexture"), 0);
+    GLState::uniform1i(glGetUniformLocation(this->gpuProgramID, "RobotTexture"), 1);
+    GLState::uniform1i(glGetUniformLocation(this->gpuProgramID, "ZombieTexture"), 2);
+    GLState::uniform1i(glGetUniformLocation(this->gpuProgramID, "BoomerangTexture"), 3);
+    GLState::useProgram(0);
+
+    // Programa de GPU do HUD
+    this->hudProgramID = LoadGpuProgram("../src/shaders/hud_vertex.glsl", "../src/shaders/hud_fragment.glsl", this->hudProgramAsset);
+
+    // Descarte da horda em GPU, somente com OpenGL 4.3
+    if (GLExtensions::computeSupported)
+        this->hordeCullProgramID = LoadComputeProgram("../src/shaders/horde_cull_compute.glsl", this->hordeCullProgramAsset);
+
+    // Simulação da horda em GPU: transform feedback sempre disponível, compute shader com OpenGL 4.3.
+    // O geometry shader emite somente os zumbis vivos, compactados no buffer capturado.
+    const char* feedbackVaryings[] = {"out_state0", "out_state1"};
+    this->hordeFeedbackProgramID = LoadGpuProgram("../src/shaders/horde_simulate_vertex.glsl", "../src/shaders/horde_reduce_fragment.glsl",
+                                                  this->hordeFeedbackProgramAsset, feedbackVaryings, 2,
+                                                  "../src/shaders/horde_simulate_geometry.glsl");
+    if (GLExtensions::computeSupported)
+        this->hordeSimulateProgramID = LoadComputeProgram("../src/shaders/horde_simulate_compute.glsl", this->hordeSimulateProgramAsset);
+
+    // Impostores dos zumbis distantes
+    this->impostorProgramID = LoadGpuProgram("../src/shaders/impostor_vertex.glsl", "../src/shaders/impostor_fragment.glsl", this->impostorProgramAsset);
+    this->impostor_view_uniform       = glGetUniformLocation(this->impostorProgramID, "view");
+    this->impostor_projection_uniform = glGetUniformLocation(this->impostorProgramID, "projection");
+    this->impostor_size_uniform       = glGetUniformLocation(this->impostorProgramID, "impostor_size");
+    this->impostor_grid_uniform       = glGetUniformLocation(this->impostorProgramID, "impostor_grid");
 }
 
 // Carrega um Vertex Shader de um arquivo GLSL.
@@ -81,6 +396,14 @@ GLuint Renderer::LoadShader_Fragment(const char* filename)
     return fragment_shader_id;
 }
 
+// Carrega um Geometry Shader de um arquivo GLSL.
+GLuint Renderer::LoadShader_Geometry(const char* filename)
+{
+    GLuint geometry_shader_id = glCreateShader(GL_GEOMETRY_SHADER);
+    this->LoadShader(filename, geometry_shader_id);
+    return geometry_shader_id;
+}
+
 // Função auxilar. Carrega código de GPU de um arquivo GLSL e faz sua compilação.
 void Renderer::LoadShader(const char* filename, GLuint shader_id)
 {
@@ -147,6 +470,23 @@ void Renderer::LoadShader(const char* filename, GLuint shader_id)
 // Função que carrega uma imagem para ser utilizada como textura
 void Renderer::LoadTextureImage(const char* filename)
 {
+    PROFILE_SCOPE("Renderer::LoadTextureImage");
+
+    // Texturas já carregadas são reaproveitadas, apenas ligadas a uma nova unidade de textura
+    std::string key = AssetRegistry::makeKey(filename, "srgb,mipmap");
+    Asset* asset = this->assets.acquire(key);
+    if (asset != nullptr)
+    {
+        GLuint textureunit = this->numLoadedTextures;
+        GLState::activeTexture(GL_TEXTURE0 + textureunit);
+        GLState::bindTexture(GL_TEXTURE_2D, asset->textureId);
+        GLState::bindSampler(textureunit, asset->samplerId);
+
+        this->ownedAssets.push_back(asset);
+        this->numLoadedTextures += 1;
+        return;
+    }
+
     printf("Carregando imagem \"%s\"... ", filename);
 
     // Primeiro fazemos a leitura da imagem do disco
@@ -185,19 +525,120 @@ void Renderer::LoadTextureImage(const char* filename)
     glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
 
     GLuint textureunit = this->numLoadedTextures;
-    glActiveTexture(GL_TEXTURE0 + textureunit);
-    glBindTexture(GL_TEXTURE_2D, texture_id);
+    GLState::activeTexture(GL_TEXTURE0 + textureunit);
+    GLState::bindTexture(GL_TEXTURE_2D, texture_id);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
-    glBindSampler(textureunit, sampler_id);
+    GLState::bindSampler(textureunit, sampler_id);
 
     stbi_image_free(data);
 
+    // GL_SRGB8 é armazenado com 4 bytes por texel pela maioria dos drivers; a cadeia de mipmaps soma 1/3
+    asset = this->assets.add(key, ASSET_TEXTURE);
+    asset->textureId = texture_id;
+    asset->samplerId = sampler_id;
+    asset->gpuBytes = (size_t) width * (size_t) height * 4 * 4 / 3;
+    this->ownedAssets.push_back(asset);
+
     this->numLoadedTextures += 1;
 }
 
+// Carrega a animação por textura de vértices dos zumbis. Sem ela, os zumbis são desenhados sem animação.
+void Renderer::LoadVertexAnimation(const char* filename)
+{
+    PROFILE_SCOPE("Renderer::LoadVertexAnimation");
+
+    // A animação foi gerada para a ordem de vértices da malha do zumbi
+    const Mesh* zombieMesh = nullptr;
+    for (Model &object : this->models) {
+        if (object.getId() == ZOMBIE) {
+            zombieMesh = object.getMesh();
+        }
+    }
+    if (zombieMesh == nullptr) {
+        fprintf(stderr, "ERROR: Animacao \"%s\" carregada antes da malha do zumbi.\n", filename);
+        return;
+    }
+
+    GLuint remapUnit = this->numLoadedTextures;
+    GLuint offsetUnit = this->numLoadedTextures + 1;
+    if (!this->zombieAnimation.load(filename, (GLuint) zombieMesh->getRange().vertexCount, remapUnit, offsetUnit)) {
+        return;
+    }
+    this->numLoadedTextures += 2;
+
+    const VatHeader &header = this->zombieAnimation.getHeader();
+    GLState::useProgram(this->gpuProgramID);
+    GLState::uniform1i(glGetUniformLocation(this->gpuProgramID, "ZombieAnimationRemap"), (GLint) remapUnit);
+    GLState::uniform1i(glGetUniformLocation(this->gpuProgramID, "ZombieAnimation"), (GLint) offsetUnit);
+    glUniform4i(this->vat_info_uniform, (GLint) header.positionCount, (GLint) header.frameCount, (GLint) header.width, zombieMesh->getRange().baseVertex);
+    GLState::useProgram(0);
+}
+
+// Renderiza o zumbi (sem animação) a partir de IMPOSTOR_VIEWS ângulos no atlas de impostores
+void Renderer::CaptureImpostors()
+{
+    PROFILE_SCOPE("Renderer::CaptureImpostors");
+
+    const Mesh* zombieMesh = this->models[ZOMBIE].getMesh();
+    if (!this->impostorAtlas.initialize(zombieMesh->getBboxMin(), zombieMesh->getBboxMax(), this->numLoadedTextures)) {
+        // Sem o atlas, todos os zumbis visíveis usam a malha
+        this->horde.toggleImpostors();
+        return;
+    }
+    this->numLoadedTextures += 1;
+
+    this->impostorAtlas.beginCapture();
+
+    GLState::useProgram(this->gpuProgramID);
+    GLState::bindVertexArray(this->staticGeometry.getVertexArrayObject());
+
+    glm::mat4 model = Matrix_Identity();
+    GLState::uniformMatrix4fv(this->model_uniform, glm::value_ptr(model));
+    GLState::uniform1i(this->instanced_uniform, 0);
+    GLState::uniform1i(this->object_id_uniform, ZOMBIE);
+
+    for (int view = 0; view < IMPOSTOR_VIEWS; view++) {
+        glm::mat4 viewMatrix;
+        glm::mat4 projection;
+        this->impostorAtlas.captureView(view, viewMatrix, projection);
+        GLState::uniformMatrix4fv(this->view_uniform, glm::value_ptr(viewMatrix));
+        GLState::uniformMatrix4fv(this->projection_uniform, glm::value_ptr(projection));
+        this->DrawVirtualObject(*this->modelSceneObjects[ZOMBIE]);
+    }
+
+    GLState::bindVertexArray(0);
+    this->impostorAtlas.endCapture();
+
+    GLState::useProgram(this->impostorProgramID);
+    GLState::uniform1i(glGetUniformLocation(this->impostorProgramID, "ImpostorAtlas"), (GLint) this->impostorAtlas.getTextureUnit());
+    GLState::useProgram(0);
+}
+
+// Desenha os impostores preparados pela horda, voltando ao VAO compartilhado e ao programa principal
+void Renderer::DrawImpostors(const glm::mat4 &view, const glm::mat4 &projection)
+{
+    if (!this->horde.hasImpostors()) {
+        return;
+    }
+
+    glm::vec3 scale = this->models[ZOMBIE].getScale();
+    GLState::useProgram(this->impostorProgramID);
+    GLState::uniformMatrix4fv(this->impostor_view_uniform, glm::value_ptr(view));
+    GLState::uniformMatrix4fv(this->impostor_projection_uniform, glm::value_ptr(projection));
+    GLState::uniform4f(this->impostor_size_uniform, this->impostorAtlas.getWidth() * scale.x,
+                       this->impostorAtlas.getHeight() * scale.y, this->impostorAtlas.getBottom() * scale.y, 0.0f);
+    GLState::uniform4f(this->impostor_grid_uniform, (float) IMPOSTOR_VIEWS, (float) IMPOSTOR_ATLAS_COLUMNS,
+                       (float) ((IMPOSTOR_VIEWS + IMPOSTOR_ATLAS_COLUMNS - 1) / IMPOSTOR_ATLAS_COLUMNS), 0.0f);
+    this->horde.drawImpostors();
+
+    GLState::bindVertexArray(this->staticGeometry.getVertexArrayObject());
+    GLState::useProgram(this->gpuProgramID);
+}
+
 // Esta função cria um programa de GPU, o qual contém obrigatoriamente um Vertex Shader e um Fragment Shader.
-GLuint Renderer::CreateGpuProgram(GLuint vertex_shader_id, GLuint fragment_shader_id)
+GLuint Renderer::CreateGpuProgram(GLuint vertex_shader_id, GLuint fragment_shader_id, const char* const* feedbackVaryings, GLsizei feedbackCount,
+                                  GLuint geometry_shader_id)
 {
     // Criamos um identificador (ID) para este programa de GPU
     GLuint program_id = glCreateProgram();
@@ -205,6 +646,14 @@ GLuint Renderer::CreateGpuProgram(GLuint vertex_shader_id, GLuint fragment_shade
     // Definição dos dois shaders GLSL que devem ser executados pelo programa
     glAttachShader(program_id, vertex_shader_id);
     glAttachShader(program_id, fragment_shader_id);
+    if (geometry_shader_id != 0) {
+        glAttachShader(program_id, geometry_shader_id);
+    }
+
+    // Saídas do último estágio antes da rasterização capturadas por transform feedback, intercaladas em um único buffer
+    if (feedbackCount > 0) {
+        glTransformFeedbackVaryings(program_id, feedbackCount, feedbackVaryings, GL_INTERLEAVED_ATTRIBS);
+    }
 
     // Linkagem dos shaders acima ao programa
     glLinkProgram(program_id);
@@ -241,257 +690,574 @@ GLuint Renderer::CreateGpuProgram(GLuint vertex_shader_id, GLuint fragment_shade
     // Os "Shader Objects" podem ser marcados para deleção após serem linkados
     glDeleteShader(vertex_shader_id);
     glDeleteShader(fragment_shader_id);
+    if (geometry_shader_id != 0) {
+        glDeleteShader(geometry_shader_id);
+    }
 
     // Retornamos o ID gerado acima
     return program_id;
 }
 
+// Setamos as variáveis "bbox_min" e "bbox_max" do fragment shader
+// com os parâmetros da axis-aligned bounding box (AABB) do modelo.
+void Renderer::SetBboxUniforms(const SceneObject &object)
+{
+    glm::vec3 bbox_min = object.bbox_min;
+    glm::vec3 bbox_max = object.bbox_max;
+    GLState::uniform4f(this->bbox_min_uniform, bbox_min.x, bbox_min.y, bbox_min.z, 1.0f);
+    GLState::uniform4f(this->bbox_max_uniform, bbox_max.x, bbox_max.y, bbox_max.z, 1.0f);
+}
+
 // Função que desenha um objeto armazenado em virtualScene.
-void Renderer::DrawVirtualObject(const char* object_name)
+// O VAO compartilhado das malhas estáticas já deve estar ligado (ver render()).
+void Renderer::DrawVirtualObject(const SceneObject &object)
 {
-    // "Ligamos" o VAO.
-    glBindVertexArray(this->virtualScene[object_name].vertex_array_object_id);
-
-    // Setamos as variáveis "bbox_min" e "bbox_max" do fragment shader
-    // com os parâmetros da axis-aligned bounding box (AABB) do modelo.
-    glm::vec3 bbox_min = this->virtualScene[object_name].bbox_min;
-    glm::vec3 bbox_max = this->virtualScene[object_name].bbox_max;
-    glUniform4f(this->bbox_min_uniform, bbox_min.x, bbox_min.y, bbox_min.z, 1.0f);
-    glUniform4f(this->bbox_max_uniform, bbox_max.x, bbox_max.y, bbox_max.z, 1.0f);
-
-    // GPU rasteriza os vértices dos eixos XYZ apontados pelo VAO como linhas.
-    glDrawElements(
-            this->virtualScene[object_name].rendering_mode,
-            this->virtualScene[object_name].num_indices,
+    this->SetBboxUniforms(object);
+
+    // Contadores do quadro
+    Metrics::add(COUNTER_DRAW_CALLS);
+    Metrics::add(COUNTER_TRIANGLES, object.num_indices / 3);
+
+    // GPU rasteriza os triângulos do objeto, cujos índices são relativos ao seu primeiro vértice no buffer compartilhado.
+    glDrawElementsBaseVertex(
+            object.rendering_mode,
+            object.num_indices,
             GL_UNSIGNED_INT,
-            (void*)(this->virtualScene[object_name].first_index * sizeof(GLuint))
+            (void*)(object.first_index * sizeof(GLuint)),
+            object.base_vertex
     );
+}
 
-    // "Desligamos" o VAO.
-    glBindVertexArray(0);
-}
-
-// Variáveis de controle de jogo
-bool boomerangIsThrown, secondaryAttackStarts, primaryAttackStarts = false;
-float rotationBoomerang = 0.0f;
-float t = 0.0f;
-int phase = 0;
-std::vector<enemyData> enemies;
-int enemiesKilled = 0;
-int enemiesSpawned = 0;
-
-// Atualiza o estado de jogo
-void updateGameStatus (int &phase, int &enemiesKilled, int &enemiesSpawned) {
-    // Caso atinja 16 inimigos mortos na fase 1, passa para a fase 2
-    if (phase == 0 && enemiesKilled == 16) {
-        phase++;
-        enemiesKilled = 0;
-        enemiesSpawned = 0;
-    }
-    // Caso atinja 32 inimigos mortos na fase 2, passa para a fase 3
-    if (phase == 1 && enemiesKilled == 32) {
-        phase++;
-        enemiesKilled = 0;
-        enemiesSpawned = 0;
-    }
-}
-
-// Gera inimigos a partir do estado de jogo
-void generateZombies (float &currentTime, float &spawnTime, float &x_difference, float &z_difference, bool &isPaused) {
-
-    float spawn_delta_t = currentTime - spawnTime;
-    float spawningTime = 5.0f - (float) phase; // Fase 1: 5s, Fase 2: 4s, Fase 3: 3s
-
-    // Caso tenha passado do tempo de spawn e não esteja pausado
-    if (spawn_delta_t >= spawningTime && !isPaused){
-        if ((phase == 0 && enemiesSpawned < 16)     // Fase 1 dura 16 inimigos
-            || (phase == 1 && enemiesSpawned < 32)  // Fase 2 dura 32 inimigos
-            || (phase == 2)) {                      // Fase 3 dura até a morte do jogador
-            for (int i = 0; i < 4; i++) {
-                enemyData newEnemy;
-                newEnemy.speed = 1.0f + (float) phase; // Fase 1: 1.0f, Fase 2: 2.0f, Fase 3: 3.0f
-                newEnemy.direction = glm::vec3(0.0f, 0.0f, 1.0f);
-
-                // Os zumbis são plotados nos quatro pontos cardeais simultaneamente.
-                if( i == 0) {
-                    newEnemy.position = glm::vec3(0.0f, 0.0f, -6.8f);
-                    newEnemy.bbox_max = glm::vec3(newEnemy.position.x + x_difference, newEnemy.position.y,
-                                                  newEnemy.position.z + z_difference);
-                    newEnemy.bbox_min = glm::vec3(newEnemy.position.x - x_difference, newEnemy.position.y,
-                                                  newEnemy.position.z - z_difference);
-                }
-                else if (i == 1) {
-                    newEnemy.position = glm::vec3(0.0f, 0.0f, 6.8f);
-                    newEnemy.bbox_max = glm::vec3(newEnemy.position.x + x_difference, newEnemy.position.y,
-                                                  newEnemy.position.z + z_difference);
-                    newEnemy.bbox_min = glm::vec3(newEnemy.position.x - x_difference, newEnemy.position.y,
-                                                  newEnemy.position.z - z_difference);
-                }
-                else if (i == 2) {
-                    newEnemy.position = glm::vec3(-6.8f, 0.0f, 0.0f);
-                    newEnemy.bbox_max = glm::vec3(newEnemy.position.x + x_difference, newEnemy.position.y,
-                                                  newEnemy.position.z + z_difference);
-                    newEnemy.bbox_min = glm::vec3(newEnemy.position.x - x_difference, newEnemy.position.y,
-                                                  newEnemy.position.z - z_difference);
-                }
-                else {
-                    newEnemy.position = glm::vec3(6.8f, 0.0f, 0.0f);
-                    newEnemy.bbox_max = glm::vec3(newEnemy.position.x + x_difference, newEnemy.position.y,
-                                                  newEnemy.position.z + z_difference);
-                    newEnemy.bbox_min = glm::vec3(newEnemy.position.x - x_difference, newEnemy.position.y,
-                                                  newEnemy.position.z - z_difference);
-                }
-                enemies.push_back(newEnemy);
-                enemiesSpawned++;
-            }
+// Espera o quadro mais antigo em voo, limitando quantos quadros o driver pode enfileirar
+void Renderer::waitQueuedFrames() {
+    PROFILE_SCOPE("Renderer::waitQueuedFrames");
+    GLsync &fence = this->frameFences[this->frameIndex % MAX_FRAMES_IN_FLIGHT];
+    if (fence != nullptr) {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+// Sinaliza o final da submissão do quadro
+void Renderer::markFrameSubmitted() {
+    if (this->frameLimitMode == FRAME_LIMIT_FINISH) {
+        glFinish();
+    }
+    else if (this->frameLimitMode == FRAME_LIMIT_FENCE) {
+        this->frameFences[this->frameIndex % MAX_FRAMES_IN_FLIGHT] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    this->frameIndex++;
+}
+
+// Alterna entre os modos de limitação de quadros enfileirados
+void Renderer::cycleFrameLimitMode() {
+    this->frameLimitMode = (this->frameLimitMode + 1) % 3;
+
+    const char* names[] = {"desligado", "fence", "glFinish"};
+    printf("Limitacao de quadros enfileirados: %s\n", names[this->frameLimitMode]);
+}
+
+// Mostra ou esconde o HUD de desempenho
+void Renderer::toggleHud() {
+    this->showHud = !this->showHud;
+}
+
+// Alterna o descarte da horda entre GPU e CPU
+void Renderer::toggleGpuCulling() {
+    this->horde.toggleGpuCulling();
+}
+
+// Liga ou desliga os impostores dos zumbis distantes
+void Renderer::toggleImpostors() {
+    if (!this->impostorAtlas.isReady()) {
+        printf("Impostores indisponiveis (atlas nao foi capturado).\n");
+        return;
+    }
+    this->horde.toggleImpostors();
+}
+
+// Alterna a simulação da horda entre GPU e CPU
+void Renderer::toggleGpuSimulation() {
+    // A horda na GPU não é determinística: a gravação e a reprodução exigem a simulação na CPU
+    if (this->recorder.isOpen() || this->replay.isOpen()) {
+        printf("Simulacao da horda na GPU indisponivel durante a gravacao ou reproducao\n");
+        return;
+    }
+
+    this->gpuSimulation = !this->gpuSimulation;
+    this->simulation.setCpuHorde(!this->gpuSimulation);
+
+    std::vector<enemyData> &enemies = this->simulation.getEnemies();
+    if (this->gpuSimulation) {
+        // Os inimigos atuais passam para o buffer de estado na GPU
+        for (const enemyData &enemy : enemies) {
+            this->hordeSimulation.spawn(enemy.position, enemy.direction, enemy.speed, enemy.animationPhase);
+        }
+        enemies.clear();
+    }
+    else {
+        // Leitura síncrona, feita somente na troca: a CPU continua com até MAX_ENEMIES zumbis
+        std::vector<HordeAgent> agents(MAX_ENEMIES);
+        GLuint count = this->hordeSimulation.readAlive(agents.data(), MAX_ENEMIES);
+
+        float x_difference = this->models[ZOMBIE].x_difference;
+        float z_difference = this->models[ZOMBIE].z_difference;
+        for (GLuint i = 0; i < count; i++) {
+            enemyData enemy;
+            enemy.position = glm::vec3(agents[i].state0);
+            enemy.speed = agents[i].state0.w;
+            enemy.direction = glm::vec3(cosf(agents[i].state1.x), 0.0f, sinf(agents[i].state1.x));
+            enemy.rotation = agents[i].state1.y;
+            enemy.animationPhase = agents[i].state1.w;
+            enemy.bbox_max = glm::vec3(enemy.position.x + x_difference, enemy.position.y, enemy.position.z + z_difference);
+            enemy.bbox_min = glm::vec3(enemy.position.x - x_difference, enemy.position.y, enemy.position.z - z_difference);
+            enemies.push_back(enemy);
         }
+    }
+
+    const char* path = this->hordeSimulation.isCompute() ? "GPU (compute shader)" : "GPU (transform feedback)";
+    printf("Simulacao da horda: %s\n", this->gpuSimulation ? path : "CPU");
+}
 
-        spawnTime = currentTime;
+// Cria uma onda massiva de zumbis na simulação em GPU
+void Renderer::spawnMassiveWave() {
+    if (!this->gpuSimulation) {
+        this->toggleGpuSimulation();
+        if (!this->gpuSimulation) {
+            return;
+        }
     }
-    // Caso esteja pausado, o tempo de spawn não é atualizado
-    if (isPaused) {
-        spawnTime += spawn_delta_t;
+
+    GLuint spawned = this->hordeSimulation.spawnWave(HORDE_SIM_WAVE_SIZE, 6.8f, 1.0f + (float) this->simulation.getPhase());
+    Metrics::add(COUNTER_ENEMIES_SPAWNED, spawned);
+    printf("Onda massiva: %u zumbis\n", spawned);
+}
+
+// Simula a horda na GPU e prepara o descarte do estado simulado; retorna falso se alguma leitura indicar que o robô foi atingido
+bool Renderer::RenderSimulatedHorde(Model &object, float delta_t, bool isPaused, const CameraMatrices &frame, float viewportHeight) {
+    // Os inimigos criados no quadro passam para o buffer de estado
+    std::vector<enemyData> &enemies = this->simulation.getEnemies();
+    for (const enemyData &enemy : enemies) {
+        this->hordeSimulation.spawn(enemy.position, enemy.direction, enemy.speed, enemy.animationPhase);
     }
+    enemies.clear();
+
+    // Reduções de quadros anteriores, já terminadas pela GPU
+    HordeSimulationResults results;
+    this->hordeSimulation.pollResults(results);
+    this->simulation.addKills((int) results.kills);
+    if (results.playerHits > 0) {
+        return false;
+    }
+
+    HordeSimulationInput input;
+    input.deltaTime = isPaused ? 0.0f : delta_t;
+    input.target = this->simulation.getRobot().position;
+    input.playerBboxMin = this->simulation.getRobot().bbox_min;
+    input.playerBboxMax = this->simulation.getRobot().bbox_max;
+
+    // Projéteis vivos, na posição do início do deslocamento do passo
+    const ProjectileSystem &projectiles = this->simulation.getProjectiles();
+    input.projectileCount = 0;
+    for (size_t i = 0; i < projectiles.getCount() && input.projectileCount < HORDE_SIM_MAX_PROJECTILES; i++) {
+        if (!projectiles.isVisible(i)) {
+            continue;
+        }
+        glm::vec3 sweep = projectiles.getSweeps()[i];
+        glm::vec3 start = projectiles.getPositions()[i] - sweep;
+        glm::vec2 halfSize = projectiles.getHalfSizes()[i];
+        input.projectileBoxes[input.projectileCount] = glm::vec4(start.x, start.z, halfSize.x, halfSize.y);
+        input.projectileSweeps[input.projectileCount] = glm::vec4(sweep.x, sweep.z, 0.0f, 0.0f);
+        input.projectileCount++;
+    }
+
+    input.xDifference = object.x_difference;
+    input.zDifference = object.z_difference;
+    input.animationRate = this->zombieAnimation.getHeader().cycleRate;
+    this->hordeSimulation.simulate(input);
+
+    const Mesh* zombieMesh = object.getMesh();
+    float zombieHeight = zombieMesh->getBboxMax().y - zombieMesh->getBboxMin().y;
+
+    // Descarte em GPU: o compute shader lê o buffer de estado recém-escrito, sem cópia para a CPU
+    if (this->horde.isGpuCulling()) {
+        this->horde.prepareSimulated(this->hordeSimulation.getStateBuffer(), this->hordeSimulation.getSlotCount(),
+                                     object.getScale(), zombieHeight, frame, viewportHeight);
+        return true;
+    }
+
+    // Descarte na CPU (OpenGL 3.3): cópia do estado de alguns quadros antes, lida sem esperar a GPU
+    this->hordeSimulation.queueStateCopy();
+    GLuint slotCount = 0;
+    const HordeAgent* agents = this->hordeSimulation.getStateCopy(slotCount);
+    this->simulatedInstances.clear();
+    for (GLuint i = 0; i < slotCount; i++) {
+        if (agents[i].state1.z != 0.0f) {
+            this->simulatedInstances.push_back({glm::vec4(glm::vec3(agents[i].state0), agents[i].state1.y),
+                                                glm::vec4(agents[i].state1.w, 0.0f, 0.0f, 0.0f)});
+        }
+    }
+    this->horde.prepare(this->simulatedInstances.data(), (GLuint) this->simulatedInstances.size(), object.getScale(),
+                        zombieHeight, frame, viewportHeight);
+
+    return true;
+}
+
+// Desenha todos os projéteis vivos com a malha do bumerangue (as balas em escala reduzida), em uma única chamada.
+// O VAO compartilhado já deve estar ligado (ver render())
+void Renderer::DrawProjectiles(Model &object) {
+    const ProjectileSystem &projectiles = this->simulation.getProjectiles();
+    if (projectiles.getCount() == 0) {
+        return;
+    }
+    ProjectileInstance* instances = this->frameArena.allocateArray<ProjectileInstance>(projectiles.getCount());
+    GLsizei instanceCount = 0;
+
+    glm::vec3 scale = object.getScale();
+    for (size_t i = 0; i < projectiles.getCount(); i++) {
+        if (!projectiles.isVisible(i)) {
+            continue;
+        }
+        glm::vec3 instanceScale = projectiles.getKinds()[i] == PROJECTILE_BULLET ? scale * PISTOL_BULLET_SCALE : scale;
+        instances[instanceCount].positionSpin = glm::vec4(projectiles.getPositions()[i], projectiles.getSpins()[i]);
+        instances[instanceCount].scaleTilt = glm::vec4(instanceScale, object.getRotation());
+        instanceCount++;
+    }
+    if (instanceCount == 0) {
+        return;
+    }
+
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->projectileBufferId);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr) (instanceCount * sizeof(ProjectileInstance)), instances);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    const SceneObject &sceneObject = *this->modelSceneObjects[object.getId()];
+    GLState::uniform1i(this->instanced_uniform, 3);
+    GLState::uniform1i(this->object_id_uniform, object.getId());
+    this->SetBboxUniforms(sceneObject);
+    this->staticGeometry.setProjectileAttributesEnabled(true);
+
+    Metrics::add(COUNTER_DRAW_CALLS);
+    Metrics::add(COUNTER_TRIANGLES, (uint64_t) (sceneObject.num_indices / 3) * (uint64_t) instanceCount);
+    glDrawElementsInstancedBaseVertex(sceneObject.rendering_mode,
+                                      (GLsizei) sceneObject.num_indices,
+                                      GL_UNSIGNED_INT,
+                                      (void*) (sceneObject.first_index * sizeof(GLuint)),
+                                      instanceCount,
+                                      sceneObject.base_vertex);
+
+    this->staticGeometry.setProjectileAttributesEnabled(false);
+    GLState::uniform1i(this->instanced_uniform, 0);
+}
+
+// Desenha o HUD de desempenho em um único lote
+void Renderer::DrawHud(int width, int height) {
+    PROFILE_SCOPE("Renderer::DrawHud");
+
+    char line[128];
+    float x = 10.0f;
+    float y = 10.0f + this->textRenderer.lineHeight();
+    float lineHeight = this->textRenderer.lineHeight();
+    glm::vec4 white = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+
+    this->textRenderer.begin(width, height);
+
+    // Fundo semitransparente
+    this->textRenderer.addRect(5.0f, 5.0f, 2.0f * HUD_HISTORY_SIZE + 10.0f, 8.0f * lineHeight + 70.0f, glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+
+    snprintf(line, sizeof(line), "FPS: %.1f", this->fps);
+    this->textRenderer.addText(line, x, y, white);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "CPU: %.2f ms  GPU: %.2f ms", this->gpuTimer.getCpuMs(), this->gpuTimer.getGpuMs());
+    this->textRenderer.addText(line, x, y, white);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "Draw calls: %llu  Triangulos: %llu",
+             (unsigned long long) Metrics::get(COUNTER_DRAW_CALLS), (unsigned long long) Metrics::get(COUNTER_TRIANGLES));
+    this->textRenderer.addText(line, x, y, white);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "Inimigos: %zu%s  Colisoes: %llu", this->gpuSimulation ? (size_t) this->hordeSimulation.getAliveCount() : this->simulation.getEnemies().size(),
+             this->gpuSimulation ? " (GPU)" : "", (unsigned long long) Metrics::get(COUNTER_PAIR_TESTS));
+    this->textRenderer.addText(line, x, y, white);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "Descartados: %llu (%s)  Impostores: %llu%s",
+             (unsigned long long) Metrics::get(COUNTER_INSTANCES_CULLED), this->horde.isGpuCulling() ? "GPU" : "CPU",
+             (unsigned long long) Metrics::get(COUNTER_IMPOSTORS), this->horde.isUsingImpostors() ? "" : " (desligados)");
+    this->textRenderer.addText(line, x, y, white);
+    y += lineHeight;
+
+    snprintf(line, sizeof(line), "Estado GL: %llu  Evitadas: %llu",
+             (unsigned long long) Metrics::get(COUNTER_STATE_CHANGES), (unsigned long long) Metrics::get(COUNTER_STATE_CHANGES_SKIPPED));
+    this->textRenderer.addText(line, x, y, white);
+    y += lineHeight;
+
+    // Utilização de cada thread do sistema de tarefas no último quadro
+    int written = snprintf(line, sizeof(line), "Threads:");
+    for (int worker = 0; worker < this->jobs.getThreadCount() && written < (int) sizeof(line); worker++) {
+        written += snprintf(line + written, sizeof(line) - written, " %.0f%%", 100.0f * this->jobs.getUtilization(worker));
+    }
+    this->textRenderer.addText(line, x, y, white);
+    y += lineHeight;
+
+    // Gráfico de tempos de quadro: 33.3 ms ocupam a altura total, com uma linha de referência em 16.7 ms
+    float graphHeight = 60.0f;
+    float graphBottom = y + graphHeight - lineHeight * 0.5f;
+    float msToPixels = graphHeight / 33.3f;
+    this->textRenderer.addRect(x, graphBottom - 16.7f * msToPixels, 2.0f * HUD_HISTORY_SIZE, 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
+
+    for (int i = 0; i < HUD_HISTORY_SIZE; i++) {
+        int index = (this->historyIndex + i) % HUD_HISTORY_SIZE;
+        float cpuHeight = std::min(this->cpuHistory[index] * msToPixels, graphHeight);
+        float gpuHeight = std::min(this->gpuHistory[index] * msToPixels, graphHeight);
+        float barX = x + 2.0f * (float) i;
+
+        this->textRenderer.addRect(barX, graphBottom - cpuHeight, 1.0f, cpuHeight, glm::vec4(0.2f, 0.9f, 0.2f, 0.9f));
+        this->textRenderer.addRect(barX + 1.0f, graphBottom - gpuHeight, 1.0f, gpuHeight, glm::vec4(1.0f, 0.6f, 0.1f, 0.9f));
+    }
+
+    // O HUD é desenhado por cima da cena, com transparência
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    size_t triangles = this->textRenderer.flush();
+    Metrics::add(COUNTER_DRAW_CALLS);
+    Metrics::add(COUNTER_TRIANGLES, triangles);
+
+    glDisable(GL_BLEND);
+    glEnable(GL_CULL_FACE);
+    glEnable(GL_DEPTH_TEST);
 }
 
 // Renderiza a cena
-bool Renderer::render(GLFWwindow* window, bool isPaused, Camera &camera, const float &aspectRatio, float &initialTime, float &spawnTime) {
-    // Define a cor de "fundo" do framebuffer como branco.
-    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+bool Renderer::render(GLFWwindow* window, bool isPaused, Camera &camera, InputQueue &input, const float &aspectRatio, float &initialTime) {
+    PROFILE_SCOPE("Renderer::render");
 
-    // "Pintamos" todos os pixels do framebuffer com a cor definida acima,
-    // e também resetamos todos os pixels do Z-buffer (depth buffer).
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // Espera a GPU alcançar a CPU antes de amostrar a entrada, para que ela seja a mais recente possível
+    this->waitQueuedFrames();
 
-    // Pedimos para a GPU utilizar o programa de GPU criado acima (contendo
-    // os shaders de vértice e fragmentos).
-    glUseProgram(this->gpuProgramID);
+    // Início da medição de tempo de CPU e GPU do quadro, e das alocações do quadro
+    double frameStartTime = glfwGetTime();
+    AllocationTracker::beginFrame();
+    this->frameArena.reset();
+    this->gpuTimer.beginFrame();
 
-    // Enviamos as matrizes "view" e "projection" para a placa de vídeo.
-    glUniformMatrix4fv(this->view_uniform       , 1 , GL_FALSE , glm::value_ptr(camera.getView()));
-    glUniformMatrix4fv(this->projection_uniform , 1 , GL_FALSE , glm::value_ptr(camera.getPerspective(aspectRatio)));
+    // Verifica interrupção e recebe os eventos de entrada pendentes
+    {
+        PROFILE_SCOPE("glfwPollEvents");
+        glfwPollEvents();
+    }
 
     // Variáveis ligadas a movimentação baseada em tempo
     float currentTime = glfwGetTime();
     float delta_t = currentTime - initialTime;
+
+    // Consome os eventos do passo de simulação atual
+    input.consume(camera, initialTime, currentTime);
     initialTime = currentTime;
 
-    // Atualiza o estado de jogo
-    updateGameStatus (phase, enemiesKilled, enemiesSpawned);
+    // Define a cor de "fundo" do framebuffer como branco.
+    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+
+    // "Pintamos" todos os pixels do framebuffer com a cor definida acima,
+    // e também resetamos todos os pixels do Z-buffer (depth buffer).
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Pedimos para a GPU utilizar o programa de GPU criado acima (contendo
+    // os shaders de vértice e fragmentos).
+    GLState::useProgram(this->gpuProgramID);
 
-    // Cria os inimigos a partir do estado de jogo
-    generateZombies (currentTime,
-                     spawnTime,
-                     this->models[ZOMBIE].x_difference,
-                     this->models[ZOMBIE].z_difference,
-                     isPaused);
+    // "Latch" tardio do cursor: aplica o movimento mais recente do mouse logo antes da submissão
+    glfwPollEvents();
+    input.latchCursor(camera);
 
     // Atualiza a câmera
-    camera.updateCamera(delta_t);
+    camera.updateCamera();
+
+    // Passo de simulação a partir das teclas consumidas, incluindo cliques pressionados e soltos dentro do passo
+    SimulationInput step;
+    step.deltaTime = delta_t;
+    step.paused = isPaused;
+    step.heldW = camera.keys.heldW;
+    step.heldA = camera.keys.heldA;
+    step.heldS = camera.keys.heldS;
+    step.heldD = camera.keys.heldD;
+    step.attackPrimary = camera.keys.M1 || camera.keys.pressedM1;
+    step.attackSecondary = camera.keys.M2 || camera.keys.pressedM2;
+    step.attackPistol = camera.keys.F || camera.keys.pressedF;
+    step.viewDirection = glm::vec3(camera.getViewVector());
+
+    // Na reprodução, a entrada gravada substitui a do usuário (a câmera continua livre); ao final, o jogo termina
+    if (this->replay.isOpen()) {
+        if (!this->replay.next(step)) {
+            return false;
+        }
+    }
+    else {
+        this->recorder.record(step);
+    }
 
-    // Checa se foi realizado um ataque
-    if (camera.keys.M1 || camera.keys.M2) {
-        boomerangIsThrown = true;
+    // Caso o robô seja atingido por um zumbi, retorna falso
+    bool robotAlive = this->simulation.step(step);
+    this->recorder.recordState(this->simulation);
+    if (this->replay.isOpen()) {
+        this->replay.verify(this->simulation);
+    }
+    if (!robotAlive) {
+        return false;
     }
 
+    // A câmera acompanha o robô (a câmera livre fica parada quando o robô colide com o cenário)
+    const SimulationBody &robot = this->simulation.getRobot();
+    if (!this->simulation.isRobotBlocked()) {
+        camera.updateCartesianCoordinates(glm::vec4(robot.position.x, robot.position.y + 0.7f, robot.position.z, 1.0f));
+    }
+    if (!camera.isUseFreeCamera()) {
+        camera.setLookAt(glm::vec4(robot.position.x, robot.position.y + 0.7f, robot.position.z, 1.0f));
+    }
+
+    // Enviamos as matrizes "view" e "projection" para a placa de vídeo.
+    // As matrizes só são recalculadas se a câmera ou a proporção da janela mudaram desde o quadro anterior
+    const CameraMatrices frame = camera.snapshot(aspectRatio);
+    int framebufferWidth, framebufferHeight;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    GLState::uniformMatrix4fv(this->view_uniform       , glm::value_ptr(frame.view));
+    GLState::uniformMatrix4fv(this->projection_uniform , glm::value_ptr(frame.projection));
+
     glm::mat4 model = Matrix_Identity();
 
+    // Todas as malhas estáticas estão no mesmo buffer: o VAO é ligado uma única vez por quadro
+    GLState::bindVertexArray(this->staticGeometry.getVertexArrayObject());
+
     // Renderiza todos os modelos
     for (Model &object : this->models) {
 
         // Se é o bumerange
         if (object.getId() == BOOMERANG) {
-            glm::vec3 robotPosition = glm::vec3(this->models[ROBOT].getPosition().x,
-                                                this->models[ROBOT].getPosition().y,
-                                                this->models[ROBOT].getPosition().z);
-
-            // Atualiza posição do bumerange caso esteja em condição de ataque
-            if (object.updateBoomerang(boomerangIsThrown,
-                                       primaryAttackStarts,
-                                       secondaryAttackStarts,
-                                       camera.keys.M1,
-                                       camera.keys.M2,
-                                       isPaused,
-                                       rotationBoomerang,
-                                       t,
-                                       delta_t,
-                                       robotPosition,
-                                       this->models[ROBOT].getRotation(),
-                                       this->models[SCENERY].bbox_min,
-                                       this->models[SCENERY].bbox_max,
-                                       model)) {
-                glUniformMatrix4fv(this->model_uniform, 1, GL_FALSE, glm::value_ptr(model));
-                glUniform1i(this->object_id_uniform, object.getId());
-                this->DrawVirtualObject(object.getName().c_str());
-            }
+            PROFILE_SCOPE("Renderer::render boomerang");
+            this->gpuTimer.beginPass(GPU_PASS_BOOMERANG);
+
+            // Bumerangues e balas em voo
+            this->DrawProjectiles(object);
+            this->gpuTimer.endPass(GPU_PASS_BOOMERANG);
         }
         // Se é o zumbi
         else if (object.getId() == ZOMBIE) {
+            PROFILE_SCOPE("Renderer::render horde");
+            this->gpuTimer.beginPass(GPU_PASS_HORDE);
 
-            float x_difference = this->models[ZOMBIE].x_difference;
-            float z_difference = this->models[ZOMBIE].z_difference;
-
-            for (int i = 0; i < enemies.size(); i++) {
-
-                // Caso o robô seja atingido pelo zumbi, retorna falso
-                if (collisions::CylinderToCylinder(enemies[i].bbox_min, enemies[i].bbox_max, this->models[ROBOT].bbox_min, this->models[ROBOT].bbox_max)) {
+            // Horda simulada na GPU: colisões lidas com atraso
+            if (this->gpuSimulation) {
+                if (!this->RenderSimulatedHorde(object, delta_t, isPaused, frame, (float) framebufferHeight)) {
+                    this->gpuTimer.endPass(GPU_PASS_HORDE);
                     return false;
                 }
-                // Caso o bumerange atinja o zumbi, ele morre
-                if (collisions::CubeToCylinder(enemies[i].bbox_min, enemies[i].bbox_max, this->models[BOOMERANG].bbox_min, this->models[BOOMERANG].bbox_max)
-                    && (primaryAttackStarts || secondaryAttackStarts)) {
-                    enemies.erase(enemies.begin() + i);
-                    enemiesKilled++;
-                    continue;
-                }
-
-                glm::vec3 playerDirection = normalize(this->models[ROBOT].getPosition() - enemies[i].position);
-
-                // Caso esteja pausado, os zumbis não se movem
-                if (!isPaused) {
-                    enemies[i].position = enemies[i].position + playerDirection * delta_t * enemies[i].speed;
-                }
-
-                // Atualiza a bounding box do zumbi
-                enemies[i].bbox_max = glm::vec3(enemies[i].position.x + x_difference, enemies[i].position.y, enemies[i].position.z + z_difference);
-                enemies[i].bbox_min = glm::vec3(enemies[i].position.x - x_difference, enemies[i].position.y, enemies[i].position.z - z_difference);
-                enemies[i].rotation = atan2f(enemies[i].direction.z, enemies[i].direction.x) - atan2f(playerDirection.z, playerDirection.x);
+            }
+            else {
+                // Posição, rotação e fase da animação dos zumbis simulados no passo, enviadas para o desenho
+                // instanciado; a matriz de modelo é montada no descarte (CPU ou compute shader)
+                const std::vector<enemyData> &enemies = this->simulation.getEnemies();
+                HordeInstance* hordeInstances = this->frameArena.allocateArray<HordeInstance>(enemies.size());
+                GLuint hordeCount = (GLuint) enemies.size();
+                this->jobs.parallelFor(enemies.size(), JOB_DEFAULT_GRAIN, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        hordeInstances[i].positionYaw = glm::vec4(enemies[i].position, enemies[i].rotation);
+                        hordeInstances[i].animation = glm::vec4(enemies[i].animationPhase, 0.0f, 0.0f, 0.0f);
+                    }
+                });
+
+                const Mesh* zombieMesh = object.getMesh();
+                float zombieHeight = zombieMesh->getBboxMax().y - zombieMesh->getBboxMin().y;
+                this->horde.prepare(hordeInstances, hordeCount, object.getScale(), zombieHeight, frame, (float) framebufferHeight);
+            }
 
-                // Atualiza a matrix de modelo
-                model = Matrix_Translate(enemies[i].position.x, enemies[i].position.y, enemies[i].position.z);
-                model *= Matrix_Scale(object.getScale().x, object.getScale().y, object.getScale().z);
-                model *= Matrix_Rotate_Y(enemies[i].rotation);
+            // Desenho instanciado de todos os zumbis visíveis (os distantes, ou além do orçamento de malhas, como impostores)
 
-                glUniformMatrix4fv(this->model_uniform, 1, GL_FALSE, glm::value_ptr(model));
-                glUniform1i(this->object_id_uniform, object.getId());
-                this->DrawVirtualObject(object.getName().c_str());
-            }
+            GLState::useProgram(this->gpuProgramID);
+            GLState::uniform1i(this->instanced_uniform, 1);
+            GLState::uniform1i(this->object_id_uniform, object.getId());
+            this->SetBboxUniforms(*this->modelSceneObjects[object.getId()]);
+            this->horde.draw();
+            GLState::uniform1i(this->instanced_uniform, 0);
+            this->DrawImpostors(frame.view, frame.projection);
+            this->gpuTimer.endPass(GPU_PASS_HORDE);
         }
         else {
+            PROFILE_SCOPE("Renderer::render object");
+            GpuPass pass = (object.getId() == ROBOT) ? GPU_PASS_PLAYER : GPU_PASS_SCENERY;
+            this->gpuTimer.beginPass(pass);
 
-            // Se é o robô
+            // O robô é desenhado na posição e rotação simuladas
+            glm::vec3 position = object.getPosition();
+            float rotation = object.getRotation();
             if (object.getId() == ROBOT) {
-                object.updatePlayer(delta_t, camera, this->models[SCENERY]);
+                position = robot.position;
+                rotation = robot.rotation;
             }
 
             // Atualiza a matrix de modelo
-            model = Matrix_Translate(object.getPosition().x, object.getPosition().y, object.getPosition().z);
-            model *= Matrix_Scale(object.getScale().x, object.getScale().y, object.getScale().z);
-            model *= Matrix_Rotate_Y(object.getRotation());
+            model = Matrix_TRS_Y(position, object.getScale(), rotation);
 
-            // Atualiza a bounding box
-            object.updateBbox();
+            GLState::uniformMatrix4fv(this->model_uniform, glm::value_ptr(model));
+            GLState::uniform1i(this->object_id_uniform, object.getId());
+            this->DrawVirtualObject(*this->modelSceneObjects[object.getId()]);
 
-            glUniformMatrix4fv(this->model_uniform, 1, GL_FALSE, glm::value_ptr(model));
-            glUniform1i(this->object_id_uniform, object.getId());
-            this->DrawVirtualObject(object.getName().c_str());
+            // Os obstáculos fazem parte do cenário
+            if (object.getId() == SCENERY) {
+                this->DrawObstacles();
+            }
+            this->gpuTimer.endPass(pass);
         }
     }
 
-    glfwSwapBuffers(window);
+    GLState::bindVertexArray(0);
 
-    // Verifica interrupção
-    glfwPollEvents();
+    // HUD de desempenho
+    if (this->showHud) {
+        this->gpuTimer.beginPass(GPU_PASS_HUD);
+        this->DrawHud(framebufferWidth, framebufferHeight);
+        this->gpuTimer.endPass(GPU_PASS_HUD);
+    }
+
+    // Fim da medição do quadro, antes da troca de buffers (que pode bloquear em V-Sync)
+    double frameEndTime = glfwGetTime();
+    double cpuMs = 1000.0 * (frameEndTime - frameStartTime);
+    this->gpuTimer.endFrame(cpuMs);
+    this->jobs.endFrame(frameEndTime - frameStartTime);
+
+    // Histórico de tempos e FPS do HUD
+    this->cpuHistory[this->historyIndex] = (float) cpuMs;
+    this->gpuHistory[this->historyIndex] = (float) this->gpuTimer.getGpuMs();
+    this->historyIndex = (this->historyIndex + 1) % HUD_HISTORY_SIZE;
+
+    // Alocações do quadro - após o aquecimento, quadros em regime não devem alocar
+    Metrics::add(COUNTER_ALLOCATIONS, AllocationTracker::endFrame(this->frameIndex >= ALLOCATION_WARMUP_FRAMES));
+
+    // Snapshot dos contadores do quadro e exportação periódica
+    Metrics::set(COUNTER_ENEMIES_ALIVE, this->gpuSimulation ? (size_t) this->hordeSimulation.getAliveCount() : this->simulation.getEnemies().size());
+    Metrics::endFrame();
+    Metrics::update(frameEndTime);
+
+    this->fpsFrames++;
+    if (frameEndTime - this->fpsTimer >= 0.5) {
+        this->fps = (float) ((double) this->fpsFrames / (frameEndTime - this->fpsTimer));
+        this->fpsFrames = 0;
+        this->fpsTimer = frameEndTime;
+    }
+
+    {
+        PROFILE_SCOPE("glfwSwapBuffers");
+        glfwSwapBuffers(window);
+        this->markFrameSubmitted();
+    }
+
+    // Registra a latência entre a entrada mais antiga aplicada e a apresentação
+    input.markPresented(glfwGetTime());
 
     return true;
 }
\ No newline at end of file
@@ -0,0 +1,578 @@
+#include "Simulation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+#include "collisions.h"
+#include "Metrics.h"
+#include "Profiler.h"
+
+// Construtor - a partida começa em initialize()
+Simulation::Simulation() {
+    this->jobs = nullptr;
+    this->robotBlocked = false;
+    this->pistolReady = 0.0;
+    this->phase = 0;
+    this->enemiesKilled = 0;
+    this->enemiesSpawned = 0;
+    this->cpuHorde = true;
+    this->time = 0.0;
+    this->spawnTime = 0.0;
+    this->tick = 0;
+    this->random = 1u;
+    this->flowFieldUpdates = 0;
+    this->nextEnemyId = 0;
+}
+
+// Prepara as grades de navegação e separação sobre a arena e começa uma partida
+void Simulation::initialize(const SimulationConfig &config, JobSystem* jobs) {
+    this->config = config;
+    this->jobs = jobs;
+
+    // Reserva o vetor de inimigos para o máximo permitido, evitando realocações durante as ondas
+    this->enemies.reserve(MAX_ENEMIES);
+    this->killed.reserve(MAX_ENEMIES);
+    this->damage.reserve(MAX_ENEMIES);
+    this->enemyHits.resize(MAX_ENEMIES * ENEMY_MAX_HITS);
+    this->enemyHitCounts.resize(MAX_ENEMIES);
+    this->projectileHits.reserve(MAX_ENEMIES * ENEMY_MAX_HITS);
+
+    this->flowField.initialize(config.arenaMin, config.arenaMax, FLOW_FIELD_CELL_SIZE);
+
+    // Os obstáculos são aumentados pela metade do tamanho do zumbi: basta que o centro dele fique fora das
+    // células bloqueadas para que o corpo não entre no obstáculo
+    glm::vec3 zombieHalfSize = glm::vec3(config.zombieHalfSize.x, 0.0f, config.zombieHalfSize.y);
+    for (int i = 0; i < std::min(config.obstacleCount, MAX_OBSTACLES); i++) {
+        this->flowField.addObstacle(config.obstacleMin[i] - zombieHalfSize, config.obstacleMax[i] + zombieHalfSize);
+    }
+    this->crowd.initialize(config.arenaMin, config.arenaMax, CROWD_SEPARATION_RADIUS, MAX_ENEMIES);
+
+    this->reset();
+}
+
+// Recomeça a partida: robô na posição inicial, sem projéteis nem inimigos e na primeira fase
+void Simulation::reset() {
+    this->robot = SimulationBody();
+    this->robot.position = this->config.robotStart;
+    this->robot.originalPosition = this->config.robotStart;
+    this->robot.direction = glm::normalize(this->config.robotDirection);
+    this->robot.x_difference = this->config.robotHalfSize.x;
+    this->robot.z_difference = this->config.robotHalfSize.y;
+    this->robot.updateBbox();
+    this->robotBlocked = false;
+
+    this->projectiles.clear();
+    this->pistolReady = 0.0;
+
+    this->enemies.clear();
+    this->crowd.clear();
+    this->phase = 0;
+    this->enemiesKilled = 0;
+    this->enemiesSpawned = 0;
+
+    this->time = 0.0;
+    this->spawnTime = 0.0;
+    this->tick = 0;
+    this->random = this->config.seed != 0 ? this->config.seed : 1u;
+    this->flowFieldUpdates = 0;
+    this->nextEnemyId = 0;
+}
+
+// Avança um passo da partida, na mesma ordem do laço de desenho original: fases, criação de zumbis,
+// robô, horda e projéteis
+bool Simulation::step(const SimulationInput &input) {
+    PROFILE_SCOPE("Simulation::step");
+
+    this->time += input.deltaTime;
+    this->tick++;
+
+    // Atualiza o estado de jogo e cria os inimigos a partir dele
+    this->UpdateGameStatus();
+    this->GenerateZombies(input.paused);
+
+    this->UpdatePlayer(input);
+
+    if (this->cpuHorde && !this->UpdateHorde(input.paused, input.deltaTime)) {
+        return false;
+    }
+
+    // Lança os projéteis pedidos no passo e avança todos em uma única passada
+    this->FireWeapons(input);
+    this->projectiles.update(input.deltaTime, input.paused, this->config.sceneryBboxMin, this->config.sceneryBboxMax);
+    return true;
+}
+
+// Atualiza o estado de jogo
+void Simulation::UpdateGameStatus() {
+    PROFILE_SCOPE("Simulation::UpdateGameStatus");
+
+    // As mortes da horda simulada na GPU chegam em lotes: a comparação não pode ser exata
+    // Caso atinja 16 inimigos mortos na fase 1, passa para a fase 2
+    if (this->phase == 0 && this->enemiesKilled >= 16) {
+        this->phase++;
+        this->enemiesKilled = 0;
+        this->enemiesSpawned = 0;
+    }
+    // Caso atinja 32 inimigos mortos na fase 2, passa para a fase 3
+    if (this->phase == 1 && this->enemiesKilled >= 32) {
+        this->phase++;
+        this->enemiesKilled = 0;
+        this->enemiesSpawned = 0;
+    }
+}
+
+// Gera inimigos a partir do estado de jogo
+void Simulation::GenerateZombies(bool isPaused) {
+    PROFILE_SCOPE("Simulation::GenerateZombies");
+
+    float x_difference = this->config.zombieHalfSize.x;
+    float z_difference = this->config.zombieHalfSize.y;
+
+    double spawn_delta_t = this->time - this->spawnTime;
+    double spawningTime = 5.0 - (double) this->phase; // Fase 1: 5s, Fase 2: 4s, Fase 3: 3s
+
+    // Caso tenha passado do tempo de spawn e não esteja pausado
+    if (spawn_delta_t >= spawningTime && !isPaused) {
+        if (((this->phase == 0 && this->enemiesSpawned < 16)     // Fase 1 dura 16 inimigos
+             || (this->phase == 1 && this->enemiesSpawned < 32)  // Fase 2 dura 32 inimigos
+             || (this->phase == 2))                              // Fase 3 dura até a morte do jogador
+            && this->enemies.size() + 4 <= MAX_ENEMIES) {        // Nunca ultrapassa a capacidade reservada
+
+            // Os zumbis são plotados nos quatro pontos cardeais simultaneamente
+            const glm::vec3 spawnPoints[4] = {
+                glm::vec3(0.0f, 0.0f, -6.8f),
+                glm::vec3(0.0f, 0.0f, 6.8f),
+                glm::vec3(-6.8f, 0.0f, 0.0f),
+                glm::vec3(6.8f, 0.0f, 0.0f)
+            };
+
+            for (int i = 0; i < 4; i++) {
+                enemyData newEnemy;
+                newEnemy.speed = 1.0f + (float) this->phase; // Fase 1: 1.0f, Fase 2: 2.0f, Fase 3: 3.0f
+                newEnemy.direction = glm::vec3(0.0f, 0.0f, 1.0f);
+                newEnemy.animationPhase = 0.25f * ((float) i + this->nextRandom()); // Os zumbis não caminham em sincronia
+                newEnemy.position = spawnPoints[i];
+                newEnemy.bbox_max = glm::vec3(newEnemy.position.x + x_difference, newEnemy.position.y, newEnemy.position.z + z_difference);
+                newEnemy.bbox_min = glm::vec3(newEnemy.position.x - x_difference, newEnemy.position.y, newEnemy.position.z - z_difference);
+                this->enemies.push_back(newEnemy);
+                this->enemiesSpawned++;
+                Metrics::add(COUNTER_ENEMIES_SPAWNED);
+            }
+        }
+
+        this->spawnTime = this->time;
+    }
+    // Caso esteja pausado, o tempo de spawn não é atualizado
+    if (isPaused) {
+        this->spawnTime += spawn_delta_t;
+    }
+}
+
+// Atualiza a posição e a rotação do robô
+void Simulation::UpdatePlayer(const SimulationInput &input) {
+    PROFILE_SCOPE("Simulation::UpdatePlayer");
+
+    // Velocidade do personagem
+    float speed = 4.0f;
+
+    glm::vec3 newPosition = this->robot.position;
+    glm::vec3 view = input.viewDirection;
+
+    // Cálculo de rotação a partir da direção original do player
+    this->robot.rotation = atan2f(this->robot.direction.z, this->robot.direction.x) - atan2f(view.z, view.x);
+
+    // Cálculo de posição a partir do input do usuário
+    glm::vec3 w = -glm::normalize(view);
+    glm::vec3 u = glm::normalize(glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), w));
+
+    // O deslocamento usa o tempo em que cada tecla ficou pressionada dentro do passo,
+    // de forma que toques mais curtos que um quadro não são perdidos
+    newPosition -= glm::vec3(w.x, 0.0f, w.z) * speed * input.heldW;
+    newPosition += glm::vec3(w.x, 0.0f, w.z) * speed * input.heldS;
+    newPosition -= glm::vec3(u.x, 0.0f, u.z) * speed * input.heldA;
+    newPosition += glm::vec3(u.x, 0.0f, u.z) * speed * input.heldD;
+
+    // Atualização da bounding box
+    glm::vec3 newBbox_min = glm::vec3(newPosition.x - this->robot.x_difference, newPosition.y, newPosition.z - this->robot.z_difference);
+    glm::vec3 newBbox_max = glm::vec3(newPosition.x + this->robot.x_difference, newPosition.y, newPosition.z + this->robot.z_difference);
+
+    // Checa colisão com o cenário e com os obstáculos - caso não ocorra, atualiza a posição do personagem
+    uint64_t tests = 1;
+    this->robotBlocked = collisions::CubeToBox(newBbox_min, newBbox_max, this->config.sceneryBboxMin, this->config.sceneryBboxMax);
+    for (int i = 0; i < this->config.obstacleCount && !this->robotBlocked; i++) {
+        this->robotBlocked = collisions::CubeToCube(newBbox_min, newBbox_max, this->config.obstacleMin[i], this->config.obstacleMax[i]);
+        tests++;
+    }
+    Metrics::add(COUNTER_PAIR_TESTS, tests);
+    if (!this->robotBlocked) {
+        this->robot.position = newPosition;
+    }
+    this->robot.updateBbox();
+}
+
+// Move os zumbis em três fases: movimento e colisões em paralelo, mortes em sequência e compactação
+bool Simulation::UpdateHorde(bool isPaused, float delta_t) {
+    PROFILE_SCOPE("Simulation::UpdateHorde");
+
+    float x_difference = this->config.zombieHalfSize.x;
+    float z_difference = this->config.zombieHalfSize.y;
+    float animationRate = this->config.animationRate;
+
+    // O campo de direções só é recalculado quando o robô muda de célula
+    glm::vec3 robotPosition = this->robot.position;
+    if (this->flowField.update(robotPosition)) {
+        this->flowFieldUpdates++;
+    }
+
+    // Zumbis criados desde o último passo entram na grade de separação e recebem um identificador
+    // (a grade é refeita se o vetor encolheu)
+    if (this->crowd.getCount() > (int) this->enemies.size()) {
+        this->crowd.clear();
+    }
+    for (size_t i = this->crowd.getCount(); i < this->enemies.size(); i++) {
+        this->crowd.insert(this->enemies[i].position);
+        this->enemies[i].id = this->nextEnemyId++;
+    }
+
+    // Zumbis mortos no passo, removidos após a fase paralela (capacidade reservada em initialize())
+    this->killed.resize(this->enemies.size());
+    this->damage.resize(this->enemies.size());
+    uint8_t* killed = this->killed.data();
+    float* damage = this->damage.data();
+    ProjectileHit* enemyHits = this->enemyHits.data();
+    uint8_t* enemyHitCounts = this->enemyHitCounts.data();
+    enemyData* enemies = this->enemies.data();
+
+    // Fase 1 (paralela): colisões, perseguição e separação de cada zumbi. A separação lê as posições
+    // do passo anterior guardadas na grade, de forma que o resultado não depende da ordem nem do número
+    // de threads; cada iteração escreve apenas no seu próprio zumbi
+    std::atomic<bool> robotHit(false);
+    std::atomic<uint64_t> pairTests(0);
+    glm::vec3 robotBboxMin = this->robot.bbox_min;
+    glm::vec3 robotBboxMax = this->robot.bbox_max;
+
+    // Os projéteis são testados ao longo de todo o deslocamento do passo anterior, de forma que não
+    // atravessam zumbis mesmo com passos longos
+    const ProjectileSystem &projectiles = this->projectiles;
+    size_t projectileCount = projectiles.getCount();
+
+    this->forEachEnemy(this->enemies.size(), [&](size_t begin, size_t end) {
+        uint64_t tests = 0;
+        for (size_t i = begin; i < end; i++) {
+            killed[i] = 0;
+
+            // Caso o robô seja atingido pelo zumbi, o jogo termina após a fase
+            tests++;
+            if (collisions::CylinderToCylinder(enemies[i].bbox_min, enemies[i].bbox_max, robotBboxMin, robotBboxMax)) {
+                robotHit.store(true, std::memory_order_relaxed);
+            }
+            // Os acertos são guardados nas posições do próprio zumbi, sem travas, e resolvidos na fase 2: um
+            // projétil não perfurante só atinge o primeiro zumbi do seu deslocamento, e um perfurante, cada
+            // zumbi uma única vez. Além de ENEMY_MAX_HITS acertos, ficam os mais cedo no passo
+            damage[i] = 0.0f;
+            ProjectileHit* hits = enemyHits + i * ENEMY_MAX_HITS;
+            int hitCount = 0;
+            tests += projectileCount;
+            for (size_t projectile = 0; projectile < projectileCount; projectile++) {
+                float timeOfImpact;
+                if (projectiles.hasHit(projectile, enemies[i].id) || !projectiles.sweep(projectile, enemies[i].bbox_min, enemies[i].bbox_max, timeOfImpact)) {
+                    continue;
+                }
+                if (hitCount == ENEMY_MAX_HITS && timeOfImpact >= hits[hitCount - 1].timeOfImpact) {
+                    continue;
+                }
+                int slot = std::min(hitCount, ENEMY_MAX_HITS - 1);
+                while (slot > 0 && hits[slot - 1].timeOfImpact > timeOfImpact) {
+                    hits[slot] = hits[slot - 1];
+                    slot--;
+                }
+                hits[slot] = {timeOfImpact, (uint32_t) i, (uint16_t) projectile};
+                hitCount = std::min(hitCount + 1, ENEMY_MAX_HITS);
+            }
+            enemyHitCounts[i] = (uint8_t) hitCount;
+
+            // Direção da célula do zumbi no campo compartilhado (O(1), independente do tamanho da horda)
+            glm::vec3 playerDirection = this->flowField.direction(enemies[i].position, robotPosition);
+
+            // Caso esteja pausado, os zumbis não se movem
+            if (!isPaused) {
+                // Perseguição somada à separação dos vizinhos, limitada à velocidade máxima do zumbi
+                glm::vec3 velocity = playerDirection * enemies[i].speed
+                                   + this->crowd.separation((int) i, tests) * (CROWD_SEPARATION_WEIGHT * enemies[i].speed);
+                float velocityLength = glm::length(velocity);
+                if (velocityLength > enemies[i].speed) {
+                    velocity *= enemies[i].speed / velocityLength;
+                    velocityLength = enemies[i].speed;
+                }
+                // O zumbi não entra nas células dos obstáculos: desliza ao longo deles (só em x ou só em z)
+                // ou fica parado. Um zumbi que já está dentro de uma delas pode sair
+                glm::vec3 newPosition = enemies[i].position + velocity * delta_t;
+                if (this->flowField.isBlocked(newPosition) && !this->flowField.isBlocked(enemies[i].position)) {
+                    glm::vec3 slideX = glm::vec3(newPosition.x, enemies[i].position.y, enemies[i].position.z);
+                    glm::vec3 slideZ = glm::vec3(enemies[i].position.x, enemies[i].position.y, newPosition.z);
+                    if (!this->flowField.isBlocked(slideX)) {
+                        newPosition = slideX;
+                    }
+                    else if (!this->flowField.isBlocked(slideZ)) {
+                        newPosition = slideZ;
+                    }
+                    else {
+                        newPosition = enemies[i].position;
+                    }
+                    velocityLength = glm::distance(newPosition, enemies[i].position) / std::max(delta_t, 1e-6f);
+                }
+                enemies[i].position = newPosition;
+
+                // O ciclo de caminhada avança com a distância percorrida, sem deslizar os pés
+                enemies[i].animationPhase += delta_t * velocityLength * animationRate;
+                enemies[i].animationPhase -= floorf(enemies[i].animationPhase);
+            }
+
+            // Atualiza a bounding box do zumbi
+            enemies[i].bbox_max = glm::vec3(enemies[i].position.x + x_difference, enemies[i].position.y, enemies[i].position.z + z_difference);
+            enemies[i].bbox_min = glm::vec3(enemies[i].position.x - x_difference, enemies[i].position.y, enemies[i].position.z - z_difference);
+            enemies[i].rotation = atan2f(enemies[i].direction.z, enemies[i].direction.x) - atan2f(playerDirection.z, playerDirection.x);
+        }
+        // Testes de colisão e de distância da separação do bloco, somados uma única vez
+        pairTests.fetch_add(tests, std::memory_order_relaxed);
+    });
+    Metrics::add(COUNTER_PAIR_TESTS, pairTests.load(std::memory_order_relaxed));
+
+    // Caso o robô seja atingido por algum zumbi, retorna falso
+    if (robotHit.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    // Fase 2 (sequencial): dano, mortes e atualização da grade, idênticos com qualquer número de threads.
+    // Os acertos de todos os zumbis são juntados e ordenados pelo instante de impacto (e pelos índices, em caso
+    // de empate): cada projétil não perfurante é gasto no primeiro zumbi que atinge, e hit() não causa dano nos
+    // acertos seguintes nem de novo em um zumbi já atravessado por um perfurante
+    this->projectileHits.clear();
+    for (size_t i = 0; i < this->enemies.size(); i++) {
+        this->projectileHits.insert(this->projectileHits.end(), enemyHits + i * ENEMY_MAX_HITS, enemyHits + i * ENEMY_MAX_HITS + enemyHitCounts[i]);
+    }
+    std::sort(this->projectileHits.begin(), this->projectileHits.end(), [](const ProjectileHit &a, const ProjectileHit &b) {
+        if (a.timeOfImpact != b.timeOfImpact) {
+            return a.timeOfImpact < b.timeOfImpact;
+        }
+        if (a.enemy != b.enemy) {
+            return a.enemy < b.enemy;
+        }
+        return a.projectile < b.projectile;
+    });
+    for (const ProjectileHit &hit : this->projectileHits) {
+        damage[hit.enemy] += this->projectiles.hit(hit.projectile, enemies[hit.enemy].id);
+    }
+
+    int killedCount = 0;
+    for (size_t i = 0; i < this->enemies.size(); i++) {
+        if (damage[i] > 0.0f) {
+            enemies[i].health -= damage[i];
+            killed[i] = enemies[i].health <= 0.0f ? 1 : 0;
+        }
+        if (killed[i]) {
+            killedCount++;
+            this->enemiesKilled++;
+            this->crowd.remove((int) i);
+        }
+        else if (!isPaused) {
+            this->crowd.update((int) i, enemies[i].position);
+        }
+    }
+
+    // Compacta o vetor de inimigos, mantendo a ordem dos sobreviventes
+    if (killedCount > 0) {
+        size_t alive = 0;
+        for (size_t i = 0; i < this->enemies.size(); i++) {
+            if (!killed[i]) {
+                this->crowd.relocate((int) i, (int) alive);
+                enemies[alive++] = enemies[i];
+            }
+        }
+        this->enemies.resize(alive);
+        this->crowd.truncate((int) alive);
+    }
+
+    return true;
+}
+
+// Lança os projéteis pedidos no passo: um bumerange por vez (ataques primário e secundário) e balas da pistola
+// com um intervalo mínimo entre os tiros
+void Simulation::FireWeapons(const SimulationInput &input) {
+    PROFILE_SCOPE("Simulation::FireWeapons");
+
+    // Os projéteis partem da posição do robô, na altura do bumerange
+    glm::vec3 origin = glm::vec3(this->robot.position.x, this->config.boomerangStart.y, this->robot.position.z);
+    float robotRotation = this->robot.rotation;
+
+    if ((input.attackPrimary || input.attackSecondary) && !this->isBoomerangActive()) {
+        // Calcula a direção de ataque
+        glm::vec3 attackDirection = glm::vec3(0.0f, 0.0f, 1.0f);
+        glm::vec3 direction = glm::normalize(glm::vec3(attackDirection.x * cos(robotRotation) + attackDirection.z * sin(robotRotation),
+                                                       origin.y,
+                                                       -attackDirection.x * sin(robotRotation) + attackDirection.z * cos(robotRotation)));
+
+        ProjectileLaunch boomerang;
+        boomerang.kind = PROJECTILE_BOOMERANG;
+        boomerang.origin = origin;
+        boomerang.direction = direction;
+        boomerang.halfSize = this->config.boomerangHalfSize;
+        boomerang.speed = 6.0f;
+        boomerang.lifetime = 10.0f;
+        boomerang.damage = 1.0f;
+        boomerang.piercing = true;
+
+        // Ataque primário: linha reta até 5 unidades
+        if (input.attackPrimary) {
+            boomerang.trajectory = TRAJECTORY_LINEAR;
+            boomerang.range = 5.0f;
+            this->projectiles.launch(boomerang);
+        }
+        // Ataque secundário: curva de Bézier de grau 2 até 7.5 unidades. O ponto de controle fica a 70% do alcance,
+        // a 90º da direção de lançamento, e o ponto final no alcance, na direção de lançamento (no plano XZ).
+        // A velocidade constante mantém a duração do ataque (1/3 s)
+        if (input.attackSecondary) {
+            boomerang.trajectory = TRAJECTORY_CURVE;
+            boomerang.range = 7.5f;
+            glm::vec3 forward = glm::normalize(glm::vec3(direction.x, 0.0f, direction.z));
+            glm::vec3 side = glm::vec3(-forward.z, 0.0f, forward.x);
+            boomerang.path.setQuadraticBezier(origin, origin + 0.7f * boomerang.range * side, origin + boomerang.range * forward);
+            boomerang.speed = 3.0f * boomerang.path.getLength();
+            this->projectiles.launch(boomerang);
+        }
+    }
+
+    if (input.attackPistol && !input.paused && this->time >= this->pistolReady) {
+        ProjectileLaunch bullet;
+        bullet.kind = PROJECTILE_BULLET;
+        bullet.trajectory = TRAJECTORY_LINEAR;
+        bullet.origin = origin;
+        bullet.direction = glm::vec3(sin(robotRotation), 0.0f, cos(robotRotation));
+        bullet.halfSize = this->config.boomerangHalfSize * PISTOL_BULLET_SCALE;
+        bullet.speed = PISTOL_BULLET_SPEED;
+        bullet.range = PISTOL_RANGE;
+        bullet.lifetime = PISTOL_RANGE / PISTOL_BULLET_SPEED;
+        bullet.damage = PISTOL_DAMAGE;
+        bullet.piercing = false;
+        if (this->projectiles.launch(bullet)) {
+            this->pistolReady = this->time + PISTOL_COOLDOWN;
+        }
+    }
+}
+
+// Próximo valor do gerador, em [0, 1)
+float Simulation::nextRandom() {
+    this->random ^= this->random << 13;
+    this->random ^= this->random >> 17;
+    this->random ^= this->random << 5;
+    return (float) (this->random >> 8) / (float) (1u << 24);
+}
+
+// Acumula bytes no hash FNV-1a de 64 bits
+static void HashBytes(uint64_t &hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+// Hash do estado que influencia os passos seguintes: relógio, fases, robô, projéteis, horda e gerador
+uint64_t Simulation::hashState() const {
+    uint64_t hash = 14695981039346656037ull;
+    HashBytes(hash, &this->tick, sizeof(this->tick));
+    HashBytes(hash, &this->time, sizeof(this->time));
+    HashBytes(hash, &this->spawnTime, sizeof(this->spawnTime));
+    HashBytes(hash, &this->phase, sizeof(this->phase));
+    HashBytes(hash, &this->enemiesKilled, sizeof(this->enemiesKilled));
+    HashBytes(hash, &this->enemiesSpawned, sizeof(this->enemiesSpawned));
+    HashBytes(hash, &this->random, sizeof(this->random));
+
+    HashBytes(hash, &this->robot.position, sizeof(this->robot.position));
+    HashBytes(hash, &this->robot.originalPosition, sizeof(this->robot.originalPosition));
+    HashBytes(hash, &this->robot.direction, sizeof(this->robot.direction));
+    HashBytes(hash, &this->robot.rotation, sizeof(this->robot.rotation));
+
+    this->projectiles.hash(hash);
+    HashBytes(hash, &this->pistolReady, sizeof(this->pistolReady));
+
+    for (const enemyData &enemy : this->enemies) {
+        HashBytes(hash, &enemy.position, sizeof(enemy.position));
+        HashBytes(hash, &enemy.rotation, sizeof(enemy.rotation));
+        HashBytes(hash, &enemy.speed, sizeof(enemy.speed));
+        HashBytes(hash, &enemy.animationPhase, sizeof(enemy.animationPhase));
+        HashBytes(hash, &enemy.health, sizeof(enemy.health));
+        HashBytes(hash, &enemy.id, sizeof(enemy.id));
+    }
+    return hash;
+}
+
+// Liga ou desliga a simulação da horda na CPU
+void Simulation::setCpuHorde(bool enabled) {
+    this->cpuHorde = enabled;
+    if (!enabled) {
+        this->crowd.clear();
+    }
+}
+
+void Simulation::addKills(int kills) {
+    this->enemiesKilled += kills;
+}
+
+// Getters
+
+const SimulationBody &Simulation::getRobot() const {
+    return this->robot;
+}
+
+bool Simulation::isRobotBlocked() const {
+    return this->robotBlocked;
+}
+
+bool Simulation::isBoomerangActive() const {
+    return this->projectiles.countKind(PROJECTILE_BOOMERANG) > 0;
+}
+
+const ProjectileSystem &Simulation::getProjectiles() const {
+    return this->projectiles;
+}
+
+const std::vector<enemyData> &Simulation::getEnemies() const {
+    return this->enemies;
+}
+
+std::vector<enemyData> &Simulation::getEnemies() {
+    return this->enemies;
+}
+
+int Simulation::getPhase() const {
+    return this->phase;
+}
+
+int Simulation::getEnemiesKilled() const {
+    return this->enemiesKilled;
+}
+
+double Simulation::getTime() const {
+    return this->time;
+}
+
+uint64_t Simulation::getTick() const {
+    return this->tick;
+}
+
+const SimulationConfig &Simulation::getConfig() const {
+    return this->config;
+}
+
+const FlowField &Simulation::getFlowField() const {
+    return this->flowField;
+}
+
+uint64_t Simulation::getFlowFieldUpdates() const {
+    return this->flowFieldUpdates;
+}
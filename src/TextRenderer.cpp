@@ -0,0 +1,176 @@
+#include "TextRenderer.h"
+
+#include <cstddef>
+
+#include "GLState.h"
+
+// Atlas de glifos - incluído somente nesta unidade de compilação, pois define a variável global "dejavufont"
+#include "dejavufont.h"
+
+// Construtor do renderizador de texto
+TextRenderer::TextRenderer() {
+    this->programId = 0;
+    this->vertexArrayObjectId = 0;
+    this->vertexBufferId = 0;
+    this->textureId = 0;
+    this->textureUnit = 0;
+    this->screenSizeUniform = -1;
+    this->whiteS = 0.0f;
+    this->whiteT = 0.0f;
+    this->screenWidth = 1;
+    this->screenHeight = 1;
+}
+
+// Envia o atlas para a GPU e cria o buffer dinâmico de quadriláteros
+void TextRenderer::initialize(GLuint programId, GLuint textureUnit) {
+    this->programId = programId;
+    this->textureUnit = textureUnit;
+    this->screenSizeUniform = glGetUniformLocation(programId, "screen_size");
+
+    // O primeiro glifo do atlas (codepoint -1) é uma região totalmente branca
+    const texture_glyph_t &white = dejavufont.glyphs[0];
+    this->whiteS = 0.5f * (white.s0 + white.s1);
+    this->whiteT = 0.5f * (white.t0 + white.t1);
+
+    // Atlas de um canal, enviado uma única vez
+    glGenTextures(1, &this->textureId);
+    GLState::activeTexture(GL_TEXTURE0 + textureUnit);
+    GLState::bindTexture(GL_TEXTURE_2D, this->textureId);
+    GLState::bindSampler(textureUnit, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, (GLsizei) dejavufont.tex_width, (GLsizei) dejavufont.tex_height, 0, GL_RED, GL_UNSIGNED_BYTE, dejavufont.tex_data);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    GLState::useProgram(programId);
+    GLState::uniform1i(glGetUniformLocation(programId, "FontAtlas"), (GLint) textureUnit);
+    GLState::useProgram(0);
+
+    // Buffer dinâmico com capacidade fixa - nenhuma alocação durante o jogo
+    this->vertices.reserve(6 * TEXT_MAX_QUADS);
+
+    glGenVertexArrays(1, &this->vertexArrayObjectId);
+    GLState::bindVertexArray(this->vertexArrayObjectId);
+
+    glGenBuffers(1, &this->vertexBufferId);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->vertexBufferId);
+    glBufferData(GL_ARRAY_BUFFER, 6 * TEXT_MAX_QUADS * sizeof(HudVertex), NULL, GL_STREAM_DRAW);
+
+    // "(location = 0)" a "(location = 2)" em "hud_vertex.glsl"
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(HudVertex), (void*) offsetof(HudVertex, x));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(HudVertex), (void*) offsetof(HudVertex, s));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(HudVertex), (void*) offsetof(HudVertex, r));
+    glEnableVertexAttribArray(2);
+
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::bindVertexArray(0);
+}
+
+// Libera o atlas e os buffers
+void TextRenderer::release() {
+    if (this->vertexBufferId != 0) {
+        glDeleteBuffers(1, &this->vertexBufferId);
+        this->vertexBufferId = 0;
+    }
+    if (this->vertexArrayObjectId != 0) {
+        glDeleteVertexArrays(1, &this->vertexArrayObjectId);
+        this->vertexArrayObjectId = 0;
+    }
+    if (this->textureId != 0) {
+        glDeleteTextures(1, &this->textureId);
+        this->textureId = 0;
+    }
+    GLState::invalidate();
+}
+
+// Inicia um novo lote
+void TextRenderer::begin(int screenWidth, int screenHeight) {
+    this->vertices.clear();
+    this->screenWidth = screenWidth;
+    this->screenHeight = screenHeight;
+}
+
+// Adiciona um quadrilátero como dois triângulos
+void TextRenderer::addQuad(float x0, float y0, float x1, float y1, float s0, float t0, float s1, float t1, glm::vec4 color) {
+    if (this->vertices.size() + 6 > this->vertices.capacity()) {
+        return;
+    }
+
+    HudVertex v00 = {x0, y0, s0, t0, color.r, color.g, color.b, color.a};
+    HudVertex v10 = {x1, y0, s1, t0, color.r, color.g, color.b, color.a};
+    HudVertex v01 = {x0, y1, s0, t1, color.r, color.g, color.b, color.a};
+    HudVertex v11 = {x1, y1, s1, t1, color.r, color.g, color.b, color.a};
+
+    this->vertices.push_back(v00);
+    this->vertices.push_back(v01);
+    this->vertices.push_back(v11);
+    this->vertices.push_back(v00);
+    this->vertices.push_back(v11);
+    this->vertices.push_back(v10);
+}
+
+// Adiciona uma string com a linha de base em (x, y)
+float TextRenderer::addText(const char* text, float x, float y, glm::vec4 color, float scale) {
+    float penX = x;
+
+    for (const char* c = text; *c != '\0'; c++) {
+        unsigned char codepoint = (unsigned char) *c;
+
+        // O atlas contém os caracteres ASCII imprimíveis (32 a 126), após o glifo branco
+        if (codepoint < 32 || codepoint > 126) {
+            continue;
+        }
+        const texture_glyph_t &glyph = dejavufont.glyphs[codepoint - 32 + 1];
+
+        float x0 = penX + (float) glyph.offset_x * scale;
+        float y0 = y - (float) glyph.offset_y * scale;
+        float x1 = x0 + (float) glyph.width * scale;
+        float y1 = y0 + (float) glyph.height * scale;
+
+        if (glyph.width > 0 && glyph.height > 0) {
+            this->addQuad(x0, y0, x1, y1, glyph.s0, glyph.t0, glyph.s1, glyph.t1, color);
+        }
+
+        penX += glyph.advance_x * scale;
+    }
+
+    return penX - x;
+}
+
+// Adiciona um retângulo sólido, amostrando o texel branco do atlas
+void TextRenderer::addRect(float x, float y, float width, float height, glm::vec4 color) {
+    this->addQuad(x, y, x + width, y + height, this->whiteS, this->whiteT, this->whiteS, this->whiteT, color);
+}
+
+// Desenha todo o lote com uma única chamada
+size_t TextRenderer::flush() {
+    if (this->vertices.empty()) {
+        return 0;
+    }
+
+    GLState::useProgram(this->programId);
+    GLState::uniform2f(this->screenSizeUniform, (float) this->screenWidth, (float) this->screenHeight);
+
+    GLState::activeTexture(GL_TEXTURE0 + this->textureUnit);
+    GLState::bindTexture(GL_TEXTURE_2D, this->textureId);
+
+    GLState::bindVertexArray(this->vertexArrayObjectId);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, this->vertexBufferId);
+
+    // "Orphaning" do buffer, evitando sincronização com o quadro anterior
+    glBufferData(GL_ARRAY_BUFFER, 6 * TEXT_MAX_QUADS * sizeof(HudVertex), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, this->vertices.size() * sizeof(HudVertex), this->vertices.data());
+
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei) this->vertices.size());
+
+    return this->vertices.size() / 3;
+}
+
+// Altura de uma linha de texto em pixels
+float TextRenderer::lineHeight(float scale) const {
+    return dejavufont.height * scale;
+}
@@ -0,0 +1,136 @@
+#include "Trajectory.h"
+
+#include <algorithm>
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+// Construtor - a curva começa vazia
+Trajectory::Trajectory() {
+    this->clear();
+}
+
+void Trajectory::clear() {
+    this->segmentCount = 0;
+    this->points[0] = glm::vec3(0.0f, 0.0f, 0.0f);
+    this->lengths[0] = 0.0f;
+}
+
+// Os pontos interiores da curva de grau 3 ficam a 2/3 do caminho entre as pontas e o ponto de controle
+void Trajectory::setQuadraticBezier(glm::vec3 p0, glm::vec3 p1, glm::vec3 p2) {
+    this->setCubicBezier(p0, p0 + (2.0f / 3.0f) * (p1 - p0), p2 + (2.0f / 3.0f) * (p1 - p2), p2);
+}
+
+void Trajectory::setCubicBezier(glm::vec3 p0, glm::vec3 p1, glm::vec3 p2, glm::vec3 p3) {
+    this->segmentCount = 1;
+    this->points[0] = p0;
+    this->points[1] = p1;
+    this->points[2] = p2;
+    this->points[3] = p3;
+    this->buildTable();
+}
+
+// Cada trecho entre path[i] e path[i + 1] é o segmento de Bézier com as mesmas tangentes do Catmull-Rom
+// uniforme: (path[i + 1] - path[i - 1]) / 2 no início e (path[i + 2] - path[i]) / 2 no final
+bool Trajectory::setCatmullRom(const glm::vec3* path, size_t count) {
+    if (count < 2 || count > TRAJECTORY_MAX_SEGMENTS + 1) {
+        return false;
+    }
+
+    this->segmentCount = (int) count - 1;
+    for (size_t i = 0; i + 1 < count; i++) {
+        glm::vec3 previous = (i > 0) ? path[i - 1] : 2.0f * path[0] - path[1];
+        glm::vec3 next = (i + 2 < count) ? path[i + 2] : 2.0f * path[count - 1] - path[count - 2];
+        this->points[3 * i] = path[i];
+        this->points[3 * i + 1] = path[i] + (path[i + 1] - previous) / 6.0f;
+        this->points[3 * i + 2] = path[i + 1] - (next - path[i]) / 6.0f;
+    }
+    this->points[3 * (count - 1)] = path[count - 1];
+    this->buildTable();
+    return true;
+}
+
+// Comprimento acumulado das cordas entre amostras uniformes do parâmetro
+void Trajectory::buildTable() {
+    int sampleCount = this->segmentCount * TRAJECTORY_SAMPLES_PER_SEGMENT;
+    glm::vec3 previous = this->points[0];
+    this->lengths[0] = 0.0f;
+    for (int k = 1; k <= sampleCount; k++) {
+        glm::vec3 point = this->evaluateParameter((float) k / (float) TRAJECTORY_SAMPLES_PER_SEGMENT);
+        this->lengths[k] = this->lengths[k - 1] + glm::distance(previous, point);
+        previous = point;
+    }
+}
+
+// Bézier de grau 3 do segmento que contém "u", na forma de Bernstein
+glm::vec3 Trajectory::evaluateParameter(float u) const {
+    if (this->segmentCount == 0) {
+        return this->points[0];
+    }
+
+    int segment = std::min((int) u, this->segmentCount - 1);
+    float t = u - (float) segment;
+    float s = 1.0f - t;
+    const glm::vec3* p = &this->points[3 * segment];
+    return (s * s * s) * p[0] + (3.0f * s * s * t) * p[1] + (3.0f * s * t * t) * p[2] + (t * t * t) * p[3];
+}
+
+// Derivada da Bézier de grau 3 do segmento que contém "u" (em relação a u)
+glm::vec3 Trajectory::derivativeParameter(float u) const {
+    if (this->segmentCount == 0) {
+        return glm::vec3(0.0f, 0.0f, 0.0f);
+    }
+
+    int segment = std::min((int) u, this->segmentCount - 1);
+    float t = u - (float) segment;
+    float s = 1.0f - t;
+    const glm::vec3* p = &this->points[3 * segment];
+    return (3.0f * s * s) * (p[1] - p[0]) + (6.0f * s * t) * (p[2] - p[1]) + (3.0f * t * t) * (p[3] - p[2]);
+}
+
+// Busca binária do intervalo da tabela que contém a distância e interpolação linear dentro dele, seguida de um
+// passo de Newton: a interpolação supõe velocidade constante no intervalo, o que não vale nos trechos mais
+// fechados da curva, onde o passo corrige o parâmetro pela corda percorrida desde o início do intervalo
+float Trajectory::parameterAt(float distance) const {
+    int sampleCount = this->segmentCount * TRAJECTORY_SAMPLES_PER_SEGMENT;
+    if (sampleCount == 0 || distance <= 0.0f) {
+        return 0.0f;
+    }
+    if (distance >= this->lengths[sampleCount]) {
+        return (float) this->segmentCount;
+    }
+
+    int k = (int) (std::upper_bound(this->lengths, this->lengths + sampleCount + 1, distance) - this->lengths) - 1;
+    float span = this->lengths[k + 1] - this->lengths[k];
+    float fraction = span > 0.0f ? (distance - this->lengths[k]) / span : 0.0f;
+    float u0 = (float) k / (float) TRAJECTORY_SAMPLES_PER_SEGMENT;
+    float u1 = (float) (k + 1) / (float) TRAJECTORY_SAMPLES_PER_SEGMENT;
+    float u = ((float) k + fraction) / (float) TRAJECTORY_SAMPLES_PER_SEGMENT;
+
+    float speed = glm::length(this->derivativeParameter(u));
+    if (speed > 1e-6f) {
+        float covered = glm::distance(this->evaluateParameter(u0), this->evaluateParameter(u));
+        u = glm::clamp(u + (distance - this->lengths[k] - covered) / speed, u0, u1);
+    }
+    return u;
+}
+
+glm::vec3 Trajectory::evaluate(float distance) const {
+    return this->evaluateParameter(this->parameterAt(distance));
+}
+
+float Trajectory::getLength() const {
+    return this->lengths[this->segmentCount * TRAJECTORY_SAMPLES_PER_SEGMENT];
+}
+
+int Trajectory::getSegmentCount() const {
+    return this->segmentCount;
+}
+
+glm::vec3 Trajectory::getStart() const {
+    return this->points[0];
+}
+
+glm::vec3 Trajectory::getEnd() const {
+    return this->points[3 * this->segmentCount];
+}
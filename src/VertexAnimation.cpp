@@ -0,0 +1,103 @@
+#include "VertexAnimation.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "GLState.h"
+
+// Construtor - as texturas são criadas em load()
+VertexAnimation::VertexAnimation() {
+    this->header = VatHeader{0, 0, 0, 0, 0, 0.0f};
+    this->remapTextureId = 0;
+    this->offsetTextureId = 0;
+    this->gpuBytes = 0;
+}
+
+// Cria uma textura de texels lidos com texelFetch(), sem filtragem nem mipmaps
+static GLuint CreateDataTexture(GLuint unit, GLint internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* data) {
+    GLuint texture_id;
+    glGenTextures(1, &texture_id);
+    GLState::activeTexture(GL_TEXTURE0 + unit);
+    GLState::bindTexture(GL_TEXTURE_2D, texture_id);
+    GLState::bindSampler(unit, 0);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, data);
+    return texture_id;
+}
+
+// Lê o arquivo .vat e envia o mapeamento e os quadros para a GPU
+bool VertexAnimation::load(const char* filename, GLuint expectedVertexCount, GLuint remapUnit, GLuint offsetUnit) {
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "ERROR: Cannot open file \"%s\".\n", filename);
+        return false;
+    }
+
+    VatHeader fileHeader;
+    bool ok = fread(&fileHeader, sizeof(fileHeader), 1, file) == 1
+              && fileHeader.magic == VAT_MAGIC
+              && fileHeader.width > 0
+              && fileHeader.frameCount > 0
+              && fileHeader.vertexCount == expectedVertexCount;
+    if (!ok) {
+        fprintf(stderr, "ERROR: Animacao \"%s\" invalida ou gerada para outra malha (%u vertices esperados).\n", filename, expectedVertexCount);
+        fclose(file);
+        return false;
+    }
+
+    // As duas tabelas são completadas até o final da última linha da textura
+    size_t width = fileHeader.width;
+    size_t remapRows = (fileHeader.vertexCount + width - 1) / width;
+    size_t offsetTexels = (size_t) fileHeader.frameCount * fileHeader.positionCount;
+    size_t offsetRows = (offsetTexels + width - 1) / width;
+
+    std::vector<uint32_t> remap(remapRows * width, 0);
+    std::vector<uint16_t> offsets(offsetRows * width * 4, 0);
+    ok = fread(remap.data(), sizeof(uint32_t), fileHeader.vertexCount, file) == fileHeader.vertexCount
+         && fread(offsets.data(), 4 * sizeof(uint16_t), offsetTexels, file) == offsetTexels;
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "ERROR: Animacao \"%s\" truncada.\n", filename);
+        return false;
+    }
+
+    this->release();
+    this->header = fileHeader;
+    this->remapTextureId = CreateDataTexture(remapUnit, GL_R32UI, (GLsizei) width, (GLsizei) remapRows, GL_RED_INTEGER, GL_UNSIGNED_INT, remap.data());
+    this->offsetTextureId = CreateDataTexture(offsetUnit, GL_RGBA16F, (GLsizei) width, (GLsizei) offsetRows, GL_RGBA, GL_HALF_FLOAT, offsets.data());
+    this->gpuBytes = remap.size() * sizeof(uint32_t) + offsets.size() * sizeof(uint16_t);
+
+    printf("Animacao \"%s\": %u quadros, %u posicoes (%.1f KB)\n", filename, fileHeader.frameCount, fileHeader.positionCount, (double) this->gpuBytes / 1024.0);
+    return true;
+}
+
+// Libera as texturas
+void VertexAnimation::release() {
+    if (this->remapTextureId != 0) {
+        glDeleteTextures(1, &this->remapTextureId);
+        this->remapTextureId = 0;
+    }
+    if (this->offsetTextureId != 0) {
+        glDeleteTextures(1, &this->offsetTextureId);
+        this->offsetTextureId = 0;
+    }
+    this->header = VatHeader{0, 0, 0, 0, 0, 0.0f};
+    this->gpuBytes = 0;
+    GLState::invalidate();
+}
+
+bool VertexAnimation::isLoaded() const {
+    return this->offsetTextureId != 0;
+}
+
+const VatHeader &VertexAnimation::getHeader() const {
+    return this->header;
+}
+
+size_t VertexAnimation::getGpuBytes() const {
+    return this->gpuBytes;
+}
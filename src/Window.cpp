@@ -11,6 +11,10 @@
 #include "Renderer.h"
 #include "SceneObject.h"
 #include "Model.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "GLExtensions.h"
+#include "AllocationTracker.h"
 
 // Definição de constantes para identificação de modelos
 #define SCENERY 0
@@ -19,14 +23,14 @@
 #define BOOMERANG 3
 
 // Construtor do objeto Window
-Window::Window() {
+Window::Window(const char* recordFilename, const char* replayFilename) {
     this->screenHeight = 800;
     this->screenWidth = 800;
-    this->camera = Camera();
-    this->renderer = Renderer();
     this->lastCursorPosX = 0;
     this->lastCursorPosY = 0;
     this->isPaused_ = true;
+    this->recordFilename = recordFilename;
+    this->replayFilename = replayFilename;
 }
 
 void Window::run() {
@@ -41,17 +45,25 @@ void Window::run() {
     // Definição do callback de erros para o terminal
     glfwSetErrorCallback(ErrorCallback);
 
-    // Utilização de OpenGL versão 3.3 ou superior
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    // Utilização de OpenGL versão 4.3 (compute shaders e desenho indireto) ou, se indisponível, 3.3
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 
     // Utilização de funções modernas de OpenGL
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    // Criação de uma janela do sistema operacional, com o título de "Boomerang Blitz"
+    // Criação de uma janela do sistema operacional, com o título de "Boomerang Blitz".
+    // A falha do contexto 4.3 não é um erro: o callback é desligado durante a primeira tentativa.
     GLFWwindow* window;
 
+    glfwSetErrorCallback(NULL);
     window = glfwCreateWindow(this->screenWidth, this->screenHeight, "Boomerang Blitz", NULL, NULL);
+    glfwSetErrorCallback(ErrorCallback);
+    if (!window) {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        window = glfwCreateWindow(this->screenWidth, this->screenHeight, "Boomerang Blitz", NULL, NULL);
+    }
     if (!window) {
         glfwTerminate();
         fprintf(stderr, "ERROR: glfwCreateWindow() failed.\n");
@@ -95,6 +107,9 @@ void Window::run() {
     // Carregamento das funções de OpenGL 3.3, utilizando a GLAD
     gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
 
+    // Funções opcionais de OpenGL 4.3 (compute shaders e desenho indireto), caso o contexto as suporte
+    GLExtensions::load((GLADloadproc) glfwGetProcAddress);
+
     // Carregamos os shaders de vértices e de fragmentos que serão utilizados para renderização.
     this->renderer.LoadShadersFromFiles();
 
@@ -111,10 +126,9 @@ void Window::run() {
                   glm::vec3(0.0f, 0.0f, 0.0f),
                   0.0f,
                   "the_scene",
-                  "../data/objects/scenery.obj",
-                  this->renderer.virtualScene);
+                  this->renderer.LoadMesh("../data/objects/scenery.obj"));
 
-    this->renderer.models.push_back(scenery);
+    this->renderer.models.push_back(std::move(scenery));
 
     // Cria modelo do robô
     Model robot(ROBOT,
@@ -123,10 +137,9 @@ void Window::run() {
                  glm::vec3(0.0f, 0.0f, 1.0f),
                  0.0f,
                  "the_robot",
-                 "../data/objects/robot.obj",
-                 this->renderer.virtualScene);
+                 this->renderer.LoadMesh("../data/objects/robot.obj"));
 
-    this->renderer.models.push_back(robot);
+    this->renderer.models.push_back(std::move(robot));
 
     // Cria modelo do zumbi
     Model zombie(ZOMBIE,
@@ -135,10 +148,9 @@ void Window::run() {
                  glm::vec3(0.0f, 0.0f, 0.0f),
                  0.0f,
                  "the_zombie",
-                 "../data/objects/zombie.obj",
-                 this->renderer.virtualScene);
+                 this->renderer.LoadMesh("../data/objects/zombie.obj"));
 
-    this->renderer.models.push_back(zombie);
+    this->renderer.models.push_back(std::move(zombie));
 
     // Cria modelo do bumerange
     Model boomerang(BOOMERANG,
@@ -147,25 +159,50 @@ void Window::run() {
                     glm::vec3(0.0f, 0.0f, 0.0f),
                     M_PI_2,
                     "the_boomerang",
-                    "../data/objects/boomerang.obj",
-                    this->renderer.virtualScene);
+                    this->renderer.LoadMesh("../data/objects/boomerang.obj"));
+
+    this->renderer.models.push_back(std::move(boomerang));
 
-    this->renderer.models.push_back(boomerang);
+    // Ciclo de caminhada dos zumbis, gerado por vat_bake a partir de data/animations/zombie_walk.anim
+    this->renderer.LoadVertexAnimation("../data/animations/zombie_walk.vat");
 
     // Inicializa o renderizador
     this->renderer.initialize();
 
+    // Reprodução ou gravação da entrada, com a mesma semente e configuração da partida
+    if (this->replayFilename != nullptr) {
+        this->renderer.startReplay(this->replayFilename);
+    }
+    else if (this->recordFilename != nullptr) {
+        this->renderer.startRecording(this->recordFilename);
+    }
+
+    // Exportação periódica das métricas de quadro
+    Metrics::configureExport("boomerang_metrics.csv", "boomerang_metrics.json");
+
     // Variável para movimentação baseada em tempo
     auto prevTime = (float) glfwGetTime();
-    auto spawnTime = prevTime;
 
     // Renderização até o usuário fechar a janela
     while (!glfwWindowShouldClose(window)) {
-        if (!this->renderer.render(window, this->isPaused_, this->camera, ((float) this->screenWidth / (float) this->screenHeight), prevTime, spawnTime)) {
+        if (!this->renderer.render(window, this->isPaused_, this->camera, this->input, ((float) this->screenWidth / (float) this->screenHeight), prevTime)) {
             break;
         }
     }
 
+    // Exportação final das métricas
+    Metrics::shutdown(glfwGetTime());
+
+    // Resumo dos tempos de CPU/GPU da sessão
+    this->renderer.shutdown();
+
+    // Resumo da latência de entrada e das alocações da sessão
+    this->input.printLatency();
+    AllocationTracker::printSummary();
+
+    // Exporta as zonas de profiling da sessão (somente com ENABLE_PROFILING)
+    PROFILE_EXPORT("boomerang_profile.json");
+
     // Finaliza o uso do sistema operacional
     glfwTerminate();
 
@@ -178,6 +215,7 @@ void Window::FramebufferSizeCallback(int width, int height)
     glViewport(0, 0, width, height);
     this->screenHeight = height;
     this->screenWidth = width;
+    this->input.setScreenSize(width, height);
 }
 
 // Definimos o callback para impressão de erros da GLFW no terminal
@@ -209,49 +247,65 @@ void Window::KeyCallback(int key, int scancode, int action, int mode) {
         }
     }
 
+    // Se o usuário apertar a tecla H, mostra ou esconde o HUD de desempenho
+    if (key == GLFW_KEY_H && action == GLFW_PRESS) {
+        this->renderer.toggleHud();
+    }
+
+    // Se o usuário apertar a tecla L, alterna a limitação de quadros enfileirados
+    if (key == GLFW_KEY_L && action == GLFW_PRESS) {
+        this->renderer.cycleFrameLimitMode();
+    }
+
+    // Se o usuário apertar a tecla G, alterna o descarte da horda entre GPU e CPU
+    if (key == GLFW_KEY_G && action == GLFW_PRESS) {
+        this->renderer.toggleGpuCulling();
+    }
+
+    // Se o usuário apertar a tecla V, alterna a simulação da horda entre GPU e CPU
+    if (key == GLFW_KEY_V && action == GLFW_PRESS) {
+        this->renderer.toggleGpuSimulation();
+    }
+
+    // Se o usuário apertar a tecla N, cria uma onda massiva de zumbis simulada na GPU
+    if (key == GLFW_KEY_N && action == GLFW_PRESS) {
+        this->renderer.spawnMassiveWave();
+    }
+
+    // Se o usuário apertar a tecla I, liga ou desliga os impostores dos zumbis distantes
+    if (key == GLFW_KEY_I && action == GLFW_PRESS) {
+        this->renderer.toggleImpostors();
+    }
+
     // Caso esteja pausado, para todos os movimentos
     if (this->isPaused_) {
-        this->camera.keys.W = false;
-        this->camera.keys.A = false;
-        this->camera.keys.S = false;
-        this->camera.keys.D = false;
+        this->input.clear(this->camera);
+
+        return;
+    }
 
+    // Teclas repetidas pelo sistema operacional não alteram o estado
+    if (action == GLFW_REPEAT) {
         return;
     }
 
-    // Se o usuário apertar as teclas de movimento
+    // Se o usuário apertar as teclas de movimento ou de tiro, o evento é enfileirado com o instante de chegada
+    double timestamp = glfwGetTime();
+    bool pressed = (action == GLFW_PRESS);
     if (key == GLFW_KEY_W) {
-        if (action == GLFW_PRESS) {
-            this->camera.keys.W = true;
-        }
-        else if (action == GLFW_RELEASE) {
-            this->camera.keys.W = false;
-        }
+        this->input.push(INPUT_W, pressed, timestamp);
     }
     if (key == GLFW_KEY_A) {
-        if (action == GLFW_PRESS) {
-            this->camera.keys.A = true;
-        }
-        else if (action == GLFW_RELEASE) {
-            this->camera.keys.A = false;
-        }
+        this->input.push(INPUT_A, pressed, timestamp);
     }
     if (key == GLFW_KEY_S) {
-        if (action == GLFW_PRESS) {
-            this->camera.keys.S = true;
-        }
-        else if (action == GLFW_RELEASE) {
-            this->camera.keys.S = false;
-
-        }
+        this->input.push(INPUT_S, pressed, timestamp);
     }
     if (key == GLFW_KEY_D) {
-        if (action == GLFW_PRESS) {
-            this->camera.keys.D = true;
-        }
-        else if (action == GLFW_RELEASE) {
-            this->camera.keys.D = false;
-        }
+        this->input.push(INPUT_D, pressed, timestamp);
+    }
+    if (key == GLFW_KEY_F) {
+        this->input.push(INPUT_F, pressed, timestamp);
     }
 
 }
@@ -264,22 +318,16 @@ void Window::MouseButtonCallback(int button, int action, int mods) {
         return;
     }
 
-    // Caso o usuário pressione os botões do mouse
-    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
-    {
-        this->camera.keys.M1 = true;
-    }
-    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE)
+    // Caso o usuário pressione os botões do mouse, o evento é enfileirado com o instante de chegada
+    double timestamp = glfwGetTime();
+    bool pressed = (action == GLFW_PRESS);
+    if (button == GLFW_MOUSE_BUTTON_LEFT)
     {
-        this->camera.keys.M1 = false;
+        this->input.push(INPUT_M1, pressed, timestamp);
     }
-    if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS)
+    if (button == GLFW_MOUSE_BUTTON_RIGHT)
     {
-        this->camera.keys.M2 = true;
-    }
-    if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_RELEASE)
-    {
-        this->camera.keys.M2 = false;
+        this->input.push(INPUT_M2, pressed, timestamp);
     }
 }
 
@@ -297,19 +345,8 @@ void Window::CursorPosCallback(double xpos, double ypos) {
         return;
     }
 
-    // Atualizamos parâmetros da câmera com os deslocamentos
-    if (this->camera.isUseFreeCamera()) {
-
-        // Em câmera livre, calcula o ângulo rotação horizontal conforme a porcentagem da tela movida
-        float angleX = dx/((float) this->screenWidth/2)  * 2 * M_PI;
-        float angleY = dy/((float) this->screenHeight/2) * 2 * M_PI;
-        this->camera.updateViewVector(angleX, angleY);
-        this->camera.updateSphericAngles(angleX);
-    }
-    else {
-        // Em câmera look-at, atualiza os angulos esféricos para os do cursor
-        this->camera.updateSphericAngles(dx, dy);
-    }
+    // Acumulamos os deslocamentos, aplicados na câmera logo antes da submissão do quadro
+    this->input.pushCursor(dx, dy, glfwGetTime());
 
     // Atualizamos as variáveis globais para armazenar a posição atual do cursor como sendo a última posição conhecida do cursor.
     this->lastCursorPosX = xpos;
@@ -1,8 +1,14 @@
 #include "collisions.h"
 
+#include <cfloat>
+#include <cmath>
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+#include "glm/vec2.hpp"
+
 // Colisão dos modelos com o cenário
 bool collisions::CubeToBox(glm::vec3 cubeBbox_min, glm::vec3 cubeBbox_max, glm::vec3 boxBbox_min, glm::vec3 boxBbox_max) {
-
     // Checa para sobreposição
     if (cubeBbox_min.x >= boxBbox_min.x &&
         cubeBbox_max.x <= boxBbox_max.x &&
@@ -16,9 +22,15 @@ bool collisions::CubeToBox(glm::vec3 cubeBbox_min, glm::vec3 cubeBbox_max, glm::
 
 }
 
+// Colisão dos modelos com os obstáculos da arena
+bool collisions::CubeToCube(glm::vec3 cube1Bbox_min, glm::vec3 cube1Bbox_max, glm::vec3 cube2Bbox_min, glm::vec3 cube2Bbox_max) {
+    // Sobreposição dos intervalos em x e em z
+    return cube1Bbox_min.x < cube2Bbox_max.x && cube1Bbox_max.x > cube2Bbox_min.x &&
+           cube1Bbox_min.z < cube2Bbox_max.z && cube1Bbox_max.z > cube2Bbox_min.z;
+}
+
 // Colisão entre objetos humanóides
 bool collisions::CylinderToCylinder(glm::vec3 cylinder1Bbox_min, glm::vec3 cylinder1Bbox_max, glm::vec3 cylinder2Bbox_min, glm::vec3 cylinder2Bbox_max) {
-
     // Cálculo de posição de cilindros
     glm::vec3 cylinder1Center = 0.5f * (cylinder1Bbox_min + cylinder1Bbox_max);
     glm::vec3 cylinder2Center = 0.5f * (cylinder2Bbox_min + cylinder2Bbox_max);
@@ -39,7 +51,6 @@ bool collisions::CylinderToCylinder(glm::vec3 cylinder1Bbox_min, glm::vec3 cylin
 
 // Colisão entre projétil e objetos
 bool collisions::CubeToCylinder(glm::vec3 cylinderBbox_min, glm::vec3 cylinderBbox_max, glm::vec3 cubeBbox_min, glm::vec3 cubeBbox_max) {
-
     // Cálculo de posição do cilindro
     glm::vec3 cylinderCenter = (cylinderBbox_min + cylinderBbox_max) * 0.5f;
     cylinderCenter.y = cubeBbox_min.y; // Set it to the same height as the cube
@@ -61,4 +72,105 @@ bool collisions::CubeToCylinder(glm::vec3 cylinderBbox_min, glm::vec3 cylinderBb
     }
 
     return false; // Não colidiu
-}
\ No newline at end of file
+}
+
+// Intervalo [tEnter, tExit] em que o raio está entre as "slabs" de um retângulo
+static bool RayToRectangle(glm::vec2 origin, glm::vec2 direction, glm::vec2 rectangleMin, glm::vec2 rectangleMax, float &tEnter, float &tExit) {
+    tEnter = -FLT_MAX;
+    tExit = FLT_MAX;
+    for (int axis = 0; axis < 2; axis++) {
+        // Raio paralelo às "slabs" do eixo: ou sempre dentro, ou nunca
+        if (direction[axis] == 0.0f) {
+            if (origin[axis] < rectangleMin[axis] || origin[axis] > rectangleMax[axis]) {
+                return false;
+            }
+            continue;
+        }
+
+        float inverse = 1.0f / direction[axis];
+        float t1 = (rectangleMin[axis] - origin[axis]) * inverse;
+        float t2 = (rectangleMax[axis] - origin[axis]) * inverse;
+        tEnter = glm::max(tEnter, glm::min(t1, t2));
+        tExit = glm::min(tExit, glm::max(t1, t2));
+        if (tEnter > tExit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Primeiro instante (t >= 0) em que o raio entra em um círculo centrado na origem
+static bool RayToCircle(glm::vec2 origin, glm::vec2 direction, float radius, float &t) {
+    float a = glm::dot(direction, direction);
+    float b = glm::dot(origin, direction);
+    float c = glm::dot(origin, origin) - radius * radius;
+    if (c <= 0.0f) {
+        t = 0.0f; // Já começa dentro
+        return true;
+    }
+
+    // Parado, ou se afastando do círculo
+    if (a == 0.0f || b >= 0.0f) {
+        return false;
+    }
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) {
+        return false;
+    }
+    t = (-b - std::sqrt(discriminant)) / a;
+    return true;
+}
+
+// Raio contra uma caixa no plano XZ
+bool collisions::RayToBox(glm::vec3 origin, glm::vec3 direction, glm::vec3 boxBbox_min, glm::vec3 boxBbox_max, float &tEnter, float &tExit) {
+    return RayToRectangle(glm::vec2(origin.x, origin.z), glm::vec2(direction.x, direction.z),
+                          glm::vec2(boxBbox_min.x, boxBbox_min.z), glm::vec2(boxBbox_max.x, boxBbox_max.z), tEnter, tExit);
+}
+
+// Colisão contínua entre projétil e objetos
+bool collisions::SweptCubeToCylinder(glm::vec3 cylinderBbox_min, glm::vec3 cylinderBbox_max, glm::vec3 cubeBbox_min, glm::vec3 cubeBbox_max,
+                                     glm::vec3 displacement, float &timeOfImpact) {
+    // Cilindro e cubo como em CubeToCylinder
+    glm::vec3 cylinderCenter = (cylinderBbox_min + cylinderBbox_max) * 0.5f;
+    float cylinderRadius = 0.5f * glm::distance(cylinderBbox_min, cylinderBbox_max);
+    glm::vec3 cubeCenter = (cubeBbox_min + cubeBbox_max) * 0.5f;
+    glm::vec3 cubeHalfDimensions = (cubeBbox_max - cubeBbox_min) * 0.5f;
+
+    // No referencial do cubo, o centro do cilindro percorre um raio de sentido contrário ao deslocamento,
+    // e o contato acontece quando o raio entra no retângulo do cubo arredondado pelo raio do cilindro
+    glm::vec2 origin = glm::vec2(cylinderCenter.x - cubeCenter.x, cylinderCenter.z - cubeCenter.z);
+    glm::vec2 direction = -glm::vec2(displacement.x, displacement.z);
+    glm::vec2 halfSize = glm::vec2(cubeHalfDimensions.x, cubeHalfDimensions.z);
+
+    // Contato já no início do passo (o mesmo teste de CubeToCylinder)
+    glm::vec2 collisionVector = origin - glm::clamp(origin, -halfSize, halfSize);
+    if (glm::dot(collisionVector, collisionVector) < cylinderRadius * cylinderRadius) {
+        timeOfImpact = 0.0f;
+        return true;
+    }
+
+    // O retângulo arredondado é a união de dois retângulos (expandidos em X e em Z) com quatro círculos nos cantos
+    float first = FLT_MAX;
+    float tEnter, tExit;
+    glm::vec2 expansions[2] = {glm::vec2(cylinderRadius, 0.0f), glm::vec2(0.0f, cylinderRadius)};
+    for (glm::vec2 expansion : expansions) {
+        if (RayToRectangle(origin, direction, -halfSize - expansion, halfSize + expansion, tEnter, tExit) && tExit >= 0.0f) {
+            first = glm::min(first, glm::max(tEnter, 0.0f));
+        }
+    }
+    for (int corner = 0; corner < 4; corner++) {
+        glm::vec2 cornerPosition = glm::vec2(corner & 1 ? halfSize.x : -halfSize.x, corner & 2 ? halfSize.y : -halfSize.y);
+        float t;
+        if (RayToCircle(origin - cornerPosition, direction, cylinderRadius, t)) {
+            first = glm::min(first, t);
+        }
+    }
+
+    if (first <= 1.0f) {
+        timeOfImpact = first;
+        return true; // Colidiu durante o passo
+    }
+
+    return false; // Não colidiu
+}
@@ -4,6 +4,11 @@
 
 #include "../include/matrices.h"
 
+#include <cmath>
+#include <cstdint>
+
+#include <glm/glm/simd/common.h>
+
 // Esta função Matrix() auxilia na criação de matrizes usando a biblioteca GLM.
 // Note que em OpenGL (e GLM) as matrizes são definidas como "column-major",
 // onde os elementos da matriz são armazenadas percorrendo as COLUNAS da mesma.
@@ -41,12 +46,7 @@ glm::mat4 Matrix(
 // Matriz identidade.
 glm::mat4 Matrix_Identity()
 {
-    return Matrix(
-            1.0f , 0.0f , 0.0f , 0.0f , // LINHA 1
-            0.0f , 1.0f , 0.0f , 0.0f , // LINHA 2
-            0.0f , 0.0f , 1.0f , 0.0f , // LINHA 3
-            0.0f , 0.0f , 0.0f , 1.0f   // LINHA 4
-    );
+    return glm::mat4(1.0f);
 }
 
 // Matriz de translação T. Seja p=[px,py,pz,pw] um ponto e t=[tx,ty,tz,0] um
@@ -57,11 +57,12 @@ glm::mat4 Matrix_Identity()
 //
 glm::mat4 Matrix_Translate(float tx, float ty, float tz)
 {
-    return Matrix(
-            1.0f , 0.0f , 0.0f , tx ,    // LINHA 1
-            0.0f , 1.0f , 0.0f , ty ,    // LINHA 2
-            0.0f , 0.0f , 1.0f , tz ,    // LINHA 3
-            0.0f , 0.0f , 0.0f , 1.0f    // LINHA 4
+    // Construída diretamente por colunas, sem a transposição de Matrix()
+    return glm::mat4(
+            1.0f , 0.0f , 0.0f , 0.0f ,  // COLUNA 1
+            0.0f , 1.0f , 0.0f , 0.0f ,  // COLUNA 2
+            0.0f , 0.0f , 1.0f , 0.0f ,  // COLUNA 3
+            tx   , ty   , tz   , 1.0f    // COLUNA 4
     );
 }
 
@@ -73,11 +74,11 @@ glm::mat4 Matrix_Translate(float tx, float ty, float tz)
 //
 glm::mat4 Matrix_Scale(float sx, float sy, float sz)
 {
-    return Matrix(
-            sx   , 0.0f , 0.0f , 0.0f ,  // LINHA 1
-            0.0f , sy   , 0.0f , 0.0f ,  // LINHA 2
-            0.0f , 0.0f , sz   , 0.0f ,  // LINHA 3
-            0.0f , 0.0f , 0.0f , 1.0f    // LINHA 4
+    return glm::mat4(
+            sx   , 0.0f , 0.0f , 0.0f ,  // COLUNA 1
+            0.0f , sy   , 0.0f , 0.0f ,  // COLUNA 2
+            0.0f , 0.0f , sz   , 0.0f ,  // COLUNA 3
+            0.0f , 0.0f , 0.0f , 1.0f    // COLUNA 4
     );
 }
 
@@ -91,13 +92,13 @@ glm::mat4 Matrix_Scale(float sx, float sy, float sz)
 // onde 'c' e 's' são o cosseno e o seno do ângulo de rotação, respectivamente.
 glm::mat4 Matrix_Rotate_X(float angle)
 {
-    float c = cos(angle);
-    float s = sin(angle);
-    return Matrix(
-            1.0f , 0.0f , 0.0f , 0.0f ,  // LINHA 1
-            0.0f , c    , -s   , 0.0f ,  // LINHA 2
-            0.0f , s    , c    , 0.0f ,  // LINHA 3
-            0.0f , 0.0f , 0.0f , 1.0f    // LINHA 4
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    return glm::mat4(
+            1.0f , 0.0f , 0.0f , 0.0f ,  // COLUNA 1
+            0.0f , c    , s    , 0.0f ,  // COLUNA 2
+            0.0f , -s   , c    , 0.0f ,  // COLUNA 3
+            0.0f , 0.0f , 0.0f , 1.0f    // COLUNA 4
     );
 }
 
@@ -111,13 +112,13 @@ glm::mat4 Matrix_Rotate_X(float angle)
 // onde 'c' e 's' são o cosseno e o seno do ângulo de rotação, respectivamente.
 glm::mat4 Matrix_Rotate_Y(float angle)
 {
-    float c = cos(angle);
-    float s = sin(angle);
-    return Matrix(
-            c    , 0.0f , s    , 0.0f ,  // LINHA 1
-            0.0f , 1.0f , 0.0f , 0.0f ,  // LINHA 2
-            -s   , 0.0f , c    , 0.0f ,  // LINHA 3
-            0.0f , 0.0f , 0.0f , 1.0f    // LINHA 4
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    return glm::mat4(
+            c    , 0.0f , -s   , 0.0f ,  // COLUNA 1
+            0.0f , 1.0f , 0.0f , 0.0f ,  // COLUNA 2
+            s    , 0.0f , c    , 0.0f ,  // COLUNA 3
+            0.0f , 0.0f , 0.0f , 1.0f    // COLUNA 4
     );
 }
 
@@ -131,16 +132,103 @@ glm::mat4 Matrix_Rotate_Y(float angle)
 // onde 'c' e 's' são o cosseno e o seno do ângulo de rotação, respectivamente.
 glm::mat4 Matrix_Rotate_Z(float angle)
 {
-    float c = cos(angle);
-    float s = sin(angle);
-    return Matrix(
-            c    , -s   , 0.0f , 0.0f ,  // LINHA 1
-            s    , c    , 0.0f , 0.0f ,  // LINHA 2
-            0.0f , 0.0f , 1.0f , 0.0f ,  // LINHA 3
-            0.0f , 0.0f , 0.0f , 1.0f    // LINHA 4
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    return glm::mat4(
+            c    , s    , 0.0f , 0.0f ,  // COLUNA 1
+            -s   , c    , 0.0f , 0.0f ,  // COLUNA 2
+            0.0f , 0.0f , 1.0f , 0.0f ,  // COLUNA 3
+            0.0f , 0.0f , 0.0f , 1.0f    // COLUNA 4
+    );
+}
+
+// Composição T*S*R_y montada diretamente: as linhas da rotação em Y são multiplicadas pela escala
+// e a translação ocupa a última coluna, sem nenhum produto de matrizes.
+glm::mat4 Matrix_TRS_Y(glm::vec3 t, glm::vec3 s, float yaw)
+{
+    float c = std::cos(yaw);
+    float sn = std::sin(yaw);
+    return glm::mat4(
+            s.x * c   , 0.0f , -s.z * sn , 0.0f ,  // COLUNA 1
+            0.0f      , s.y  , 0.0f      , 0.0f ,  // COLUNA 2
+            s.x * sn  , 0.0f , s.z * c   , 0.0f ,  // COLUNA 3
+            t.x       , t.y  , t.z       , 1.0f    // COLUNA 4
+    );
+}
+
+glm::mat4 Matrix_TRS_Y(glm::vec3 t, float s, float yaw)
+{
+    return Matrix_TRS_Y(t, glm::vec3(s, s, s), yaw);
+}
+
+// Composição T*S*R com a rotação dada por um quatérnio unitário q = (w, x, y, z)
+glm::mat4 Matrix_TRS(glm::vec3 t, glm::vec3 s, glm::quat q)
+{
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    return glm::mat4(
+            s.x * (1.0f - 2.0f * (yy + zz)) , s.y * (2.0f * (xy + wz))        , s.z * (2.0f * (xz - wy))        , 0.0f ,  // COLUNA 1
+            s.x * (2.0f * (xy - wz))        , s.y * (1.0f - 2.0f * (xx + zz)) , s.z * (2.0f * (yz + wx))        , 0.0f ,  // COLUNA 2
+            s.x * (2.0f * (xz + wy))        , s.y * (2.0f * (yz - wx))        , s.z * (1.0f - 2.0f * (xx + yy)) , 0.0f ,  // COLUNA 3
+            t.x                             , t.y                             , t.z                             , 1.0f    // COLUNA 4
     );
 }
 
+glm::mat4 Matrix_TRS(glm::vec3 t, float s, glm::quat q)
+{
+    return Matrix_TRS(t, glm::vec3(s, s, s), q);
+}
+
+// Versão em lote de Matrix_TRS_Y. Com os intrinsics da GLM habilitados (ENABLE_SIMD), cada coluna é montada
+// e gravada como um registrador de 4 floats; as gravações são alinhadas quando o destino está em 16 bytes.
+void Matrix_TRS_Y_Batch(const glm::vec4* positionYaw, size_t count, glm::vec3 s, glm::mat4* out)
+{
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    const glm_vec4 scale = _mm_set_ps(0.0f, s.z, s.y, s.x);
+    const glm_vec4 column2 = _mm_set_ps(0.0f, 0.0f, s.y, 0.0f);
+    const glm_vec4 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const glm_vec4 wOne = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+    const bool aligned = ((uintptr_t) out & 15) == 0;
+
+    for (size_t i = 0; i < count; i++) {
+        float c = std::cos(positionYaw[i].w);
+        float sn = std::sin(positionYaw[i].w);
+
+        glm_vec4 columns[4];
+        columns[0] = glm_vec4_mul(_mm_set_ps(0.0f, -sn, 0.0f, c), scale);
+        columns[1] = column2;
+        columns[2] = glm_vec4_mul(_mm_set_ps(0.0f, c, 0.0f, sn), scale);
+        columns[3] = _mm_or_ps(_mm_and_ps(_mm_loadu_ps(&positionYaw[i].x), xyzMask), wOne);
+
+        float* destination = &out[i][0][0];
+        if (aligned) {
+            for (int column = 0; column < 4; column++) {
+                _mm_store_ps(destination + 4 * column, columns[column]);
+            }
+        }
+        else {
+            for (int column = 0; column < 4; column++) {
+                _mm_storeu_ps(destination + 4 * column, columns[column]);
+            }
+        }
+    }
+#else
+    for (size_t i = 0; i < count; i++) {
+        out[i] = Matrix_TRS_Y(glm::vec3(positionYaw[i]), s, positionYaw[i].w);
+    }
+#endif
+}
+
+// Versão em lote de Matrix_TRS
+void Matrix_TRS_Batch(const glm::vec3* t, const glm::quat* q, size_t count, glm::vec3 s, glm::mat4* out)
+{
+    for (size_t i = 0; i < count; i++) {
+        out[i] = Matrix_TRS(t[i], s, q[i]);
+    }
+}
+
 // Função que calcula a norma Euclidiana de um vetor cujos coeficientes são
 // definidos em uma base ortonormal qualquer.
 float norm(glm::vec4 v)
@@ -163,8 +251,8 @@ glm::vec4 normalize (glm::vec4 v) {
 // eixo de rotação deve ser normalizado!
 glm::mat4 Matrix_Rotate(float angle, glm::vec4 axis)
 {
-    float c = cos(angle);
-    float s = sin(angle);
+    float c = std::cos(angle);
+    float s = std::sin(angle);
 
     glm::vec4 v = axis / norm(axis);
 
@@ -0,0 +1,146 @@
+#version 430 core
+
+// Descarte da horda de zumbis: cada invocação testa um inimigo contra o frustum e a distância máxima.
+// Os inimigos visíveis recebem uma posição no buffer de instâncias, reservada com um incremento atômico
+// do número de instâncias do comando de desenho indireto, até o orçamento de malhas; os excedentes viram
+// impostores. Inimigos distantes recebem também (ou somente) uma posição no buffer de impostores, conforme
+// a faixa de transição.
+layout (local_size_x = 64) in;
+
+// Posição (xyz) e rotação em torno de Y (w), e fase da animação (x) de cada inimigo, enviadas pela CPU.
+// Nos impostores, "animation.y" guarda a opacidade na transição.
+// Com "simulated_state", o buffer é o estado da horda simulada na GPU ("HordeAgent"): posição (xyz) e
+// velocidade (w); ângulo inicial (x), rotação em Y (y), vivo (z) e fase da animação (w).
+struct Enemy {
+    vec4 position_yaw;
+    vec4 animation;
+};
+
+layout (std430, binding = 0) readonly buffer Enemies {
+    Enemy enemies[];
+};
+
+// Matrizes de modelo das instâncias visíveis, lidas como atributo de vértice (location = 3)
+layout (std430, binding = 1) writeonly buffer Instances {
+    mat4 instances[];
+};
+
+// Comando lido por glDrawElementsIndirect
+layout (std430, binding = 2) buffer Command {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+// Impostores dos inimigos distantes, lidos como atributos por instância em "impostor_vertex.glsl"
+layout (std430, binding = 3) writeonly buffer Impostors {
+    Enemy impostors[];
+};
+
+// Comando lido por glDrawArraysIndirect, seguido do número de inimigos que passaram pelo descarte
+layout (std430, binding = 4) buffer ImpostorCommand {
+    uint impostorVertexCount;
+    uint impostorInstanceCount;
+    uint impostorFirst;
+    uint impostorBaseInstance;
+    uint drawnCount;
+    uint meshRequests;
+};
+
+uniform int enemy_count;
+
+// Buffer com o estado da horda simulada na GPU (1) ou com os inimigos enviados pela CPU (0)
+uniform int simulated_state;
+
+// Número máximo de inimigos desenhados com a malha
+uniform int mesh_budget;
+
+// Planos do frustum normalizados, apontando para dentro
+uniform vec4 frustum_planes[6];
+
+// Posição da câmera (xyz) e distância máxima de desenho (w)
+uniform vec4 camera_position;
+
+// Escala do modelo do zumbi
+uniform vec4 instance_scale;
+
+// Esfera envolvente: altura do centro (x) e raio (y), já escalados
+uniform vec4 bounds;
+
+// Distância em que começa a transição para impostor (x) e largura da faixa (y)
+uniform vec4 impostor_range;
+
+void main()
+{
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= uint(enemy_count))
+        return;
+
+    vec4 enemy = enemies[i].position_yaw;
+    float phase = enemies[i].animation.x;
+    if (simulated_state != 0)
+    {
+        // Zumbis mortos ou posições livres
+        if (enemies[i].animation.z == 0.0)
+            return;
+        enemy.w = enemies[i].animation.y;
+        phase = enemies[i].animation.w;
+    }
+    vec3 center = vec3(enemy.x, enemy.y + bounds.x, enemy.z);
+    float radius = bounds.y;
+
+    // Descarte por distância
+    if (distance(center, camera_position.xyz) > camera_position.w + radius)
+        return;
+
+    // Descarte por frustum: esfera totalmente atrás de algum plano
+    for (int plane = 0; plane < 6; plane++)
+    {
+        if (dot(frustum_planes[plane].xyz, center) + frustum_planes[plane].w < -radius)
+            return;
+    }
+
+    atomicAdd(drawnCount, 1u);
+
+    // Transição para impostor: 0 = somente malha, 1 = somente impostor
+    float blend = clamp((distance(center, camera_position.xyz) - impostor_range.x) / impostor_range.y, 0.0, 1.0);
+
+    // Posição no buffer de instâncias; acima do orçamento, o incremento é desfeito (o total volta ao orçamento
+    // quando todas as invocações excedentes terminam) e o inimigo passa a ser somente impostor
+    uint slot = 0u;
+    if (blend < 1.0)
+    {
+        atomicAdd(meshRequests, 1u);
+        slot = atomicAdd(instanceCount, 1u);
+        if (slot >= uint(mesh_budget))
+        {
+            atomicAdd(instanceCount, 0xFFFFFFFFu);
+            blend = 1.0;
+        }
+    }
+
+    if (blend > 0.0)
+    {
+        uint impostor = atomicAdd(impostorInstanceCount, 1u);
+        impostors[impostor].position_yaw = enemy;
+        impostors[impostor].animation = vec4(phase, blend, 0.0, 0.0);
+    }
+
+    if (blend >= 1.0)
+        return;
+
+    // Matriz de modelo: Translate * Scale * Rotate_Y, como em Matrix_Translate/Scale/Rotate_Y (colunas).
+    // A fase da animação vai no elemento (3, 0) e a transição no (3, 1), nulos em uma matriz afim (ver "shader_vertex.glsl").
+    float c = cos(enemy.w);
+    float s = sin(enemy.w);
+    mat4 model = mat4(
+        vec4(instance_scale.x * c, 0.0, -instance_scale.z * s, phase),
+        vec4(0.0, instance_scale.y, 0.0, blend),
+        vec4(instance_scale.x * s, 0.0, instance_scale.z * c, 0.0),
+        vec4(enemy.xyz, 1.0)
+    );
+
+    instances[slot] = model;
+}
@@ -0,0 +1,11 @@
+#version 330 core
+
+// Reduções da simulação da horda, somadas com blending aditivo no framebuffer 1x1
+flat in vec4 reduction;
+
+out vec4 color;
+
+void main()
+{
+    color = reduction;
+}
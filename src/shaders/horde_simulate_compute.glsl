@@ -0,0 +1,152 @@
+#version 430 core
+
+// Simulação da horda com compute shader (OpenGL 4.3): cada invocação atualiza um zumbi do buffer de estado
+// atual e escreve os vivos, compactados, no início do outro buffer (zerado antes do passo). O buffer escrito
+// é lido depois pelo descarte da horda ("horde_cull_compute.glsl").
+// As reduções do quadro são acumuladas com incrementos atômicos e copiadas para leitura assíncrona.
+layout (local_size_x = 64) in;
+
+struct Agent {
+    vec4 state0; // Posição (xyz) e velocidade (w)
+    vec4 state1; // Ângulo da direção inicial (x), rotação em Y (y), vivo (z), fase da animação (w)
+};
+
+layout (std430, binding = 0) readonly buffer Agents {
+    Agent agents[];
+};
+
+layout (std430, binding = 2) writeonly buffer CompactedAgents {
+    Agent compacted_agents[];
+};
+
+// "alive" é também o número de zumbis escritos no buffer compactado
+layout (std430, binding = 1) buffer Results {
+    uint player_hits;
+    uint kills;
+    uint alive;
+    uint padding;
+};
+
+uniform int slot_count;
+uniform float delta_t;
+uniform vec4 target;
+uniform vec4 player_bbox_min;
+uniform vec4 player_bbox_max;
+
+// Projéteis do quadro: centro (xy) e "raios" (zw) da bounding box no plano XZ, no início do deslocamento,
+// e deslocamento no passo (xy). Deve ser igual a HORDE_SIM_MAX_PROJECTILES em "HordeSimulation.h"
+#define MAX_PROJECTILES 16
+uniform int projectile_count;
+uniform vec4 projectile_boxes[MAX_PROJECTILES];
+uniform vec4 projectile_sweeps[MAX_PROJECTILES];
+
+// Meias larguras da bounding box do zumbi em X (x) e Z (y)
+uniform vec4 half_extents;
+
+// Ciclos da animação de caminhada por unidade de distância percorrida
+uniform float animation_rate;
+
+// Mesmo teste de collisions::CylinderToCylinder
+bool cylinderToCylinder(vec3 min1, vec3 max1, vec3 min2, vec3 max2)
+{
+    float radii = 0.5 * distance(min1, max1) + 0.5 * distance(min2, max2);
+    return distance(0.5 * (min1 + max1), 0.5 * (min2 + max2)) <= radii;
+}
+
+// Mesmo teste de collisions::SweptCubeToCylinder: o cubo se desloca por "sweep" durante o passo
+float rayToCircle(vec2 origin, vec2 direction, float radius)
+{
+    float a = dot(direction, direction);
+    float b = dot(origin, direction);
+    float c = dot(origin, origin) - radius * radius;
+    if (c <= 0.0)
+        return 0.0;
+    float discriminant = b * b - a * c;
+    if (a == 0.0 || b >= 0.0 || discriminant < 0.0)
+        return 2.0;
+    return (-b - sqrt(discriminant)) / a;
+}
+
+float rayToRectangle(vec2 origin, vec2 direction, vec2 rectangle_min, vec2 rectangle_max)
+{
+    float t_enter = -1e30;
+    float t_exit = 1e30;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (direction[axis] == 0.0)
+        {
+            if (origin[axis] < rectangle_min[axis] || origin[axis] > rectangle_max[axis])
+                return 2.0;
+            continue;
+        }
+        float t1 = (rectangle_min[axis] - origin[axis]) / direction[axis];
+        float t2 = (rectangle_max[axis] - origin[axis]) / direction[axis];
+        t_enter = max(t_enter, min(t1, t2));
+        t_exit = min(t_exit, max(t1, t2));
+    }
+    return (t_enter > t_exit || t_exit < 0.0) ? 2.0 : max(t_enter, 0.0);
+}
+
+bool sweptCubeToCylinder(vec3 cylinderMin, vec3 cylinderMax, vec4 box, vec2 sweep)
+{
+    vec3 center = 0.5 * (cylinderMin + cylinderMax);
+    float radius = 0.5 * distance(cylinderMin, cylinderMax);
+    vec2 half_size = box.zw;
+    vec2 origin = center.xz - box.xy;
+    vec2 direction = -sweep;
+
+    vec2 collision = origin - clamp(origin, -half_size, half_size);
+    if (dot(collision, collision) < radius * radius)
+        return true;
+
+    float first = min(rayToRectangle(origin, direction, -half_size - vec2(radius, 0.0), half_size + vec2(radius, 0.0)),
+                      rayToRectangle(origin, direction, -half_size - vec2(0.0, radius), half_size + vec2(0.0, radius)));
+    first = min(first, rayToCircle(origin - half_size, direction, radius));
+    first = min(first, rayToCircle(origin + half_size, direction, radius));
+    first = min(first, rayToCircle(origin - vec2(half_size.x, -half_size.y), direction, radius));
+    first = min(first, rayToCircle(origin - vec2(-half_size.x, half_size.y), direction, radius));
+    return first <= 1.0;
+}
+
+// Na GPU, qualquer acerto de projétil mata o zumbi e os projéteis não são gastos
+bool hitByProjectile(vec3 bbox_min, vec3 bbox_max)
+{
+    for (int p = 0; p < projectile_count; p++)
+    {
+        if (sweptCubeToCylinder(bbox_min, bbox_max, projectile_boxes[p], projectile_sweeps[p].xy))
+            return true;
+    }
+    return false;
+}
+
+void main()
+{
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= uint(slot_count))
+        return;
+
+    // Zumbis mortos (ou posições zeradas) não são copiados: a posição fica livre para novos zumbis
+    Agent agent = agents[i];
+    if (agent.state1.z == 0.0)
+        return;
+
+    vec3 position = agent.state0.xyz;
+    vec3 extents = vec3(half_extents.x, 0.0, half_extents.y);
+    vec3 bbox_min = position - extents;
+    vec3 bbox_max = position + extents;
+
+    if (cylinderToCylinder(bbox_min, bbox_max, player_bbox_min.xyz, player_bbox_max.xyz))
+        atomicAdd(player_hits, 1u);
+
+    if (hitByProjectile(bbox_min, bbox_max))
+    {
+        atomicAdd(kills, 1u);
+        return;
+    }
+
+    vec3 player_direction = normalize(target.xyz - position);
+    agent.state0.xyz = position + player_direction * delta_t * agent.state0.w;
+    agent.state1.y = agent.state1.x - atan(player_direction.z, player_direction.x);
+    agent.state1.w = fract(agent.state1.w + delta_t * agent.state0.w * animation_rate);
+    compacted_agents[atomicAdd(alive, 1u)] = agent;
+}
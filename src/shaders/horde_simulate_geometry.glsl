@@ -0,0 +1,30 @@
+#version 330 core
+
+// Compactação da horda simulada com transform feedback: somente os zumbis vivos no início do passo são emitidos
+// e capturados, em sequência, no início do segundo buffer de estado. Os mortos no passo ainda são emitidos (com
+// "vivo" nulo) para que o ponto some a morte na redução; eles são descartados no passo seguinte.
+layout (points) in;
+layout (points, max_vertices = 1) out;
+
+in vec4 vertex_state0[];
+in vec4 vertex_state1[];
+flat in vec4 vertex_reduction[];
+
+out vec4 out_state0;
+out vec4 out_state1;
+
+// Robô atingido (x), zumbi morto (y) e zumbi vivo (z)
+flat out vec4 reduction;
+
+void main()
+{
+    if (vertex_reduction[0].y + vertex_reduction[0].z == 0.0)
+        return;
+
+    out_state0 = vertex_state0[0];
+    out_state1 = vertex_state1[0];
+    reduction = vertex_reduction[0];
+    gl_Position = gl_in[0].gl_Position;
+    EmitVertex();
+    EndPrimitive();
+}
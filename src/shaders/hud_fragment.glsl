@@ -0,0 +1,15 @@
+#version 330 core
+
+in vec2 texcoords;
+in vec4 color_v;
+
+// Atlas de glifos de um canal (cobertura)
+uniform sampler2D FontAtlas;
+
+out vec4 color;
+
+void main()
+{
+    // A cobertura do glifo define a opacidade do fragmento
+    color = vec4(color_v.rgb, color_v.a * texture(FontAtlas, texcoords).r);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+
+// Atributos de vértice do HUD, em coordenadas de tela (pixels)
+layout (location = 0) in vec2 position_screen;
+layout (location = 1) in vec2 texture_coefficients;
+layout (location = 2) in vec4 color_coefficients;
+
+// Dimensões da tela em pixels
+uniform vec2 screen_size;
+
+out vec2 texcoords;
+out vec4 color_v;
+
+void main()
+{
+    // Converte de pixels (origem no canto superior esquerdo) para NDC
+    vec2 ndc = vec2(position_screen.x / screen_size.x * 2.0 - 1.0,
+                    1.0 - position_screen.y / screen_size.y * 2.0);
+    gl_Position = vec4(ndc, 0.0, 1.0);
+
+    texcoords = texture_coefficients;
+    color_v = color_coefficients;
+}
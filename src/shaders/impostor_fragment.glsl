@@ -0,0 +1,36 @@
+#version 330 core
+
+in vec2 texcoords;
+
+// Opacidade na transição (1 = somente impostor)
+flat in float impostor_blend;
+
+// Atlas com as vistas do zumbi, já iluminadas e com correção gamma
+uniform sampler2D ImpostorAtlas;
+
+// Cor final do fragmento.
+out vec4 color;
+
+// Limiar de dithering ordenado (matriz de Bayer 4x4) do pixel, em [0, 1) - o mesmo de "shader_fragment.glsl"
+float BayerThreshold(vec2 pixel)
+{
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 p = ivec2(pixel) % 4;
+    return (bayer[p.y * 4 + p.x] + 0.5) / 16.0;
+}
+
+void main()
+{
+    vec4 texel = texture(ImpostorAtlas, texcoords);
+
+    // Fora da silhueta capturada
+    if (texel.a < 0.5)
+        discard;
+
+    // Na faixa de transição, desenha somente os pixels descartados pela malha
+    if (BayerThreshold(gl_FragCoord.xy) >= impostor_blend)
+        discard;
+
+    // As bordas filtradas foram misturadas com o fundo transparente (preto) da captura
+    color = vec4(texel.rgb / texel.a, 1.0);
+}
@@ -0,0 +1,56 @@
+#version 330 core
+
+// Impostor de um zumbi distante: quadrilátero voltado para a câmera (girando somente em torno de Y),
+// texturizado com a vista do atlas mais próxima da direção de observação.
+
+// Atributos por instância: posição (xyz) e rotação em Y (w); fase da animação (x) e opacidade na transição (y)
+layout (location = 0) in vec4 position_yaw;
+layout (location = 1) in vec4 animation;
+
+// Matrizes computadas no código C++ e enviadas para a GPU
+uniform mat4 view;
+uniform mat4 projection;
+
+// Largura (x), altura (y) e base (z) do retângulo capturado, já escalados para o mundo
+uniform vec4 impostor_size;
+
+// Número de vistas (x), colunas (y) e linhas (z) do atlas
+uniform vec4 impostor_grid;
+
+out vec2 texcoords;
+flat out float impostor_blend;
+
+void main()
+{
+    // Cantos do triangle strip: (0, 0), (1, 0), (0, 1), (1, 1)
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+
+    // Obtemos a posição da câmera utilizando a inversa da matriz que define a sistema de coordenadas da câmera.
+    vec4 camera_position = inverse(view) * vec4(0.0, 0.0, 0.0, 1.0);
+
+    // Direção horizontal do zumbi para a câmera
+    vec3 to_camera = camera_position.xyz - position_yaw.xyz;
+    to_camera.y = 0.0;
+    if (dot(to_camera, to_camera) < 1e-8)
+        to_camera = vec3(0.0, 0.0, 1.0);
+    to_camera = normalize(to_camera);
+    vec3 right = normalize(cross(vec3(0.0, 1.0, 0.0), to_camera));
+
+    vec3 position = position_yaw.xyz
+                  + right * (corner.x - 0.5) * impostor_size.x
+                  + vec3(0.0, impostor_size.z + corner.y * impostor_size.y, 0.0);
+    gl_Position = projection * view * vec4(position, 1.0);
+
+    // Direção da câmera no espaço do modelo (inverso de Matrix_Rotate_Y) e vista capturada mais próxima
+    float c = cos(position_yaw.w);
+    float s = sin(position_yaw.w);
+    vec2 local = vec2(c * to_camera.x - s * to_camera.z, s * to_camera.x + c * to_camera.z);
+    float views = impostor_grid.x;
+    int view_index = int(floor(atan(local.x, local.y) / (6.28318531 / views) + 0.5));
+    view_index = (view_index + int(views)) % int(views);
+
+    vec2 cell = vec2(float(view_index % int(impostor_grid.y)), float(view_index / int(impostor_grid.y)));
+    texcoords = (cell + corner) / impostor_grid.yz;
+
+    impostor_blend = animation.y;
+}
@@ -19,6 +19,7 @@ uniform mat4 projection;
 #define ROBOT 1
 #define ZOMBIE 2
 #define BOOMERANG 3
+#define OBSTACLE 4
 uniform int object_id;
 
 // Parâmetros da axis-aligned bounding box (AABB) do modelo
@@ -33,9 +34,20 @@ uniform sampler2D BoomerangTexture;
 // Cor gerada por Gouraud
 in vec4 color_v;
 
+// Transição para impostor dos zumbis distantes (0 = malha opaca)
+flat in float impostor_blend;
+
 // Cor final do fragmento.
 out vec4 color;
 
+// Limiar de dithering ordenado (matriz de Bayer 4x4) do pixel, em [0, 1)
+float BayerThreshold(vec2 pixel)
+{
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 p = ivec2(pixel) % 4;
+    return (bayer[p.y * 4 + p.x] + 0.5) / 16.0;
+}
+
 void main()
 {
     // Obtemos a posição da câmera utilizando a inversa da matriz que define a sistema de coordenadas da câmera.
@@ -91,6 +103,13 @@ void main()
             Ka = Kd / 2.0;
             q = 32.0;
         }
+        else if ( object_id == OBSTACLE ) {
+            // Propriedades espectrais das muretas de madeira
+            Kd = texture(BoomerangTexture, texcoords).rgb;
+            Ks = vec3(0.1,0.1,0.1);
+            Ka = Kd / 2.0;
+            q = 16.0;
+        }
         else // Objeto desconhecido = preto
         {
             Kd = vec3(0.0,0.0,0.0);
@@ -122,6 +141,10 @@ void main()
         color.rgb = pow(color.rgb, vec3(1.0,1.0,1.0)/2.2);
     }
     else {
+        // Na faixa de transição, o impostor desenha exatamente os pixels descartados aqui
+        if (BayerThreshold(gl_FragCoord.xy) < impostor_blend)
+            discard;
+
         color = color_v;
     }
 } 
@@ -5,14 +5,32 @@ layout (location = 0) in vec4 model_coefficients;
 layout (location = 1) in vec4 normal_coefficients;
 layout (location = 2) in vec2 texture_coefficients;
 
+// Matriz de modelo por instância, usada no desenho instanciado da horda
+layout (location = 3) in mat4 instance_model;
+
+// Projéteis por instância: posição (xyz) e giro em Z (w); escala (xyz) e inclinação em X (w)
+layout (location = 9) in vec4 instance_projectile0;
+layout (location = 10) in vec4 instance_projectile1;
+
 // Textura do zumbi
 uniform sampler2D ZombieTexture;
 
+// Animação por textura de vértices do zumbi: posição do OBJ de cada vértice e deslocamentos de cada quadro
+uniform usampler2D ZombieAnimationRemap;
+uniform sampler2D ZombieAnimation;
+
+// Número de posições (x), de quadros (y, 0 = sem animação), largura das texturas (z) e primeiro vértice da malha (w)
+uniform ivec4 vat_info;
+
 // Matrizes computadas no código C++ e enviadas para a GPU
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+// Origem da matriz de modelo: uniform "model" (0), atributo por instância (1) ou projéteis por instância (3).
+// A horda simulada na GPU passa pelo descarte e também é desenhada com as matrizes por instância (1).
+uniform int instanced;
+
 // Identificador que define qual objeto está sendo desenhado no momento
 #define SCENE 0
 #define ROBOT 1
@@ -27,19 +45,71 @@ out vec4 normal;
 out vec2 texcoords;
 out vec4 color_v;
 
+// Transição para impostor dos zumbis distantes (0 = malha opaca), aplicada com dithering no fragment shader
+flat out float impostor_blend;
+
+// Deslocamento de uma posição do OBJ em um quadro da animação
+vec3 AnimationOffset(uint position, int frame)
+{
+    int texel = frame * vat_info.x + int(position);
+    return texelFetch(ZombieAnimation, ivec2(texel % vat_info.z, texel / vat_info.z), 0).xyz;
+}
+
 void main()
 {
+    vec4 local_position = model_coefficients;
+    mat4 model_matrix = model;
+    float animation_phase = 0.0;
+    impostor_blend = 0.0;
+    if (instanced == 1)
+    {
+        // A fase da animação e a transição para impostor ocupam os elementos (3, 0) e (3, 1) da matriz,
+        // sempre nulos em uma matriz afim
+        model_matrix = instance_model;
+        animation_phase = model_matrix[0][3];
+        impostor_blend = model_matrix[1][3];
+        model_matrix[0][3] = 0.0;
+        model_matrix[1][3] = 0.0;
+    }
+    else if (instanced == 3)
+    {
+        // Translate * Scale * Rotate_X(inclinação) * Rotate_Z(giro), como em Matrix_TRS (colunas)
+        float cx = cos(instance_projectile1.w);
+        float sx = sin(instance_projectile1.w);
+        float cz = cos(instance_projectile0.w);
+        float sz = sin(instance_projectile0.w);
+        vec3 scale = instance_projectile1.xyz;
+        model_matrix = mat4(
+            vec4(scale * vec3(cz, cx * sz, sx * sz), 0.0),
+            vec4(scale * vec3(-sz, cx * cz, sx * cz), 0.0),
+            vec4(scale * vec3(0.0, -sx, cx), 0.0),
+            vec4(instance_projectile0.xyz, 1.0)
+        );
+    }
+
+    // Zumbis instanciados: interpolação entre os dois quadros vizinhos da fase
+    if (instanced != 0 && object_id == ZOMBIE && vat_info.y > 0)
+    {
+        int vertex = gl_VertexID - vat_info.w;
+        uint position = texelFetch(ZombieAnimationRemap, ivec2(vertex % vat_info.z, vertex / vat_info.z), 0).r;
+
+        float frame = fract(animation_phase) * float(vat_info.y);
+        int frame0 = int(frame) % vat_info.y;
+        int frame1 = (frame0 + 1) % vat_info.y;
+        local_position.xyz += mix(AnimationOffset(position, frame0), AnimationOffset(position, frame1), fract(frame));
+    }
+
     // Define a posição final de cada vértice em NDC.
-    gl_Position = projection * view * model * model_coefficients;
+    gl_Position = projection * view * model_matrix * local_position;
 
     // Posição do vértice atual no sistema de coordenadas global (World).
-    position_world = model * model_coefficients;
+    position_world = model_matrix * local_position;
 
     // Posição do vértice atual no sistema de coordenadas local do modelo.
-    position_model = model_coefficients;
+    position_model = local_position;
 
     // Normal do vértice atual no sistema de coordenadas global (World).
-    normal = inverse(transpose(model)) * normal_coefficients;
+    normal = inverse(transpose(model_matrix)) * normal_coefficients;
     normal.w = 0.0;
 
     // Coordenadas de textura obtidas do arquivo OBJ (se existirem!)
@@ -0,0 +1,650 @@
+// Microbenchmarks dos kernels de matemática, colisão, trajetórias e processamento de malhas do jogo.
+//
+// Uso: bench [filtro] [amostras]
+//
+// Cada caso processa um lote de entradas de tamanho realista (MAX_ENEMIES matrizes ou pares de colisão por
+// quadro, ou as malhas de data/objects) e é comparado, quando existe, com o equivalente da GLM. O número de
+// repetições por amostra é calibrado para que cada amostra dure pelo menos BENCH_MIN_SAMPLE_MS; após
+// BENCH_WARMUP_SAMPLES amostras descartadas, são medidas as amostras e impressos o mínimo, a mediana, a
+// média, o desvio padrão e o percentil 95 do tempo por item. Os resultados também são exportados em
+// bench_results.csv e bench_results.json. Com um filtro, só os casos cujo grupo ou nome o contém são medidos.
+// Antes das medições, verifica que os caminhos de Catmull-Rom passam pelos seus pontos e que Trajectory::evaluate()
+// avança distâncias iguais sobre a curva; retorna 1 se a verificação falhar.
+
+// Headers de C++
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "glm/geometric.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "matrices.h"
+#include "collisions.h"
+#include "Mesh.h"
+#include "ProjectileSystem.h"
+#include "Simulation.h"
+#include "Trajectory.h"
+
+// Amostras medidas e descartadas por caso
+#define BENCH_DEFAULT_SAMPLES 30
+#define BENCH_WARMUP_SAMPLES 3
+
+// Duração mínima de uma amostra; repetições mais curtas são agrupadas
+#define BENCH_MIN_SAMPLE_MS 2.0
+
+// Tamanho dos lotes de entradas: uma horda completa por quadro
+#define BENCH_BATCH MAX_ENEMIES
+
+// Passos iguais em que as curvas são percorridas na verificação, e desvio relativo máximo de cada passo
+#define CHECK_TRAJECTORY_STEPS 200
+#define CHECK_TRAJECTORY_TOLERANCE 0.02f
+
+// Barreiras contra otimizações: o compilador deve considerar o valor usado e a memória alterada
+#if defined(__GNUC__) || defined(__clang__)
+template <typename T>
+static inline void DoNotOptimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+static inline void ClobberMemory() {
+    asm volatile("" : : : "memory");
+}
+#else
+#include <intrin.h>
+
+static volatile const void* BenchSink;
+
+template <typename T>
+static inline void DoNotOptimize(const T &value) {
+    BenchSink = &value;
+    _ReadWriteBarrier();
+}
+
+static inline void ClobberMemory() {
+    _ReadWriteBarrier();
+}
+#endif
+
+// Resultado de um caso, em nanossegundos por item
+struct BenchResult {
+    std::string group;
+    std::string name;
+    std::string baseline;  // Caso de referência (equivalente da GLM), se houver
+    size_t items;          // Itens processados por repetição
+    size_t iterations;     // Repetições por amostra
+    size_t samples;
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double stddevNs;
+    double p95Ns;
+};
+
+static std::vector<BenchResult> Results;
+static const char* Filter = nullptr;
+static int Samples = BENCH_DEFAULT_SAMPLES;
+
+// Gerador congruente linear, para entradas reprodutíveis
+static float NextRandom(unsigned int &seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return (float) (seed >> 8) / (float) (1u << 24);
+}
+
+// Tempo de "iterations" repetições, em nanossegundos
+template <typename Function>
+static double TimeIterations(const Function &function, size_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        function();
+        ClobberMemory();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Mede um caso: calibração, aquecimento, amostras e estatísticas
+template <typename Function>
+static void Measure(const char* group, const char* name, const char* baseline, size_t items, const Function &function) {
+    if (Filter != nullptr && strstr(group, Filter) == nullptr && strstr(name, Filter) == nullptr) {
+        return;
+    }
+
+    // Dobra as repetições até que uma amostra dure o mínimo
+    size_t iterations = 1;
+    while (TimeIterations(function, iterations) < BENCH_MIN_SAMPLE_MS * 1e6 && iterations < ((size_t) 1 << 30)) {
+        iterations *= 2;
+    }
+
+    for (int sample = 0; sample < BENCH_WARMUP_SAMPLES; sample++) {
+        TimeIterations(function, iterations);
+    }
+
+    std::vector<double> perItem((size_t) Samples);
+    for (double &value : perItem) {
+        value = TimeIterations(function, iterations) / ((double) iterations * (double) items);
+    }
+    std::sort(perItem.begin(), perItem.end());
+
+    BenchResult result;
+    result.group = group;
+    result.name = name;
+    result.baseline = baseline != nullptr ? baseline : "";
+    result.items = items;
+    result.iterations = iterations;
+    result.samples = perItem.size();
+    result.minNs = perItem.front();
+    result.medianNs = perItem[perItem.size() / 2];
+    result.p95Ns = perItem[std::min(perItem.size() - 1, (size_t) std::ceil(0.95 * (double) perItem.size()) - 1)];
+
+    double sum = 0.0;
+    for (double value : perItem) {
+        sum += value;
+    }
+    result.meanNs = sum / (double) perItem.size();
+    double variance = 0.0;
+    for (double value : perItem) {
+        variance += (value - result.meanNs) * (value - result.meanNs);
+    }
+    result.stddevNs = std::sqrt(variance / (double) perItem.size());
+
+    // Razão em relação à referência, se ela já foi medida
+    const BenchResult* reference = nullptr;
+    for (const BenchResult &other : Results) {
+        if (other.group == result.group && other.name == result.baseline) {
+            reference = &other;
+        }
+    }
+    if (reference != nullptr) {
+        printf("%-12s %-34s %8zu %10.2f %10.2f %10.2f %8.2f  %.2fx %s\n", group, name, items, result.minNs, result.medianNs,
+               result.p95Ns, result.stddevNs, result.medianNs / reference->medianNs, reference->name.c_str());
+    }
+    else {
+        printf("%-12s %-34s %8zu %10.2f %10.2f %10.2f %8.2f\n", group, name, items, result.minNs, result.medianNs, result.p95Ns, result.stddevNs);
+    }
+    Results.push_back(result);
+}
+
+// Transformações de matrizes e vetores: funções de matrices.cpp contra as da GLM
+static void BenchMatrices() {
+    unsigned int seed = 1234u;
+    std::vector<glm::vec4> a(BENCH_BATCH), b(BENCH_BATCH);
+    std::vector<float> angles(BENCH_BATCH);
+    for (size_t i = 0; i < BENCH_BATCH; i++) {
+        a[i] = glm::vec4(NextRandom(seed) * 16.0f - 8.0f, NextRandom(seed) * 4.0f, NextRandom(seed) * 16.0f - 8.0f, 0.0f);
+        b[i] = glm::vec4(NextRandom(seed) - 0.5f, NextRandom(seed) - 0.5f, NextRandom(seed) - 0.5f, 0.0f);
+        angles[i] = NextRandom(seed) * 6.2831853f;
+    }
+    std::vector<glm::mat4> matrices(BENCH_BATCH);
+    std::vector<glm::vec4> vectors(BENCH_BATCH);
+    std::vector<float> scalars(BENCH_BATCH);
+    const glm::mat4 identity = glm::mat4(1.0f);
+
+    Measure("matrices", "glm::translate", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = glm::translate(identity, glm::vec3(a[i]));
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_Translate", "glm::translate", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_Translate(a[i].x, a[i].y, a[i].z);
+        DoNotOptimize(matrices.data());
+    });
+
+    Measure("matrices", "glm::scale", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = glm::scale(identity, glm::vec3(a[i]));
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_Scale", "glm::scale", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_Scale(a[i].x, a[i].y, a[i].z);
+        DoNotOptimize(matrices.data());
+    });
+
+    Measure("matrices", "glm::rotate(X)", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = glm::rotate(identity, angles[i], glm::vec3(1.0f, 0.0f, 0.0f));
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_Rotate_X", "glm::rotate(X)", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_Rotate_X(angles[i]);
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "glm::rotate(Y)", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = glm::rotate(identity, angles[i], glm::vec3(0.0f, 1.0f, 0.0f));
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_Rotate_Y", "glm::rotate(Y)", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_Rotate_Y(angles[i]);
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "glm::rotate(Z)", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = glm::rotate(identity, angles[i], glm::vec3(0.0f, 0.0f, 1.0f));
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_Rotate_Z", "glm::rotate(Z)", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_Rotate_Z(angles[i]);
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "glm::rotate(eixo)", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = glm::rotate(identity, angles[i], glm::vec3(b[i]));
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_Rotate", "glm::rotate(eixo)", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_Rotate(angles[i], b[i]);
+        DoNotOptimize(matrices.data());
+    });
+
+    // Matriz de modelo de um zumbi, como montada a cada quadro: T * S * R_y
+    Measure("matrices", "glm T*S*Ry", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) {
+            matrices[i] = glm::rotate(glm::scale(glm::translate(identity, glm::vec3(a[i])), glm::vec3(0.3f)), angles[i], glm::vec3(0.0f, 1.0f, 0.0f));
+        }
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_Translate*Scale*Rotate_Y", "glm T*S*Ry", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) {
+            matrices[i] = Matrix_Translate(a[i].x, a[i].y, a[i].z) * Matrix_Scale(0.3f, 0.3f, 0.3f) * Matrix_Rotate_Y(angles[i]);
+        }
+        DoNotOptimize(matrices.data());
+    });
+
+    std::vector<glm::vec4> positionYaw(BENCH_BATCH);
+    for (size_t i = 0; i < BENCH_BATCH; i++) {
+        positionYaw[i] = glm::vec4(a[i].x, a[i].y, a[i].z, angles[i]);
+    }
+    Measure("matrices", "Matrix_TRS_Y", "glm T*S*Ry", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_TRS_Y(glm::vec3(positionYaw[i]), 0.3f, positionYaw[i].w);
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_TRS_Y_Batch", "glm T*S*Ry", BENCH_BATCH, [&]() {
+        Matrix_TRS_Y_Batch(positionYaw.data(), BENCH_BATCH, glm::vec3(0.3f), matrices.data());
+        DoNotOptimize(matrices.data());
+    });
+
+    // Rotação arbitrária por quatérnio (bumerange: inclinação em X e giro em Z)
+    std::vector<glm::vec3> translations(BENCH_BATCH);
+    std::vector<glm::quat> orientations(BENCH_BATCH);
+    for (size_t i = 0; i < BENCH_BATCH; i++) {
+        translations[i] = glm::vec3(a[i]);
+        orientations[i] = glm::angleAxis(angles[i], glm::normalize(glm::vec3(b[i]) + glm::vec3(0.0f, 0.0f, 0.01f)));
+    }
+    Measure("matrices", "glm T*S*R(quat)", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) {
+            matrices[i] = glm::scale(glm::translate(identity, translations[i]), glm::vec3(0.05f)) * glm::mat4_cast(orientations[i]);
+        }
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_TRS", "glm T*S*R(quat)", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_TRS(translations[i], 0.05f, orientations[i]);
+        DoNotOptimize(matrices.data());
+    });
+    Measure("matrices", "Matrix_TRS_Batch", "glm T*S*R(quat)", BENCH_BATCH, [&]() {
+        Matrix_TRS_Batch(translations.data(), orientations.data(), BENCH_BATCH, glm::vec3(0.05f), matrices.data());
+        DoNotOptimize(matrices.data());
+    });
+
+    Measure("vectors", "glm::normalize", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) vectors[i] = glm::normalize(b[i]);
+        DoNotOptimize(vectors.data());
+    });
+    Measure("vectors", "normalize", "glm::normalize", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) vectors[i] = normalize(b[i]);
+        DoNotOptimize(vectors.data());
+    });
+    Measure("vectors", "glm::length", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) scalars[i] = glm::length(b[i]);
+        DoNotOptimize(scalars.data());
+    });
+    Measure("vectors", "norm", "glm::length", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) scalars[i] = norm(b[i]);
+        DoNotOptimize(scalars.data());
+    });
+    Measure("vectors", "glm::cross", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) vectors[i] = glm::vec4(glm::cross(glm::vec3(a[i]), glm::vec3(b[i])), 0.0f);
+        DoNotOptimize(vectors.data());
+    });
+    Measure("vectors", "crossproduct", "glm::cross", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) vectors[i] = crossproduct(a[i], b[i]);
+        DoNotOptimize(vectors.data());
+    });
+    Measure("vectors", "glm::dot", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) scalars[i] = glm::dot(a[i], b[i]);
+        DoNotOptimize(scalars.data());
+    });
+    Measure("vectors", "dotproduct", "glm::dot", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) scalars[i] = dotproduct(a[i], b[i]);
+        DoNotOptimize(scalars.data());
+    });
+
+    // Câmera e projeção: uma vez por quadro no jogo, medidas em lote para reduzir o ruído
+    const glm::vec4 up = glm::vec4(0.0f, 1.0f, 0.0f, 0.0f);
+    Measure("camera", "glm::lookAt", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = glm::lookAt(glm::vec3(a[i]), glm::vec3(a[i] + b[i]), glm::vec3(up));
+        DoNotOptimize(matrices.data());
+    });
+    Measure("camera", "Matrix_Camera_View", "glm::lookAt", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) {
+            matrices[i] = Matrix_Camera_View(glm::vec4(a[i].x, a[i].y, a[i].z, 1.0f), b[i], up);
+        }
+        DoNotOptimize(matrices.data());
+    });
+    Measure("camera", "glm::perspective", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = glm::perspective(0.5f + angles[i] * 0.1f, 1.0f + b[i].x, 0.1f, 100.0f);
+        DoNotOptimize(matrices.data());
+    });
+    Measure("camera", "Matrix_Perspective", "glm::perspective", BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) matrices[i] = Matrix_Perspective(0.5f + angles[i] * 0.1f, 1.0f + b[i].x, -0.1f, -100.0f);
+        DoNotOptimize(matrices.data());
+    });
+}
+
+// Testes de colisão de collisions.cpp, com caixas do tamanho dos modelos espalhadas pela arena
+static void BenchCollisions() {
+    unsigned int seed = 4321u;
+    const SimulationConfig config;
+    std::vector<glm::vec3> minA(BENCH_BATCH), maxA(BENCH_BATCH), minB(BENCH_BATCH), maxB(BENCH_BATCH);
+    for (size_t i = 0; i < BENCH_BATCH; i++) {
+        glm::vec3 p = glm::vec3(NextRandom(seed) * 4.0f - 2.0f, 0.0f, NextRandom(seed) * 4.0f - 2.0f);
+        glm::vec3 q = glm::vec3(NextRandom(seed) * 4.0f - 2.0f, 0.0f, NextRandom(seed) * 4.0f - 2.0f);
+        minA[i] = p - glm::vec3(config.zombieHalfSize.x, 0.0f, config.zombieHalfSize.y);
+        maxA[i] = p + glm::vec3(config.zombieHalfSize.x, 0.0f, config.zombieHalfSize.y);
+        minB[i] = q - glm::vec3(config.robotHalfSize.x, 0.0f, config.robotHalfSize.y);
+        maxB[i] = q + glm::vec3(config.robotHalfSize.x, 0.0f, config.robotHalfSize.y);
+    }
+    std::vector<uint8_t> hits(BENCH_BATCH);
+
+    Measure("collisions", "CubeToBox", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) hits[i] = collisions::CubeToBox(minB[i], maxB[i], config.sceneryBboxMin, config.sceneryBboxMax);
+        DoNotOptimize(hits.data());
+    });
+    Measure("collisions", "CylinderToCylinder", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) hits[i] = collisions::CylinderToCylinder(minA[i], maxA[i], minB[i], maxB[i]);
+        DoNotOptimize(hits.data());
+    });
+    Measure("collisions", "CubeToCylinder", nullptr, BENCH_BATCH, [&]() {
+        for (size_t i = 0; i < BENCH_BATCH; i++) hits[i] = collisions::CubeToCylinder(minA[i], maxA[i], minB[i], maxB[i]);
+        DoNotOptimize(hits.data());
+    });
+}
+
+// Caminho de Catmull-Rom de um projétil: sai da origem na direção dada, abre para o lado e volta para perto dela
+static void CatmullRomPath(glm::vec3 origin, glm::vec3 direction, glm::vec3* path) {
+    glm::vec3 side = glm::vec3(-direction.z, 0.0f, direction.x);
+    path[0] = origin;
+    path[1] = origin + 3.0f * direction + 1.0f * side;
+    path[2] = origin + 6.0f * direction + 3.0f * side;
+    path[3] = origin + 4.0f * direction + 5.0f * side;
+    path[4] = origin + 1.0f * direction + 2.0f * side;
+}
+
+// Distância sobre a curva em que o parâmetro chega a "parameter" (busca binária, pois parameterAt() é crescente)
+static float DistanceAtParameter(const Trajectory &path, float parameter) {
+    float low = 0.0f;
+    float high = path.getLength();
+    for (int i = 0; i < 40; i++) {
+        float middle = 0.5f * (low + high);
+        if (path.parameterAt(middle) < parameter) {
+            low = middle;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return 0.5f * (low + high);
+}
+
+// Maior desvio relativo da distância entre posições consecutivas, ao percorrer a curva em passos iguais
+static float ArcLengthDeviation(const Trajectory &path) {
+    float step = path.getLength() / (float) CHECK_TRAJECTORY_STEPS;
+    float deviation = 0.0f;
+    glm::vec3 previous = path.evaluate(0.0f);
+    for (int i = 1; i <= CHECK_TRAJECTORY_STEPS; i++) {
+        glm::vec3 point = path.evaluate((float) i * step);
+        deviation = std::max(deviation, std::fabs(glm::distance(previous, point) - step) / step);
+        previous = point;
+    }
+    return deviation;
+}
+
+// Verificações das curvas: o caminho de Catmull-Rom passa pelos seus pontos (nas fronteiras dos segmentos),
+// evaluate() anda distâncias iguais em passos iguais, e um projétil TRAJECTORY_CURVE anda "velocidade * delta_t"
+// por passo de ProjectileSystem::update()
+static bool CheckTrajectories() {
+    bool passed = true;
+
+    glm::vec3 points[5];
+    CatmullRomPath(glm::vec3(0.0f, 0.7f, 0.0f), glm::normalize(glm::vec3(1.0f, 0.0f, 2.0f)), points);
+    Trajectory catmullRom;
+    if (!catmullRom.setCatmullRom(points, 5)) {
+        printf("Trajectory: FALHOU (setCatmullRom recusou 5 pontos)\n");
+        return false;
+    }
+
+    float worstPoint = 0.0f;
+    for (int k = 0; k < 5; k++) {
+        glm::vec3 point = catmullRom.evaluate(DistanceAtParameter(catmullRom, (float) k));
+        worstPoint = std::max(worstPoint, glm::distance(point, points[k]));
+    }
+    bool throughPoints = worstPoint < 1e-3f;
+    printf("Trajectory: Catmull-Rom passa pelos 5 pontos: %s (maior distancia %.2e)\n", throughPoints ? "OK" : "FALHOU", worstPoint);
+    passed = passed && throughPoints;
+
+    Trajectory cubic;
+    cubic.setCubicBezier(glm::vec3(0.0f, 0.7f, 0.0f), glm::vec3(0.0f, 0.7f, 6.0f), glm::vec3(6.0f, 0.7f, -2.0f), glm::vec3(7.0f, 0.7f, 4.0f));
+    const Trajectory* curves[2] = {&catmullRom, &cubic};
+    const char* names[2] = {"Catmull-Rom", "Bezier cubica"};
+    for (int curve = 0; curve < 2; curve++) {
+        float deviation = ArcLengthDeviation(*curves[curve]);
+        bool constant = deviation < CHECK_TRAJECTORY_TOLERANCE;
+        printf("Trajectory: %s com passos de comprimento de arco iguais: %s (desvio maximo %.2f%%)\n", names[curve],
+               constant ? "OK" : "FALHOU", 100.0 * deviation);
+        passed = passed && constant;
+    }
+
+    // Projétil lançado sobre o caminho: todos os passos completos têm o mesmo deslocamento
+    ProjectileSystem projectiles;
+    ProjectileLaunch launch;
+    launch.kind = PROJECTILE_BOOMERANG;
+    launch.trajectory = TRAJECTORY_CURVE;
+    launch.origin = points[0];
+    launch.speed = 6.0f;
+    launch.lifetime = 10.0f;
+    launch.piercing = true;
+    launch.path = catmullRom;
+    projectiles.launch(launch);
+
+    float step = launch.speed / 60.0f;
+    float deviation = 0.0f;
+    int steps = (int) (catmullRom.getLength() / step);
+    for (int i = 0; i < steps; i++) {
+        projectiles.update(1.0f / 60.0f, false, glm::vec3(-100.0f, 0.0f, -100.0f), glm::vec3(100.0f, 0.0f, 100.0f));
+        deviation = std::max(deviation, std::fabs(glm::length(projectiles.getSweeps()[0]) - step) / step);
+    }
+    bool launched = projectiles.getCount() == 1 && deviation < CHECK_TRAJECTORY_TOLERANCE;
+    printf("ProjectileSystem: projetil TRAJECTORY_CURVE em %d passos de %.3f: %s (desvio maximo %.2f%%)\n", steps, step,
+           launched ? "OK" : "FALHOU", 100.0 * deviation);
+    return passed && launched;
+}
+
+// Trajetórias dos projéteis: avaliação direta da Bézier de grau 2 no parâmetro (velocidade variável) contra a
+// avaliação pelo comprimento de arco, a montagem das curvas feita uma vez por lançamento (Bézier de grau 2 e 3
+// e Catmull-Rom) e um passo de projéteis lançados sobre caminhos de Catmull-Rom
+static void BenchTrajectories() {
+    unsigned int seed = 2468u;
+    std::vector<Trajectory> paths(MAX_PROJECTILES);
+    std::vector<glm::vec3> controls(MAX_PROJECTILES), targets(MAX_PROJECTILES), positions(MAX_PROJECTILES);
+    std::vector<float> parameters(MAX_PROJECTILES);
+    const glm::vec3 origin = glm::vec3(0.0f, 0.0f, 0.0f);
+    for (size_t i = 0; i < MAX_PROJECTILES; i++) {
+        float angle = NextRandom(seed) * 6.2831853f;
+        glm::vec3 direction = glm::vec3(std::cos(angle), 0.0f, std::sin(angle));
+        controls[i] = 5.25f * glm::vec3(-direction.z, 0.0f, direction.x);
+        targets[i] = 7.5f * direction;
+        paths[i].setQuadraticBezier(origin, controls[i], targets[i]);
+        parameters[i] = NextRandom(seed);
+    }
+
+    Measure("trajectory", "QuadraticBezier(t)", nullptr, MAX_PROJECTILES, [&]() {
+        for (size_t i = 0; i < MAX_PROJECTILES; i++) {
+            float t = parameters[i];
+            glm::vec3 c12 = origin + t * (controls[i] - origin);
+            glm::vec3 c23 = controls[i] + t * (targets[i] - controls[i]);
+            positions[i] = c12 + t * (c23 - c12);
+        }
+        DoNotOptimize(positions.data());
+    });
+    Measure("trajectory", "Trajectory::evaluate", "QuadraticBezier(t)", MAX_PROJECTILES, [&]() {
+        for (size_t i = 0; i < MAX_PROJECTILES; i++) positions[i] = paths[i].evaluate(parameters[i] * paths[i].getLength());
+        DoNotOptimize(positions.data());
+    });
+    Measure("trajectory", "Trajectory::setQuadraticBezier", nullptr, MAX_PROJECTILES, [&]() {
+        for (size_t i = 0; i < MAX_PROJECTILES; i++) paths[i].setQuadraticBezier(origin, controls[i], targets[i]);
+        DoNotOptimize(paths.data());
+    });
+    Measure("trajectory", "Trajectory::setCubicBezier", nullptr, MAX_PROJECTILES, [&]() {
+        for (size_t i = 0; i < MAX_PROJECTILES; i++) paths[i].setCubicBezier(origin, controls[i], controls[i] + targets[i], targets[i]);
+        DoNotOptimize(paths.data());
+    });
+
+    // Caminhos de Catmull-Rom com 5 pontos (4 segmentos)
+    std::vector<glm::vec3> points(MAX_PROJECTILES * 5);
+    for (size_t i = 0; i < MAX_PROJECTILES; i++) {
+        CatmullRomPath(origin, glm::normalize(targets[i]), &points[i * 5]);
+    }
+    Measure("trajectory", "Trajectory::setCatmullRom", nullptr, MAX_PROJECTILES, [&]() {
+        for (size_t i = 0; i < MAX_PROJECTILES; i++) paths[i].setCatmullRom(&points[i * 5], 5);
+        DoNotOptimize(paths.data());
+    });
+
+    // Lançamento de MAX_PROJECTILES projéteis TRAJECTORY_CURVE sobre esses caminhos e um passo de update()
+    ProjectileSystem projectiles;
+    std::vector<ProjectileLaunch> launches(MAX_PROJECTILES);
+    for (size_t i = 0; i < MAX_PROJECTILES; i++) {
+        launches[i].trajectory = TRAJECTORY_CURVE;
+        launches[i].origin = origin;
+        launches[i].speed = 6.0f;
+        launches[i].lifetime = 10.0f;
+        launches[i].piercing = true;
+        launches[i].path.setCatmullRom(&points[i * 5], 5);
+    }
+    const SimulationConfig config;
+    Measure("trajectory", "ProjectileSystem curva (lanca+passo)", nullptr, MAX_PROJECTILES, [&]() {
+        projectiles.clear();
+        for (size_t i = 0; i < MAX_PROJECTILES; i++) projectiles.launch(launches[i]);
+        projectiles.update(1.0f / 60.0f, false, config.sceneryBboxMin, config.sceneryBboxMax);
+        DoNotOptimize(projectiles.getPositions());
+    });
+}
+
+// Etapas de CPU do carregamento das malhas: normais de Gouraud e montagem dos vértices no formato comum
+static void BenchMeshes() {
+    const char* paths[] = {"../data/objects/boomerang.obj", "../data/objects/robot.obj", "../data/objects/zombie.obj"};
+    const char* names[][2] = {{"ComputeNormals(boomerang)", "BuildTriangles(boomerang)"},
+                              {"ComputeNormals(robot)", "BuildTriangles(robot)"},
+                              {"ComputeNormals(zombie)", "BuildTriangles(zombie)"}};
+
+    for (int mesh = 0; mesh < 3; mesh++) {
+        if (Filter != nullptr && strstr("mesh", Filter) == nullptr && strstr(names[mesh][0], Filter) == nullptr && strstr(names[mesh][1], Filter) == nullptr) {
+            continue;
+        }
+
+        LoadedObj obj;
+        try {
+            obj = LoadedObj(paths[mesh]);
+        }
+        catch (const std::exception &exception) {
+            fprintf(stderr, "ERROR: Malha \"%s\" indisponivel: %s\n", paths[mesh], exception.what());
+            continue;
+        }
+
+        size_t triangles = 0;
+        for (const tinyobj::shape_t &shape : obj.shapes) {
+            triangles += shape.mesh.num_face_vertices.size();
+        }
+        if (triangles == 0) {
+            continue;
+        }
+
+        // As normais são descartadas antes de cada repetição, para que sejam sempre recalculadas
+        Measure("mesh", names[mesh][0], nullptr, triangles, [&]() {
+            obj.attrib.normals.clear();
+            Mesh::ComputeNormals(obj);
+            DoNotOptimize(obj.attrib.normals.data());
+        });
+
+        std::vector<StaticVertex> vertices;
+        std::vector<GLuint> indices;
+        std::vector<MeshShapeRange> shapeRanges;
+        Measure("mesh", names[mesh][1], nullptr, triangles, [&]() {
+            Mesh::BuildTriangles(obj, vertices, indices, shapeRanges);
+            DoNotOptimize(vertices.data());
+        });
+    }
+}
+
+// Exporta os resultados em CSV e JSON
+static void Export(const char* csvFilename, const char* jsonFilename) {
+    FILE* csv = fopen(csvFilename, "w");
+    if (csv != nullptr) {
+        fprintf(csv, "group,name,baseline,items,iterations,samples,min_ns,median_ns,mean_ns,stddev_ns,p95_ns\n");
+        for (const BenchResult &result : Results) {
+            fprintf(csv, "%s,%s,%s,%zu,%zu,%zu,%.4f,%.4f,%.4f,%.4f,%.4f\n", result.group.c_str(), result.name.c_str(), result.baseline.c_str(),
+                    result.items, result.iterations, result.samples, result.minNs, result.medianNs, result.meanNs, result.stddevNs, result.p95Ns);
+        }
+        fclose(csv);
+    }
+    else {
+        fprintf(stderr, "ERROR: Nao foi possivel criar \"%s\".\n", csvFilename);
+    }
+
+    FILE* json = fopen(jsonFilename, "w");
+    if (json == nullptr) {
+        fprintf(stderr, "ERROR: Nao foi possivel criar \"%s\".\n", jsonFilename);
+        return;
+    }
+#if defined(__VERSION__)
+    const char* compiler = __VERSION__;
+#else
+    const char* compiler = "desconhecido";
+#endif
+#if defined(NDEBUG)
+    const char* optimized = "true";
+#else
+    const char* optimized = "false";
+#endif
+    fprintf(json, "{\n  \"compiler\": \"%s\",\n  \"ndebug\": %s,\n  \"unit\": \"ns/item\",\n  \"results\": [\n", compiler, optimized);
+    for (size_t i = 0; i < Results.size(); i++) {
+        const BenchResult &result = Results[i];
+        fprintf(json, "    {\"group\": \"%s\", \"name\": \"%s\", \"baseline\": \"%s\", \"items\": %zu, \"iterations\": %zu, \"samples\": %zu, "
+                      "\"min_ns\": %.4f, \"median_ns\": %.4f, \"mean_ns\": %.4f, \"stddev_ns\": %.4f, \"p95_ns\": %.4f}%s\n",
+                result.group.c_str(), result.name.c_str(), result.baseline.c_str(), result.items, result.iterations, result.samples,
+                result.minNs, result.medianNs, result.meanNs, result.stddevNs, result.p95Ns, i + 1 < Results.size() ? "," : "");
+    }
+    fprintf(json, "  ]\n}\n");
+    fclose(json);
+}
+
+int main(int argc, char* argv[]) {
+    Filter = argc > 1 && strcmp(argv[1], "*") != 0 ? argv[1] : nullptr;
+    Samples = argc > 2 ? std::max(1, atoi(argv[2])) : BENCH_DEFAULT_SAMPLES;
+
+#if !defined(NDEBUG)
+    printf("Aviso: compilado sem NDEBUG - use uma build Release para medicoes representativas\n");
+#endif
+    printf("%d amostras por caso apos %d de aquecimento, amostras de pelo menos %.1f ms; tempos em ns por item\n",
+           Samples, BENCH_WARMUP_SAMPLES, BENCH_MIN_SAMPLE_MS);
+    printf("%-12s %-34s %8s %10s %10s %10s %8s  %s\n", "grupo", "caso", "itens", "minimo", "mediana", "p95", "desvio", "vs. GLM");
+
+    bool checked = CheckTrajectories();
+
+    BenchMatrices();
+    BenchCollisions();
+    BenchTrajectories();
+    BenchMeshes();
+
+    Export("bench_results.csv", "bench_results.json");
+    printf("Resultados exportados em bench_results.csv e bench_results.json\n");
+    return checked ? 0 : 1;
+}
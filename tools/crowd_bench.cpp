@@ -0,0 +1,248 @@
+// Benchmark do passo de simulação da horda na CPU: campo de direções + separação com a grade espacial.
+//
+// Uso: crowd_bench [passos]
+//
+// Para 1000, 10000 e 50000 agentes, espalhados com densidade constante em uma arena quadrada com muretas e
+// perseguindo um alvo no centro, mede o tempo médio por passo (direção, separação, integração e atualização
+// da grade) e o tempo do recálculo do campo de direções (Dijkstra) quando o alvo muda de célula.
+// Como referência, também mede a separação ingênua O(n^2) com 1000 agentes. Antes das medições, verifica
+// que um agente atrás de uma mureta a contorna até o alvo sem entrar nela; retorna 1 se a verificação falhar.
+
+// Headers de C++
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "CrowdGrid.h"
+#include "FlowField.h"
+
+// Agentes por unidade de área da arena
+#define BENCH_DENSITY 1.0f
+
+// Passos descartados antes da medição
+#define BENCH_WARMUP_TICKS 10
+
+// Passo de simulação (60 Hz)
+#define BENCH_DELTA_T (1.0f / 60.0f)
+
+// Muretas da arena: uma a cada BENCH_WALL_SPACING unidades, com o comprimento e a espessura abaixo
+#define BENCH_WALL_SPACING 8.0f
+#define BENCH_WALL_LENGTH 4.0f
+#define BENCH_WALL_THICKNESS 0.5f
+
+// Metade do tamanho dos agentes, somada aos obstáculos como em Simulation::initialize()
+#define BENCH_AGENT_HALF_SIZE 0.2f
+
+// Recálculos do campo medidos por arena
+#define BENCH_FIELD_UPDATES 10
+
+struct BenchResult {
+    double averageMs;
+    double minMs;
+    double testsPerAgent;
+    double fieldMs;
+    int obstacles;
+};
+
+// Gerador congruente linear, para posições reprodutíveis
+static float NextRandom(unsigned int &seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return (float) (seed >> 8) / (float) (1u << 24);
+}
+
+// Obstáculo aumentado pela metade do tamanho dos agentes
+static void AddObstacle(FlowField &flowField, glm::vec3 min, glm::vec3 max) {
+    glm::vec3 halfSize = glm::vec3(BENCH_AGENT_HALF_SIZE, 0.0f, BENCH_AGENT_HALF_SIZE);
+    flowField.addObstacle(min - halfSize, max + halfSize);
+}
+
+// Deslocamento que não entra em células bloqueadas, como em Simulation::UpdateHorde(): desliza só em x ou só em z
+static glm::vec3 Move(glm::vec3 position, glm::vec3 velocity, const FlowField &flowField) {
+    glm::vec3 newPosition = position + velocity * BENCH_DELTA_T;
+    if (!flowField.isBlocked(newPosition) || flowField.isBlocked(position)) {
+        return newPosition;
+    }
+    glm::vec3 slideX = glm::vec3(newPosition.x, position.y, position.z);
+    if (!flowField.isBlocked(slideX)) {
+        return slideX;
+    }
+    glm::vec3 slideZ = glm::vec3(position.x, position.y, newPosition.z);
+    if (!flowField.isBlocked(slideZ)) {
+        return slideZ;
+    }
+    return position;
+}
+
+// Um passo da horda, como no laço dos zumbis em Simulation::UpdateHorde()
+static void Tick(std::vector<glm::vec3> &positions, const FlowField &flowField, CrowdGrid &crowd, glm::vec3 target, float speed, uint64_t &pairTests) {
+    for (int i = 0; i < (int) positions.size(); i++) {
+        glm::vec3 velocity = flowField.direction(positions[i], target) * speed
+                           + crowd.separation(i, pairTests) * (CROWD_SEPARATION_WEIGHT * speed);
+        float velocityLength = std::sqrt(velocity.x * velocity.x + velocity.z * velocity.z);
+        if (velocityLength > speed) {
+            velocity *= speed / velocityLength;
+        }
+        positions[i] = Move(positions[i], velocity, flowField);
+        crowd.update(i, positions[i]);
+    }
+}
+
+// Um agente atrás de uma mureta, sem linha de visão até o alvo, deve contorná-la pela ponta e chegar ao alvo
+// sem entrar em células bloqueadas
+static bool CheckDetour() {
+    FlowField flowField;
+    flowField.initialize(glm::vec3(-6.0f, 0.0f, -6.0f), glm::vec3(6.0f, 0.0f, 6.0f), FLOW_FIELD_CELL_SIZE);
+    AddObstacle(flowField, glm::vec3(-3.0f, 0.0f, -0.25f), glm::vec3(3.0f, 0.5f, 0.25f));
+
+    glm::vec3 target = glm::vec3(0.0f, 0.0f, 3.0f);
+    glm::vec3 position = glm::vec3(0.0f, 0.0f, -3.0f);
+    if (!flowField.update(target)) {
+        printf("Contorno da mureta: FALHOU (o campo de direcoes nao foi calculado)\n");
+        return false;
+    }
+
+    float widest = 0.0f;
+    for (int tick = 0; tick < 1800; tick++) {
+        position = Move(position, flowField.direction(position, target), flowField);
+        widest = std::max(widest, std::fabs(position.x));
+        if (flowField.isBlocked(position)) {
+            printf("Contorno da mureta: FALHOU (agente dentro da mureta em (%.2f, %.2f), passo %d)\n", position.x, position.z, tick);
+            return false;
+        }
+        float dx = target.x - position.x;
+        float dz = target.z - position.z;
+        if (std::sqrt(dx * dx + dz * dz) < FLOW_FIELD_CELL_SIZE) {
+            // A mureta vai de -3 a 3 em x: para chegar ao outro lado, o agente precisa passar pela ponta dela
+            bool detoured = widest > 3.0f;
+            printf("Contorno da mureta: %s (alvo alcancado em %.2f s, maior |x| = %.2f)\n", detoured ? "OK" : "FALHOU",
+                   (double) tick * BENCH_DELTA_T, widest);
+            return detoured;
+        }
+    }
+    printf("Contorno da mureta: FALHOU (alvo nao alcancado, agente em (%.2f, %.2f))\n", position.x, position.z);
+    return false;
+}
+
+// Separação ingênua: todos os pares
+static uint64_t NaiveSeparation(const std::vector<glm::vec3> &positions, std::vector<glm::vec3> &pushes) {
+    uint64_t tests = 0;
+    float radius = CROWD_SEPARATION_RADIUS;
+    for (size_t i = 0; i < positions.size(); i++) {
+        glm::vec3 push = glm::vec3(0.0f, 0.0f, 0.0f);
+        for (size_t j = 0; j < positions.size(); j++) {
+            if (i == j) {
+                continue;
+            }
+            tests++;
+            float dx = positions[i].x - positions[j].x;
+            float dz = positions[i].z - positions[j].z;
+            float distance = std::sqrt(dx * dx + dz * dz);
+            if (distance < radius && distance > 1e-5f) {
+                float weight = 1.0f - distance / radius;
+                push.x += weight * dx / distance;
+                push.z += weight * dz / distance;
+            }
+        }
+        pushes[i] = push;
+    }
+    return tests;
+}
+
+// Cria a arena e os agentes, e mede "ticks" passos
+static BenchResult RunGrid(int agents, int ticks) {
+    float side = std::sqrt((float) agents / BENCH_DENSITY);
+    glm::vec3 boundsMin = glm::vec3(-0.5f * side, 0.0f, -0.5f * side);
+    glm::vec3 boundsMax = glm::vec3(0.5f * side, 0.0f, 0.5f * side);
+    glm::vec3 target = glm::vec3(0.0f, 0.0f, 0.0f);
+
+    // Muretas alternadas entre horizontais e verticais, fora da vizinhança do alvo
+    FlowField flowField;
+    flowField.initialize(boundsMin, boundsMax, FLOW_FIELD_CELL_SIZE);
+    int obstacles = 0;
+    int walls = (int) (side / BENCH_WALL_SPACING);
+    for (int row = 0; row < walls; row++) {
+        for (int column = 0; column < walls; column++) {
+            glm::vec3 center = boundsMin + glm::vec3(((float) column + 0.5f) * BENCH_WALL_SPACING, 0.0f, ((float) row + 0.5f) * BENCH_WALL_SPACING);
+            if (std::fabs(center.x) < BENCH_WALL_SPACING * 0.5f && std::fabs(center.z) < BENCH_WALL_SPACING * 0.5f) {
+                continue;
+            }
+            glm::vec3 halfSize = (row + column) % 2 == 0 ? glm::vec3(0.5f * BENCH_WALL_LENGTH, 0.5f, 0.5f * BENCH_WALL_THICKNESS)
+                                                        : glm::vec3(0.5f * BENCH_WALL_THICKNESS, 0.5f, 0.5f * BENCH_WALL_LENGTH);
+            AddObstacle(flowField, center - halfSize, center + halfSize);
+            obstacles++;
+        }
+    }
+    flowField.update(target);
+
+    CrowdGrid crowd;
+    crowd.initialize(boundsMin, boundsMax, CROWD_SEPARATION_RADIUS, agents);
+
+    // Agentes fora das muretas
+    unsigned int seed = 12345u;
+    std::vector<glm::vec3> positions(agents);
+    for (glm::vec3 &position : positions) {
+        do {
+            position = glm::vec3(boundsMin.x + side * NextRandom(seed), 0.0f, boundsMin.z + side * NextRandom(seed));
+        } while (flowField.isBlocked(position));
+        crowd.insert(position);
+    }
+
+    uint64_t warmupTests = 0;
+    for (int tick = 0; tick < BENCH_WARMUP_TICKS; tick++) {
+        Tick(positions, flowField, crowd, target, 1.0f, warmupTests);
+    }
+
+    BenchResult result = {0.0, 1e30, 0.0, 0.0, obstacles};
+    uint64_t pairTests = 0;
+    for (int tick = 0; tick < ticks; tick++) {
+        auto start = std::chrono::steady_clock::now();
+        Tick(positions, flowField, crowd, target, 1.0f, pairTests);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        result.averageMs += ms;
+        result.minMs = std::min(result.minMs, ms);
+    }
+    result.averageMs /= ticks;
+    result.testsPerAgent = (double) pairTests / ((double) ticks * agents);
+
+    // Recálculo do campo com o alvo andando uma célula por vez
+    auto fieldStart = std::chrono::steady_clock::now();
+    for (int update = 1; update <= BENCH_FIELD_UPDATES; update++) {
+        flowField.update(target + glm::vec3((float) update * FLOW_FIELD_CELL_SIZE, 0.0f, 0.0f));
+    }
+    result.fieldMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - fieldStart).count() / BENCH_FIELD_UPDATES;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::max(1, atoi(argv[1])) : 120;
+    const int counts[] = {1000, 10000, 50000};
+
+    bool detoured = CheckDetour();
+
+    printf("Passo da horda na CPU (campo de direcoes + separacao), %d passos por medicao\n", ticks);
+    printf("%10s %10s %14s %14s %14s %16s %14s\n", "agentes", "muretas", "media (ms)", "minimo (ms)", "ns/agente", "testes/agente", "campo (ms)");
+    for (int agents : counts) {
+        BenchResult result = RunGrid(agents, ticks);
+        printf("%10d %10d %14.3f %14.3f %14.1f %16.1f %14.3f\n", agents, result.obstacles, result.averageMs, result.minMs,
+               1e6 * result.averageMs / agents, result.testsPerAgent, result.fieldMs);
+    }
+
+    // Referência: separação com todos os pares
+    int naiveAgents = 1000;
+    float side = std::sqrt((float) naiveAgents / BENCH_DENSITY);
+    unsigned int seed = 12345u;
+    std::vector<glm::vec3> positions(naiveAgents);
+    std::vector<glm::vec3> pushes(naiveAgents);
+    for (glm::vec3 &position : positions) {
+        position = glm::vec3(side * (NextRandom(seed) - 0.5f), 0.0f, side * (NextRandom(seed) - 0.5f));
+    }
+    auto start = std::chrono::steady_clock::now();
+    uint64_t tests = NaiveSeparation(positions, pushes);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("Separacao ingenua O(n^2), %d agentes: %.3f ms (%llu testes)\n", naiveAgents, ms, (unsigned long long) tests);
+
+    return detoured ? 0 : 1;
+}
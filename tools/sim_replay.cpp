@@ -0,0 +1,71 @@
+// Reprodução de uma gravação de entrada sem janela, para medir regressões de desempenho da simulação.
+//
+// Uso: sim_replay <gravacao.rec> [threads] [repeticoes]
+//
+// A gravação (feita pelo jogo com --record ou por sim_soak) é reproduzida com a mesma configuração e semente,
+// passo a passo, comparando o hash do estado com o gravado. Como a entrada é sempre a mesma, o tempo por passo
+// pode ser comparado entre versões. A cada morte do robô a partida recomeça, como em sim_soak. Retorna 1 se a
+// simulação divergir da gravação.
+
+// Headers de C++
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Simulation.h"
+#include "InputRecording.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Uso: sim_replay <gravacao.rec> [threads] [repeticoes]\n");
+        return 1;
+    }
+    int threads = argc > 2 ? std::max(1, atoi(argv[2])) : 1;
+    int repetitions = argc > 3 ? std::max(1, atoi(argv[3])) : 1;
+
+    InputReplay replay;
+    if (!replay.open(argv[1])) {
+        return 1;
+    }
+
+    JobSystem jobs;
+    if (threads > 1) {
+        jobs.initialize(threads);
+    }
+
+    Simulation simulation;
+    simulation.initialize(replay.getConfig(), threads > 1 ? &jobs : nullptr);
+
+    // Melhor tempo entre as repetições, menos sensível a interferências da máquina
+    double bestSeconds = 1e30;
+    uint64_t divergences = 0;
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        replay.rewind();
+        simulation.reset();
+
+        SimulationInput input;
+        auto start = std::chrono::steady_clock::now();
+        while (replay.next(input)) {
+            auto tickStart = std::chrono::steady_clock::now();
+            bool robotAlive = simulation.step(input);
+            // Cada passo conta como um quadro na utilização das threads
+            jobs.endFrame(std::chrono::duration<double>(std::chrono::steady_clock::now() - tickStart).count());
+            replay.verify(simulation);
+            if (!robotAlive) {
+                simulation.reset();
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bestSeconds = std::min(bestSeconds, seconds);
+        divergences += replay.getDivergences();
+    }
+
+    replay.printSummary();
+    double ticks = (double) replay.getTickCount();
+    printf("Reproducao sem janela: %.0f passos em %.3f s (%.0f passos/s, %.1f us/passo), %d thread(s), melhor de %d\n",
+           ticks, bestSeconds, ticks / bestSeconds, 1e6 * bestSeconds / std::max(ticks, 1.0), threads, repetitions);
+
+    jobs.shutdown();
+    return divergences == 0 ? 0 : 1;
+}
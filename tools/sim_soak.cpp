@@ -0,0 +1,156 @@
+// Teste de resistência da simulação do jogo, sem janela nem contexto de OpenGL.
+//
+// Uso: sim_soak [passos] [threads] [gravacao.rec]
+//
+// Um jogador automático mira no zumbi mais próximo, arremessa o bumerange quando ele está ao alcance e
+// se afasta quando a horda se aproxima. Os passos têm duração fixa de 1/60 s; a cada morte do robô a
+// partida recomeça. Ao final, imprime os passos por segundo, as mortes, a maior fase, a maior horda e os
+// recálculos do campo de direções. A arena tem os obstáculos da configuração padrão: se o robô ou algum
+// zumbi entrar em um deles, o teste falha (retorna 1).
+// Com threads > 1, a horda é dividida pelo sistema de tarefas, como no jogo. Com um arquivo de gravação,
+// a entrada do jogador automático é gravada para ser reproduzida por sim_replay.
+
+// Headers de C++
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Simulation.h"
+#include "InputRecording.h"
+
+// Duração de cada passo (60 Hz)
+#define SOAK_DELTA_T (1.0f / 60.0f)
+
+// Distância abaixo da qual o jogador automático arremessa o bumerange
+#define SOAK_ATTACK_RANGE 4.5f
+
+// Distância abaixo da qual o jogador automático recua
+#define SOAK_RETREAT_RANGE 2.0f
+
+// Entrada do jogador automático: mira no zumbi mais próximo, ataca ao alcance e contorna a arena
+static SimulationInput Play(const Simulation &simulation, uint64_t tick) {
+    SimulationInput input;
+    input.deltaTime = SOAK_DELTA_T;
+
+    glm::vec3 robot = simulation.getRobot().position;
+    float nearestDistance = 1e30f;
+    glm::vec3 nearest = robot;
+    for (const enemyData &enemy : simulation.getEnemies()) {
+        float dx = enemy.position.x - robot.x;
+        float dz = enemy.position.z - robot.z;
+        float distance = std::sqrt(dx * dx + dz * dz);
+        if (distance < nearestDistance) {
+            nearestDistance = distance;
+            nearest = enemy.position;
+        }
+    }
+
+    if (nearestDistance < 1e30f && nearestDistance > 1e-4f) {
+        input.viewDirection = glm::vec3(nearest.x - robot.x, 0.0f, nearest.z - robot.z) / nearestDistance;
+    }
+    else {
+        // Sem zumbis, gira lentamente
+        float angle = 0.01f * (float) tick;
+        input.viewDirection = glm::vec3(std::cos(angle), 0.0f, std::sin(angle));
+    }
+
+    // Ataque primário ao alcance, alternando com o secundário a cada dois segundos
+    if (!simulation.isBoomerangActive() && nearestDistance < SOAK_ATTACK_RANGE) {
+        if ((tick / 120) % 2 == 0) {
+            input.attackPrimary = true;
+        }
+        else {
+            input.attackSecondary = true;
+        }
+    }
+
+    // Pistola enquanto o bumerangue está em voo
+    if (simulation.isBoomerangActive() && nearestDistance < PISTOL_RANGE) {
+        input.attackPistol = true;
+    }
+
+    // Recua quando a horda se aproxima; caso contrário, contorna o zumbi mais próximo
+    if (nearestDistance < SOAK_RETREAT_RANGE) {
+        input.heldS = SOAK_DELTA_T;
+    }
+    input.heldD = SOAK_DELTA_T * 0.5f;
+    return input;
+}
+
+int main(int argc, char* argv[]) {
+    long long ticks = argc > 1 ? std::max(1LL, atoll(argv[1])) : 100000;
+    int threads = argc > 2 ? std::max(1, atoi(argv[2])) : 1;
+
+    JobSystem jobs;
+    if (threads > 1) {
+        jobs.initialize(threads);
+    }
+
+    Simulation simulation;
+    simulation.initialize(SimulationConfig(), threads > 1 ? &jobs : nullptr);
+
+    InputRecorder recorder;
+    if (argc > 3 && !recorder.open(argv[3], simulation.getConfig())) {
+        return 1;
+    }
+
+    const SimulationConfig &config = simulation.getConfig();
+    const FlowField &flowField = simulation.getFlowField();
+    uint64_t flowFieldUpdates = 0;
+    uint64_t zombiesInside = 0;
+    uint64_t robotInside = 0;
+
+    int deaths = 0;
+    int maxPhase = 0;
+    size_t maxEnemies = 0;
+    uint64_t matchTicks = 0;
+    uint64_t longestMatch = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long tick = 0; tick < ticks; tick++) {
+        auto tickStart = std::chrono::steady_clock::now();
+        SimulationInput input = Play(simulation, simulation.getTick());
+        recorder.record(input);
+        matchTicks++;
+        bool robotAlive = simulation.step(input);
+        recorder.recordState(simulation);
+        // Cada passo conta como um quadro na utilização das threads
+        jobs.endFrame(std::chrono::duration<double>(std::chrono::steady_clock::now() - tickStart).count());
+        // Nenhum corpo entra nos obstáculos (os zumbis, pelas células bloqueadas do campo de direções)
+        for (const enemyData &enemy : simulation.getEnemies()) {
+            zombiesInside += flowField.isBlocked(enemy.position) ? 1 : 0;
+        }
+        const SimulationBody &robot = simulation.getRobot();
+        for (int i = 0; i < config.obstacleCount; i++) {
+            robotInside += (robot.bbox_min.x < config.obstacleMax[i].x && robot.bbox_max.x > config.obstacleMin[i].x &&
+                            robot.bbox_min.z < config.obstacleMax[i].z && robot.bbox_max.z > config.obstacleMin[i].z) ? 1 : 0;
+        }
+
+        if (!robotAlive) {
+            deaths++;
+            flowFieldUpdates += simulation.getFlowFieldUpdates();
+            longestMatch = std::max(longestMatch, matchTicks);
+            matchTicks = 0;
+            simulation.reset();
+            continue;
+        }
+        maxPhase = std::max(maxPhase, simulation.getPhase());
+        maxEnemies = std::max(maxEnemies, simulation.getEnemies().size());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    longestMatch = std::max(longestMatch, matchTicks);
+    flowFieldUpdates += simulation.getFlowFieldUpdates();
+
+    printf("Simulacao sem janela: %lld passos em %.3f s (%.0f passos/s, %.1f us/passo), %d thread(s)\n",
+           ticks, seconds, (double) ticks / seconds, 1e6 * seconds / (double) ticks, threads);
+    printf("Mortes do robo: %d  Maior partida: %.1f s de jogo  Maior fase: %d  Maior horda: %zu\n",
+           deaths, (double) longestMatch * SOAK_DELTA_T, maxPhase + 1, maxEnemies);
+    printf("Obstaculos: %d  Recalculos do campo de direcoes: %llu  Passos com o robo ou zumbis dentro de obstaculos: %llu robo, %llu zumbis\n",
+           config.obstacleCount, (unsigned long long) flowFieldUpdates, (unsigned long long) robotInside, (unsigned long long) zombiesInside);
+
+    recorder.close();
+    jobs.shutdown();
+    return (robotInside == 0 && zombiesInside == 0) ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+// Ferramenta que gera uma animação por textura de vértices (.vat) a partir de um OBJ e de uma animação com quadros-chave.
+//
+// Uso: vat_bake <modelo.obj> <animacao.anim> <saida.vat>
+//
+// A animação descreve ossos rígidos: cada osso seleciona as posições do OBJ dentro de uma caixa (com uma faixa
+// de transição por eixo) e gira em torno de um pivô, com ângulos definidos em quadros-chave ao longo do ciclo.
+// O ciclo é amostrado em "frames" quadros; o deslocamento de cada posição é gravado em half float.
+
+// Headers de C++
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Headers de matemática
+#include <glm/vec3.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include "LoadedObj.h"
+#include "VertexAnimation.h"
+
+// Quadro-chave: instante no ciclo [0, 1) e ângulo em graus
+struct Keyframe {
+    float time;
+    float degrees;
+};
+
+// Osso rígido, sem hierarquia: os deslocamentos dos ossos que afetam uma posição são somados
+struct Bone {
+    std::string name;
+    glm::vec3 regionMin;
+    glm::vec3 regionMax;
+    glm::vec3 blend;  // Largura da transição dentro da caixa em cada eixo (0 = corte seco)
+    glm::vec3 pivot;
+    glm::vec3 axis;
+    std::vector<Keyframe> keys;
+};
+
+struct Animation {
+    int frames = 16;
+    float rate = 1.0f;
+    std::vector<Bone> bones;
+};
+
+// Lê a descrição textual da animação
+static bool ReadAnimation(const char* filename, Animation &animation) {
+    std::ifstream file(filename);
+    if (!file) {
+        fprintf(stderr, "ERROR: Cannot open file \"%s\".\n", filename);
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.resize(comment);
+        }
+
+        std::istringstream input(line);
+        std::string command;
+        if (!(input >> command)) {
+            continue;
+        }
+
+        bool ok = true;
+        if (command == "frames") {
+            ok = static_cast<bool>(input >> animation.frames) && animation.frames > 0;
+        }
+        else if (command == "rate") {
+            ok = static_cast<bool>(input >> animation.rate);
+        }
+        else if (command == "bone") {
+            Bone bone;
+            ok = static_cast<bool>(input >> bone.name
+                                         >> bone.regionMin.x >> bone.regionMin.y >> bone.regionMin.z
+                                         >> bone.regionMax.x >> bone.regionMax.y >> bone.regionMax.z
+                                         >> bone.blend.x >> bone.blend.y >> bone.blend.z
+                                         >> bone.pivot.x >> bone.pivot.y >> bone.pivot.z
+                                         >> bone.axis.x >> bone.axis.y >> bone.axis.z);
+            bone.axis = glm::normalize(bone.axis);
+            animation.bones.push_back(bone);
+        }
+        else if (command == "key") {
+            std::string name;
+            Keyframe key;
+            ok = static_cast<bool>(input >> name >> key.time >> key.degrees);
+
+            Bone* target = nullptr;
+            for (Bone &bone : animation.bones) {
+                if (bone.name == name) {
+                    target = &bone;
+                }
+            }
+            if (ok && target == nullptr) {
+                fprintf(stderr, "ERROR: \"%s\":%d: osso \"%s\" nao declarado.\n", filename, lineNumber, name.c_str());
+                return false;
+            }
+            if (ok) {
+                target->keys.push_back(key);
+            }
+        }
+        else {
+            ok = false;
+        }
+
+        if (!ok) {
+            fprintf(stderr, "ERROR: \"%s\":%d: linha invalida.\n", filename, lineNumber);
+            return false;
+        }
+    }
+
+    // Quadros-chave em ordem de tempo, como esperado por SampleAngle()
+    for (Bone &bone : animation.bones) {
+        std::sort(bone.keys.begin(), bone.keys.end(), [](const Keyframe &a, const Keyframe &b) { return a.time < b.time; });
+    }
+    return true;
+}
+
+// Ângulo (em radianos) do osso no instante "time" do ciclo, com transição suave entre quadros-chave
+static float SampleAngle(const Bone &bone, float time) {
+    if (bone.keys.empty()) {
+        return 0.0f;
+    }
+
+    // Quadro-chave anterior e seguinte, considerando o ciclo fechado
+    size_t count = bone.keys.size();
+    size_t next = 0;
+    while (next < count && bone.keys[next].time <= time) {
+        next++;
+    }
+    const Keyframe &a = bone.keys[(next + count - 1) % count];
+    const Keyframe &b = bone.keys[next % count];
+
+    float span = b.time - a.time;
+    float elapsed = time - a.time;
+    if (span <= 0.0f) {
+        span += 1.0f;
+    }
+    if (elapsed < 0.0f) {
+        elapsed += 1.0f;
+    }
+
+    float s = span > 0.0f ? elapsed / span : 0.0f;
+    s = s * s * (3.0f - 2.0f * s);
+    float degrees = a.degrees + (b.degrees - a.degrees) * s;
+    return degrees * 3.14159265f / 180.0f;
+}
+
+// Peso do osso em uma posição: 1 no interior da caixa, decaindo até 0 nas faixas de transição
+static float BoneWeight(const Bone &bone, glm::vec3 p) {
+    float weight = 1.0f;
+    for (int i = 0; i < 3; i++) {
+        float inside = std::min(p[i] - bone.regionMin[i], bone.regionMax[i] - p[i]);
+        if (inside < 0.0f) {
+            return 0.0f;
+        }
+        if (bone.blend[i] > 0.0f) {
+            weight *= std::min(inside / bone.blend[i], 1.0f);
+        }
+    }
+    return weight;
+}
+
+// Rotação de Rodrigues em torno de um eixo unitário
+static glm::vec3 Rotate(glm::vec3 v, glm::vec3 axis, float angle) {
+    float c = cosf(angle);
+    float s = sinf(angle);
+    return v * c + glm::cross(axis, v) * s + axis * glm::dot(axis, v) * (1.0f - c);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        fprintf(stderr, "Uso: %s <modelo.obj> <animacao.anim> <saida.vat>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Animation animation;
+    if (!ReadAnimation(argv[2], animation)) {
+        return EXIT_FAILURE;
+    }
+
+    LoadedObj obj(argv[1]);
+
+    // Mapeamento na mesma ordem de Mesh::BuildTrianglesAndAddToVirtualScene: formas, triângulos e cantos
+    std::vector<uint32_t> remap;
+    for (const tinyobj::shape_t &shape : obj.shapes) {
+        for (const tinyobj::index_t &index : shape.mesh.indices) {
+            remap.push_back((uint32_t) index.vertex_index);
+        }
+    }
+
+    size_t positionCount = obj.attrib.vertices.size() / 3;
+    std::vector<uint16_t> offsets;
+    offsets.reserve((size_t) animation.frames * positionCount * 4);
+
+    float maxOffset = 0.0f;
+    for (int frame = 0; frame < animation.frames; frame++) {
+        float time = (float) frame / (float) animation.frames;
+
+        float angles[64];
+        size_t boneCount = std::min(animation.bones.size(), (size_t) 64);
+        for (size_t bone = 0; bone < boneCount; bone++) {
+            angles[bone] = SampleAngle(animation.bones[bone], time);
+        }
+
+        for (size_t i = 0; i < positionCount; i++) {
+            glm::vec3 p = glm::vec3(obj.attrib.vertices[3*i + 0], obj.attrib.vertices[3*i + 1], obj.attrib.vertices[3*i + 2]);
+            glm::vec3 offset = glm::vec3(0.0f);
+
+            for (size_t bone = 0; bone < boneCount; bone++) {
+                const Bone &b = animation.bones[bone];
+                float weight = BoneWeight(b, p);
+                if (weight > 0.0f) {
+                    glm::vec3 rotated = b.pivot + Rotate(p - b.pivot, b.axis, angles[bone]);
+                    offset += (rotated - p) * weight;
+                }
+            }
+
+            maxOffset = std::max(maxOffset, std::max(std::fabs(offset.x), std::max(std::fabs(offset.y), std::fabs(offset.z))));
+            offsets.push_back(glm::packHalf1x16(offset.x));
+            offsets.push_back(glm::packHalf1x16(offset.y));
+            offsets.push_back(glm::packHalf1x16(offset.z));
+            offsets.push_back(glm::packHalf1x16(0.0f));
+        }
+    }
+
+    VatHeader header;
+    header.magic = VAT_MAGIC;
+    header.vertexCount = (uint32_t) remap.size();
+    header.positionCount = (uint32_t) positionCount;
+    header.frameCount = (uint32_t) animation.frames;
+    header.width = VAT_TEXTURE_WIDTH;
+    header.cycleRate = animation.rate;
+
+    FILE* file = fopen(argv[3], "wb");
+    if (file == nullptr) {
+        fprintf(stderr, "ERROR: Cannot open file \"%s\".\n", argv[3]);
+        return EXIT_FAILURE;
+    }
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(remap.data(), sizeof(uint32_t), remap.size(), file);
+    fwrite(offsets.data(), sizeof(uint16_t), offsets.size(), file);
+    fclose(file);
+
+    printf("\"%s\": %u vertices, %u posicoes, %u quadros, deslocamento maximo %.3f\n",
+           argv[3], header.vertexCount, header.positionCount, header.frameCount, maxOffset);
+    return EXIT_SUCCESS;
+}